@@ -116,6 +116,7 @@ macro(simpact_setup)
 		${PROJECT_SOURCE_DIR}/src/lib/util/discretedistribution.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/discretedistributionfast.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/discretedistribution2d.cpp
+		${PROJECT_SOURCE_DIR}/src/lib/util/discretedistribution2dcompact.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/populationdistributioncsv.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/populationdistribution.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/configreader.cpp
@@ -126,6 +127,7 @@ macro(simpact_setup)
 		#${PROJECT_SOURCE_DIR}/src/lib/util/experimental/inverseerfi.cpp
 		#${PROJECT_SOURCE_DIR}/src/lib/util/experimental/exponentialfunction.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/hazardfunction.cpp
+		${PROJECT_SOURCE_DIR}/src/lib/util/hazardfunctionexpbatch.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/logfile.cpp 
 		${PROJECT_SOURCE_DIR}/src/lib/util/tiffdensityfile.cpp 
 		${PROJECT_SOURCE_DIR}/src/lib/util/configwriter.cpp 
@@ -137,6 +139,7 @@ macro(simpact_setup)
 		${PROJECT_SOURCE_DIR}/src/lib/util/discretedistributionwrapper.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/gridvaluescsv.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/util/discretedistributionwrapper2d.cpp
+		${PROJECT_SOURCE_DIR}/src/lib/util/memorymappedfile.cpp
 		)
 	set(SOURCES_MRNM
 		${PROJECT_SOURCE_DIR}/src/lib/mnrm/gslrandomnumbergenerator.cpp
@@ -144,6 +147,7 @@ macro(simpact_setup)
 		${PROJECT_SOURCE_DIR}/src/lib/mnrm/simplealgorithm.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/mnrm/booltype.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/mnrm/eventbase.cpp
+		${PROJECT_SOURCE_DIR}/src/lib/mnrm/eventbatchsolver.cpp
 		${PROJECT_SOURCE_DIR}/src/lib/mnrm/debugtimer.cpp
 		)
 	set(SOURCES_CORE
@@ -161,6 +165,12 @@ macro(simpact_setup)
 		${PROJECT_SOURCE_DIR}/src/lib/core/populationutil.cpp
 		)
 
+	# The batched hazard calculations only contain selects, but without this flag
+	# GCC considers them as control flow and won't vectorize the loops
+	if (CMAKE_COMPILER_IS_GNUCXX OR CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+		set_source_files_properties(${PROJECT_SOURCE_DIR}/src/lib/util/hazardfunctionexpbatch.cpp PROPERTIES COMPILE_FLAGS "-fno-trapping-math")
+	endif()
+
 	source_group(util FILES ${SOURCES_UTIL})
 	source_group(mnrm FILES ${SOURCES_MRNM})
 	source_group(core FILES ${SOURCES_CORE})
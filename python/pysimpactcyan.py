@@ -458,25 +458,31 @@ class PySimpactCyan(object):
             fullPath = os.path.join(self._execDir, fullPath)
         return fullPath
 
+    def _getAlgorithmString(self, opt):
+        if type(opt) == bool:
+            return "opt" if opt else "simple"
+        return str(opt)
+
     def runDirect(self, configFile, parallel = False, opt = True, release = True, outputFile = None, seed = -1, destDir = None, quiet = False):
 
         fullPath = self._getExecPath(opt, release)
         parallelStr = "1" if parallel else "0"
-
-        if type(opt) == bool:
-            algoStr = "opt" if opt else "simple"
-        else:
-            algoStr = str(opt)
+        algoStr = self._getAlgorithmString(opt)
 
         if destDir is None:
             destDir = os.path.abspath(os.path.dirname(configFile))
-    
+
+        self._runProcess([fullPath, configFile, parallelStr, algoStr], outputFile, seed, destDir, quiet)
+
+    # Note that we don't change the current directory, but start the process
+    # in the destination directory instead
+    def _runProcess(self, arguments, outputFile, seed, destDir, quiet):
+
+        destDir = os.path.abspath(destDir)
         closeOutput = False
-        origDir = os.getcwd()
         try:
-            os.chdir(destDir)
-
             if outputFile is not None:
+                outputFile = os.path.join(destDir, outputFile)
                 if os.path.exists(outputFile):
                     raise Exception("Want to write to output file '%s', but this already exists" % outputFile)
 
@@ -493,10 +499,10 @@ class PySimpactCyan(object):
                 newEnv["SIMPACT_DATA_DIR"] = str(self._dataDirectory)
             
             if not quiet:
-                print("Results will be stored in directory '%s'" % os.getcwd())
-                print("Running simpact executable '{}' ...".format(fullPath))
+                print("Results will be stored in directory '%s'" % destDir)
+                print("Running simpact executable '{}' ...".format(arguments[0]))
 
-            proc = subprocess.Popen([fullPath, configFile, parallelStr, algoStr], stdout=f, stderr=f, cwd=os.getcwd(), env=newEnv)
+            proc = subprocess.Popen(arguments, stdout=f, stderr=f, cwd=destDir, env=newEnv)
             try:
                 proc.wait() # Wait for the process to finish
             except:
@@ -524,7 +530,8 @@ class PySimpactCyan(object):
                 raise Exception(self._getProgramExitError(lines, proc.returncode))
 
         finally:
-            os.chdir(origDir)
+            if closeOutput:
+                f.close()
 
     def _getProgramExitError(self, lines, code):
         lines = [ l.strip() for l in lines if l.strip() ]
@@ -710,6 +717,21 @@ class PySimpactCyan(object):
             interventionConfig = None, dryRun = False, identifierFormat = "%T-%y-%m-%d-%H-%M-%S_%p_%r%r%r%r%r%r%r%r-",
             dataFiles = { }, quiet = False):
 
+        runInfo = self._prepareRun(config, destDir, agedist, interventionConfig, identifierFormat, dataFiles, quiet)
+
+        # Set environment variables (if necessary) and start executable
+
+        if not dryRun:
+            if not quiet:
+                print("Using identifier '%s'" % runInfo["id"])
+            self.runDirect(runInfo["configfile"], parallel, opt, release, runInfo["outputfile"], seed, destDir, quiet)
+
+        return self._getRunResults(runInfo)
+
+    # Writes the config file and the other input files for a simulation, and returns
+    # the information that _getRunResults needs
+    def _prepareRun(self, config, destDir, agedist, interventionConfig, identifierFormat, dataFiles, quiet):
+
         if not destDir:
             raise Exception("A destination directory must be specified")
 
@@ -887,12 +909,19 @@ class PySimpactCyan(object):
             for d in dataFiles:
                 self._writeDataFile(destDir, idStr + "data-" + self._toFileName(d) + ".csv", d, dataFiles[d])
 
-        # Set environment variables (if necessary) and start executable
+        return { "id": idStr, "destdir": destDir, "configfile": configFile, "outputfile": outputFile, "agedistfile": distFile,
+                 "config": originalConfig, "finalconfig": finalConfig }
 
-        if not dryRun:
-            if not quiet:
-                print("Using identifier '%s'" % idStr)
-            self.runDirect(configFile, parallel, opt, release, outputFile, seed, destDir, quiet)
+    def _getRunResults(self, runInfo):
+
+        idStr = runInfo["id"]
+        destDir = runInfo["destdir"]
+        configFile = runInfo["configfile"]
+        outputFile = runInfo["outputfile"]
+        distFile = runInfo["agedistfile"]
+        originalConfig = runInfo["config"]
+        finalConfig = runInfo["finalconfig"]
+        dataPrefix = "data:"
 
         # Create the return structure
         results = { }
@@ -951,6 +980,53 @@ class PySimpactCyan(object):
 
         return results
 
+    def runEnsemble(self, configs, destDir, seeds = None, numThreads = None, agedist = None, opt = True, release = True,
+                    interventionConfig = None, identifierFormat = "%T-%y-%m-%d-%H-%M-%S_%p_%r%r%r%r%r%r%r%r-",
+                    dataFiles = { }, quiet = False):
+
+        # A single configuration can be combined with a list of seeds
+        if isinstance(configs, dict) or configs is None:
+            if seeds is None:
+                raise Exception("If only one configuration is specified, a list of seeds is needed")
+            configs = [ configs for s in seeds ]
+        elif seeds is not None and len(seeds) != len(configs):
+            raise Exception("The number of seeds (%d) differs from the number of configurations (%d)" % (len(seeds), len(configs)))
+
+        if seeds is None:
+            seeds = [ -1 for c in configs ]
+
+        numRuns = len(configs)
+        if numRuns == 0:
+            raise Exception("No simulations were specified")
+
+        # The files for the simulations are written one after the other, only the first
+        # one creates the destination directory if necessary. Since _prepareRun modifies
+        # the dictionaries it receives, copies are used.
+        runInfos = [ ]
+        for idx in range(numRuns):
+            runInfos.append(self._prepareRun(copy.deepcopy(configs[idx]), destDir, copy.deepcopy(agedist), copy.deepcopy(interventionConfig),
+                                             identifierFormat, dataFiles, quiet))
+
+        runsFile = os.path.abspath(os.path.join(destDir, "%sensemble.csv" % runInfos[0]["id"]))
+        if os.path.exists(runsFile):
+            raise Exception("Want to write to ensemble file '%s', but this already exists" % runsFile)
+
+        with open(runsFile, "wt") as f:
+            for idx in range(numRuns):
+                f.write('%d,"%s","%s"\n' % (int(seeds[idx]), runInfos[idx]["configfile"], runInfos[idx]["outputfile"]))
+
+        # All simulations are run by a single simpact-cyan process
+        fullPath = self._getExecPath(opt, release)
+        threadsStr = str(int(numThreads)) if numThreads else "0"
+        outputFile = "%sensembleoutput.txt" % runInfos[0]["id"]
+
+        if not quiet:
+            print("Running %d simulations in one process" % numRuns)
+
+        self._runProcess([fullPath, "--ensemble", runsFile, threadsStr, self._getAlgorithmString(opt)], outputFile, -1, destDir, quiet)
+
+        return [ self._getRunResults(info) for info in runInfos ]
+
 def main():
 
     try:
@@ -41,7 +41,7 @@ void PersonalEventList::registerPersonalEvent(PopulationEvent *pEvt)
 	assert(!pEvt->isDeleted());
 	assert(pEvt->needsEventTimeCalculation());
 
-	m_untimedEvents.push_back(pEvt);
+	addUntimedEvent(pEvt);
 }
 
 void PersonalEventList::processUnsortedEvents(PopulationAlgorithmAdvanced &alg, PopulationStateAdvanced &pop, double t0)
@@ -170,7 +170,8 @@ void PersonalEventList::processUnsortedEvents(PopulationAlgorithmAdvanced &alg,
 	checkEvents();
 }
 
-void PersonalEventList::advanceEventTimes(PopulationAlgorithmAdvanced &alg, const PopulationStateAdvanced &pop, double t1)
+void PersonalEventList::advanceEventTimes(PopulationAlgorithmAdvanced &alg, const PopulationStateAdvanced &pop, double t1,
+		                                  const PopulationEvent *pFilterEvent)
 {
 	checkEarliestEvent();
 	checkEvents();
@@ -186,6 +187,7 @@ void PersonalEventList::advanceEventTimes(PopulationAlgorithmAdvanced &alg, cons
 
 	// append all events from the sorted list to the unsorted one
 	pop.lockPerson(m_pPerson); // going to change the lists
+	if (!pFilterEvent)
 	{
 		// New version with swap and memcpy seems to be slightly (2%) faster, but contains a BUG!
 		// So now we're using the older but safer version
@@ -196,13 +198,42 @@ void PersonalEventList::advanceEventTimes(PopulationAlgorithmAdvanced &alg, cons
 			PopulationEvent *pEvt = m_timedEvents[i];
 			assert(!pEvt->isDeleted());
 
-			m_untimedEvents.push_back(pEvt);
+			addUntimedEvent(pEvt);
 		}
 	
 		m_timedEvents.resize(0);
 		m_pEarliestEvent = 0;
 		//std::cout << "advanceEventTimes: Person " << (void *)m_pPerson << ": timed events cleared, m_untimedEvents " << m_untimedEvents.size() << std::endl;
 	}
+	else
+	{
+		// Only the events that are affected according to the filter event are moved,
+		// the others stay in the sorted list
+		int num = m_timedEvents.size();
+		int numKept = 0;
+
+		for (int i = 0 ; i < num ; i++)
+		{
+			PopulationEvent *pEvt = m_timedEvents[i];
+			assert(!pEvt->isDeleted());
+
+			if (pFilterEvent->isEventAffected(pEvt))
+			{
+				if (pEvt == m_pEarliestEvent)
+					m_pEarliestEvent = 0;
+
+				addUntimedEvent(pEvt);
+			}
+			else
+			{
+				m_timedEvents[numKept] = pEvt;
+				pEvt->setEventIndex(m_pPerson, numKept);
+				numKept++;
+			}
+		}
+
+		m_timedEvents.resize(numKept);
+	}
 	pop.unlockPerson(m_pPerson);
 
 	checkEvents();
@@ -340,7 +371,7 @@ void PersonalEventList::adjustingEvent(PopulationEvent *pEvt) // this should mov
 
 	//std::cout << "adjustingEvent: Person " << (void *)m_pPerson << ": moved last event " << (void *)m_timedEvents[idx] << " to idx " << idx << std::endl;
 
-	m_untimedEvents.push_back(pEvt);
+	addUntimedEvent(pEvt);
 
 	//std::cout << "adjustingEvent: Person " << (void *)m_pPerson << ": added " << (void *)pEvt << " to m_untimedEvents" << std::endl;
 
@@ -419,6 +450,79 @@ void PersonalEventList::removeTimedEvent(PopulationEvent *pEvt)
 	checkEvents();
 }
 
+// Removes the event from whichever list of this person it's in, using the stored event index
+void PersonalEventList::removeEvent(PopulationEvent *pEvt)
+{
+	assert(pEvt != 0);
+	assert(!pEvt->isDeleted());
+
+	int idx = pEvt->getEventIndex(m_pPerson);
+	std::vector<PopulationEvent *> *pList = &m_untimedEvents;
+
+	if (idx < (int)m_timedEvents.size() && m_timedEvents[idx] == pEvt)
+	{
+		pList = &m_timedEvents;
+		if (pEvt == m_pEarliestEvent)
+			m_pEarliestEvent = 0;
+	}
+
+	std::vector<PopulationEvent *> &list = *pList;
+	int lastIdx = list.size()-1;
+
+	assert(idx >= 0 && idx <= lastIdx);
+	assert(list[idx] == pEvt);
+
+	if (idx != lastIdx)
+	{
+		list[idx] = list[lastIdx];
+		list[idx]->setEventIndex(m_pPerson, idx);
+	}
+	list.resize(lastIdx);
+}
+
+// Something changed for this person (e.g. death, relocation, dissolution of a
+// relationship) that may have made some of the events in the lists useless. Instead
+// of waiting until processUnsortedEvents encounters them, we remove them right away
+// from the lists of all persons involved. This is not called from a parallel section.
+void PersonalEventList::removeUselessEvents(PopulationAlgorithmAdvanced &alg, const PopulationStateAdvanced &pop)
+{
+	checkEarliestEvent();
+	checkEvents();
+
+	std::vector<PopulationEvent *> uselessEvents;
+	const std::vector<PopulationEvent *> *lists[2] = { &m_timedEvents, &m_untimedEvents };
+
+	for (int l = 0 ; l < 2 ; l++)
+	{
+		const std::vector<PopulationEvent *> &list = *(lists[l]);
+
+		for (size_t i = 0 ; i < list.size() ; i++)
+		{
+			PopulationEvent *pEvt = list[i];
+
+			assert(pEvt != 0);
+			assert(!pEvt->isDeleted());
+
+			if (!pEvt->isScheduledForRemoval() && pEvt->isNoLongerUseful(pop))
+				uselessEvents.push_back(pEvt);
+		}
+	}
+
+	for (size_t i = 0 ; i < uselessEvents.size() ; i++)
+	{
+		PopulationEvent *pEvt = uselessEvents[i];
+		int numPersons = pEvt->getNumberOfPersons();
+
+		for (int k = 0 ; k < numPersons ; k++)
+			personalEventList(pEvt->getPersonWithoutChecking(k))->removeEvent(pEvt);
+
+		alg.scheduleForRemoval(pEvt);
+	}
+
+	checkEarliestEvent();
+	checkEvents();
+}
+
 #ifdef PERSONALEVENTLIST_EXTRA_DEBUGGING
 
 void PersonalEventList::checkEarliestEvent() // FOR DEBUGGING
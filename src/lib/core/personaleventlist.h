@@ -23,9 +23,11 @@ public:
 
 	void registerPersonalEvent(PopulationEvent *pEvt);
 	void processUnsortedEvents(PopulationAlgorithmAdvanced &alg, PopulationStateAdvanced &pop, double t0);
-	void advanceEventTimes(PopulationAlgorithmAdvanced &alg, const PopulationStateAdvanced &pop, double t1);
+	void advanceEventTimes(PopulationAlgorithmAdvanced &alg, const PopulationStateAdvanced &pop, double t1,
+	                       const PopulationEvent *pFilterEvent = 0);
 	void adjustingEvent(PopulationEvent *pEvt);
 	void removeTimedEvent(PopulationEvent *pEvt);
+	void removeUselessEvents(PopulationAlgorithmAdvanced &alg, const PopulationStateAdvanced &pop);
 
 	PopulationEvent *getEarliestEvent();
 	
@@ -33,6 +35,8 @@ public:
 	int getListIndex() const							{ return m_listIndex; }
 private:
 	static PersonalEventList *personalEventList(PersonBase *pPerson);
+	void removeEvent(PopulationEvent *pEvt);
+	void addUntimedEvent(PopulationEvent *pEvt)					{ pEvt->setEventIndex(m_pPerson, m_untimedEvents.size()); m_untimedEvents.push_back(pEvt); }
 #ifndef PERSONALEVENTLIST_EXTRA_DEBUGGING
 	void checkEarliestEvent() { }
 	void checkEvents() { }
@@ -41,6 +45,7 @@ private:
 	void checkEvents();
 #endif // PERSONALEVENTLIST_EXTRA_DEBUGGING
 
+	// The event index refers to the position in either the timed or the untimed list
 	std::vector<PopulationEvent *> m_timedEvents;
 	std::vector<PopulationEvent *> m_untimedEvents;
 	
@@ -49,9 +54,7 @@ private:
 
 	int m_listIndex;
 
-#ifdef ALGORITHM_SHOW_EVENTS
 	friend class PopulationAlgorithmAdvanced;
-#endif // ALGORITHM_SHOW_EVENTS
 };
 
 #endif // PERSONALEVENTLIST_H
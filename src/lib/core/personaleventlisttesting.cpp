@@ -52,7 +52,7 @@ void PersonalEventListTesting::registerPersonalEvent(PopulationEvent *pEvt)
 	// TODO: do something more random here
 	int respIdx = getResponsiblePersonIndex(pEvt);
 	if (m_pPerson == pEvt->getPerson(respIdx))
-		m_untimedEventsPrimary.push_back(pEvt); // Will be calculated by this person
+		addUntimedEvent(pEvt); // Will be calculated by this person
 	else
 	{
 		m_secondaryEvents.push_back(pEvt); // These will get calculated by another person
@@ -70,8 +70,10 @@ void PersonalEventListTesting::processUnsortedEvents(PopulationAlgorithmTesting
 
 	int num = m_untimedEventsPrimary.size();
 	const State *pState = &pop;
+	EventBatchList &batchList = alg.getEventBatchList();
 
-	// First calculate the times
+	// First calculate the times; events that have a batch solver are collected
+	// first and are calculated together afterwards
 
 	for (int i = 0 ; i < num ; i++)
 	{
@@ -111,12 +113,15 @@ void PersonalEventListTesting::processUnsortedEvents(PopulationAlgorithmTesting
 				if (pEvt->needsEventTimeCalculation())
 				{
 					EventBase *pEvtBase = pEvt;
-					pEvtBase->solveForRealTimeInterval(pState, t0);
+					if (!batchList.addEvent(pEvtBase, pState))
+						pEvtBase->solveForRealTimeInterval(pState, t0);
 				}
 			}
 		}
 	}
 
+	batchList.solveForRealTimeIntervals(pState, t0);
+
 	checkEarliestEvent();
 	
 	// See if we need to check the events currently in m_timedEvents for the best time
@@ -196,7 +201,8 @@ void PersonalEventListTesting::processUnsortedEvents(PopulationAlgorithmTesting
 	checkEvents();
 }
 
-void PersonalEventListTesting::advanceEventTimes(PopulationAlgorithmTesting &alg, const PopulationStateTesting &pop, double t1)
+void PersonalEventListTesting::advanceEventTimes(PopulationAlgorithmTesting &alg, const PopulationStateTesting &pop, double t1,
+		                                         const PopulationEvent *pFilterEvent)
 {
 	checkEarliestEvent();
 	checkEvents();
@@ -211,6 +217,7 @@ void PersonalEventListTesting::advanceEventTimes(PopulationAlgorithmTesting &alg
 	// and the first call may already have moved something 
 
 	// append all events from the sorted list to the unsorted one
+	if (!pFilterEvent)
 	{
 		// New version with swap and memcpy seems to be slightly (2%) faster, but contains a BUG!
 		// So now we're using the older but safer version
@@ -221,18 +228,48 @@ void PersonalEventListTesting::advanceEventTimes(PopulationAlgorithmTesting &alg
 			PopulationEvent *pEvt = m_timedEventsPrimary[i];
 			assert(!pEvt->isDeleted());
 
-			m_untimedEventsPrimary.push_back(pEvt);
+			addUntimedEvent(pEvt);
 		}
 	
 		m_timedEventsPrimary.resize(0);
 		m_pEarliestEvent = 0;
 		//std::cout << "advanceEventTimes: Person " << (void *)m_pPerson << ": timed events cleared, m_untimedEvents " << m_untimedEvents.size() << std::endl;
 	}
+	else
+	{
+		// Only the events that are affected according to the filter event are moved,
+		// the others stay in the sorted list
+		int num = m_timedEventsPrimary.size();
+		int numKept = 0;
+
+		for (int i = 0 ; i < num ; i++)
+		{
+			PopulationEvent *pEvt = m_timedEventsPrimary[i];
+			assert(!pEvt->isDeleted());
+
+			if (pFilterEvent->isEventAffected(pEvt))
+			{
+				if (pEvt == m_pEarliestEvent)
+					m_pEarliestEvent = 0;
+
+				addUntimedEvent(pEvt);
+			}
+			else
+			{
+				m_timedEventsPrimary[numKept] = pEvt;
+				pEvt->setEventIndex(m_pPerson, numKept);
+				numKept++;
+			}
+		}
+
+		m_timedEventsPrimary.resize(numKept);
+	}
 
 	checkEvents();
 
 	// calculate the times in the untimed event list
 	int num = m_untimedEventsPrimary.size();
+	EventBatchList &batchList = alg.getEventBatchList();
 
 	assert(!alg.isParallel());
 	for (int i = 0 ; i < num ; i++)
@@ -253,7 +290,8 @@ void PersonalEventListTesting::advanceEventTimes(PopulationAlgorithmTesting &alg
 			assert(pEvt->getPerson(selfIdx) == m_pPerson);
 #endif // NDEBUG
 
-			pEvt->subtractInternalTimeInterval(&pop, t1);
+			if (!batchList.addEvent(pEvt, &pop))
+				pEvt->subtractInternalTimeInterval(&pop, t1);
 		}
 	}
 
@@ -270,15 +308,23 @@ void PersonalEventListTesting::advanceEventTimes(PopulationAlgorithmTesting &alg
 		if (pEvt->needsEventTimeCalculation()) // we've already processed this event
 			continue;
 
+		if (pFilterEvent && !pFilterEvent->isEventAffected(pEvt))
+			continue;
+
 		// Check that we are not the one responsible
 		int resposibleIdx = getResponsiblePersonIndex(pEvt);
 		PersonBase *pOtherPerson = pEvt->getPerson(resposibleIdx);
 		assert(pOtherPerson != m_pPerson);
 
 		personalEventList(pOtherPerson)->adjustingEvent(pEvt);
-		pEvt->subtractInternalTimeInterval(&pop, t1);
+		if (!batchList.addEvent(pEvt, &pop))
+			pEvt->subtractInternalTimeInterval(&pop, t1);
 	}
 
+	// The batched events must be processed before returning, since a next call for
+	// another person uses needsEventTimeCalculation to see which events are done
+	batchList.subtractInternalTimeIntervals(&pop, t1);
+
 	checkEarliestEvent();
 	checkEvents();
 }
@@ -310,7 +356,7 @@ void PersonalEventListTesting::adjustingEvent(PopulationEvent *pEvt) // this sho
 
 	//std::cout << "adjustingEvent: Person " << (void *)m_pPerson << ": moved last event " << (void *)m_timedEvents[idx] << " to idx " << idx << std::endl;
 
-	m_untimedEventsPrimary.push_back(pEvt);
+	addUntimedEvent(pEvt);
 
 	//std::cout << "adjustingEvent: Person " << (void *)m_pPerson << ": added " << (void *)pEvt << " to m_untimedEvents" << std::endl;
 
@@ -445,6 +491,83 @@ void PersonalEventListTesting::removeSecondaryEvent(PopulationEvent *pEvt)
 	checkEvents();
 }
 
+// Removes the event from whichever list of this person it's in, using the stored event index
+void PersonalEventListTesting::removeEvent(PopulationEvent *pEvt)
+{
+	assert(pEvt != 0);
+	assert(!pEvt->isDeleted());
+
+	int idx = pEvt->getEventIndex(m_pPerson);
+	std::vector<PopulationEvent *> *pList = &m_secondaryEvents;
+
+	if (pEvt->getPersonWithoutChecking(getResponsiblePersonIndex(pEvt)) == m_pPerson)
+	{
+		if (idx < (int)m_timedEventsPrimary.size() && m_timedEventsPrimary[idx] == pEvt)
+		{
+			pList = &m_timedEventsPrimary;
+			if (pEvt == m_pEarliestEvent)
+				m_pEarliestEvent = 0;
+		}
+		else
+			pList = &m_untimedEventsPrimary;
+	}
+
+	std::vector<PopulationEvent *> &list = *pList;
+	int lastIdx = list.size()-1;
+
+	assert(idx >= 0 && idx <= lastIdx);
+	assert(list[idx] == pEvt);
+
+	if (idx != lastIdx)
+	{
+		list[idx] = list[lastIdx];
+		list[idx]->setEventIndex(m_pPerson, idx);
+	}
+	list.resize(lastIdx);
+}
+
+// Something changed for this person (e.g. death, relocation, dissolution of a
+// relationship) that may have made some of the events in the lists useless. Instead
+// of waiting until processUnsortedEvents encounters them, we remove them right away
+// from the lists of all persons involved.
+void PersonalEventListTesting::removeUselessEvents(PopulationAlgorithmTesting &alg, const PopulationStateTesting &pop)
+{
+	checkEarliestEvent();
+	checkEvents();
+
+	std::vector<PopulationEvent *> uselessEvents;
+	const std::vector<PopulationEvent *> *lists[3] = { &m_timedEventsPrimary, &m_untimedEventsPrimary, &m_secondaryEvents };
+
+	for (int l = 0 ; l < 3 ; l++)
+	{
+		const std::vector<PopulationEvent *> &list = *(lists[l]);
+
+		for (size_t i = 0 ; i < list.size() ; i++)
+		{
+			PopulationEvent *pEvt = list[i];
+
+			assert(pEvt != 0);
+			assert(!pEvt->isDeleted());
+
+			if (!pEvt->isScheduledForRemoval() && pEvt->isNoLongerUseful(pop))
+				uselessEvents.push_back(pEvt);
+		}
+	}
+
+	for (size_t i = 0 ; i < uselessEvents.size() ; i++)
+	{
+		PopulationEvent *pEvt = uselessEvents[i];
+		int numPersons = pEvt->getNumberOfPersons();
+
+		for (int k = 0 ; k < numPersons ; k++)
+			personalEventList(pEvt->getPersonWithoutChecking(k))->removeEvent(pEvt);
+
+		alg.scheduleForRemoval(pEvt);
+	}
+
+	checkEarliestEvent();
+	checkEvents();
+}
 
 #ifdef PERSONALEVENTLIST_EXTRA_DEBUGGING
 
@@ -23,9 +23,11 @@ public:
 
 	void registerPersonalEvent(PopulationEvent *pEvt);
 	void processUnsortedEvents(PopulationAlgorithmTesting &alg, PopulationStateTesting &pop, double t0);
-	void advanceEventTimes(PopulationAlgorithmTesting &alg, const PopulationStateTesting &pop, double t1);
+	void advanceEventTimes(PopulationAlgorithmTesting &alg, const PopulationStateTesting &pop, double t1,
+	                       const PopulationEvent *pFilterEvent = 0);
 	void adjustingEvent(PopulationEvent *pEvt);
 	void removeTimedEvent(PopulationEvent *pEvt);
+	void removeUselessEvents(PopulationAlgorithmTesting &alg, const PopulationStateTesting &pop);
 
 	PopulationEvent *getEarliestEvent();
 	
@@ -34,6 +36,8 @@ public:
 private:
 	static PersonalEventListTesting *personalEventList(PersonBase *pPerson);
 	void removeSecondaryEvent(PopulationEvent *pEvt);
+	void removeEvent(PopulationEvent *pEvt);
+	void addUntimedEvent(PopulationEvent *pEvt)					{ pEvt->setEventIndex(m_pPerson, m_untimedEventsPrimary.size()); m_untimedEventsPrimary.push_back(pEvt); }
 #ifndef PERSONALEVENTLIST_EXTRA_DEBUGGING
 	void checkEarliestEvent() { }
 	void checkEvents() { }
@@ -42,6 +46,9 @@ private:
 	void checkEvents();
 #endif // PERSONALEVENTLIST_EXTRA_DEBUGGING
 
+	// For events in the primary lists, the event index refers to the position in
+	// either the timed or the untimed list, for the other events to the position
+	// in the secondary list
 	std::vector<PopulationEvent *> m_timedEventsPrimary;
 	std::vector<PopulationEvent *> m_untimedEventsPrimary;
 
@@ -52,9 +59,7 @@ private:
 
 	int m_listIndex;
 
-#ifdef ALGORITHM_SHOW_EVENTS
 	friend class PopulationAlgorithmTesting;
-#endif // ALGORITHM_SHOW_EVENTS
 };
 
 #endif // PERSONALEVENTLISTTESTING_H
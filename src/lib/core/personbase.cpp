@@ -7,6 +7,7 @@ PersonBase::PersonBase(Gender g, double dateOfBirth)
 { 
 	m_pAlgInfo = 0;
 	m_personID = -1; // uninitialized
+	m_referenceCount = 0;
 
 	if (g == Male)
 		m_name = strprintf("man_%d", (int)m_personID);
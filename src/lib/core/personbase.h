@@ -75,6 +75,13 @@ public:
 
 	/** Returns what was stored using PersonBase::PersonAlgorithmInfo. */
 	PersonAlgorithmInfo *getAlgorithmInfo() const					{ return m_pAlgInfo; }
+
+	// These are for internal use: each PopulationEvent that refers to this person
+	// holds a reference, so that it's known when a deceased person can no longer
+	// be accessed by an event (see PopulationStateInterface::setReleaseDeceasedPeople)
+	void addReference()								{ m_referenceCount++; }
+	void removeReference()								{ assert(m_referenceCount > 0); m_referenceCount--; }
+	int getReferenceCount() const							{ return m_referenceCount; }
 private:
 	Gender m_gender;
 	std::string m_name;
@@ -82,6 +89,7 @@ private:
 
 	int64_t m_personID;
 	PersonAlgorithmInfo *m_pAlgInfo;
+	int m_referenceCount;
 };
 
 class GlobalEventDummyPerson : public PersonBase
@@ -103,6 +103,8 @@ void PopulationAlgorithmAdvanced::onAlgorithmLoop(bool finished)
 #endif // POPULATIONEVENT_FAKEDELETE
 	}
 	m_eventsToRemove.resize(0);
+
+	m_popState.releaseUnreferencedDeceasedPeople();
 }
 
 bool_t PopulationAlgorithmAdvanced::initEventTimes() const
@@ -243,6 +245,9 @@ void PopulationAlgorithmAdvanced::advanceEventTimes(EventBase *pScheduledEvent,
 	m_otherAffectedPeople.clear();
 	if (POPULATION_ALWAYS_RECALCULATE_FLAG || pEvt->isEveryoneAffected())
 	{
+		// The event itself can restrict the recalculation to certain events
+		const PopulationEvent *pFilterEvent = (POPULATION_ALWAYS_RECALCULATE_FLAG)?0:pEvt;
+
 		int num = m_people.size();
 		for (int i = m_numGlobalDummies ; i < num ; i++)
 		{
@@ -251,7 +256,7 @@ void PopulationAlgorithmAdvanced::advanceEventTimes(EventBase *pScheduledEvent,
 			assert(pPerson != 0);
 			assert(pPerson->getGender() == PersonBase::Male || pPerson->getGender() == PersonBase::Female);
 
-			personalEventList(pPerson)->advanceEventTimes(*this, m_popState, newRefTime);
+			personalEventList(pPerson)->advanceEventTimes(*this, m_popState, newRefTime, pFilterEvent);
 		}
 	}
 	else
@@ -286,6 +291,27 @@ void PopulationAlgorithmAdvanced::advanceEventTimes(EventBase *pScheduledEvent,
 	}
 }
 
+// The candidate time of an event that uses thinning was rejected: it was already
+// removed from the lists in getNextScheduledEvent, so we just need to add it again
+// to the lists of the persons involved (nothing changed for their other events)
+void PopulationAlgorithmAdvanced::onRejectedEvent(EventBase *pScheduledEvent)
+{
+	PopulationEvent *pEvt = static_cast<PopulationEvent *>(pScheduledEvent);
+
+	assert(!pEvt->isDeleted());
+	assert(pEvt->needsEventTimeCalculation());
+
+	int numPersons = pEvt->getNumberOfPersons();
+	for (int i = 0 ; i < numPersons ; i++)
+	{
+		PersonBase *pPerson = pEvt->getPerson(i);
+
+		assert(pPerson != 0);
+
+		personalEventList(pPerson)->registerPersonalEvent(pEvt);
+	}
+}
+
 PopulationEvent *PopulationAlgorithmAdvanced::getEarliestEvent(const std::vector<PersonBase *> &people)
 {
 	if (!m_init)
@@ -412,6 +438,44 @@ void PopulationAlgorithmAdvanced::unlockEvent(PopulationEvent *pEvt) const
 #endif // !DISABLEOPENMP
 }
 
+void PopulationAlgorithmAdvanced::removeUselessEvents(PersonBase *pPerson)
+{
+	assert(m_init);
+	assert(pPerson != 0);
+
+	personalEventList(pPerson)->removeUselessEvents(*this, m_popState);
+}
+
+void PopulationAlgorithmAdvanced::getPendingEvents(std::vector<PopulationEvent *> &events)
+{
+	assert(m_init);
+	events.clear();
+
+	// An event is present in the lists of all persons involved, we'll only
+	// take it into account for the first one
+	for (int k = 0 ; k < 2 ; k++)
+	{
+		const std::vector<PersonBase *> &people = (k == 0)?m_popState.m_people:m_popState.m_deceasedPersons;
+
+		for (size_t i = 0 ; i < people.size() ; i++)
+		{
+			PersonBase *pPerson = people[i];
+			PersonalEventList *pList = personalEventList(pPerson);
+
+			for (int j = 0 ; j < 2 ; j++)
+			{
+				const std::vector<PopulationEvent *> &list = (j == 0)?pList->m_timedEvents:pList->m_untimedEvents;
+
+				for (size_t l = 0 ; l < list.size() ; l++)
+				{
+					if (list[l]->getPersonWithoutChecking(0) == pPerson)
+						events.push_back(list[l]);
+				}
+			}
+		}
+	}
+}
+
 void PopulationAlgorithmAdvanced::onNewEvent(PopulationEvent *pEvt)
 {
 	assert(pEvt != 0);
@@ -445,6 +509,8 @@ void PopulationAlgorithmAdvanced::onNewEvent(PopulationEvent *pEvt)
 			personalEventList(pPerson)->registerPersonalEvent(pEvt);
 		}
 	}
+
+	pEvt->addPersonReferences();
 }
 
 #ifdef ALGORITHM_SHOW_EVENTS
@@ -97,6 +97,8 @@ public:
 	bool isParallel() const							{ return m_parallel; }
 	bool_t run(double &tMax, int64_t &maxEvents, double startTime = 0);
 	void onNewEvent(PopulationEvent *pEvt);
+	void removeUselessEvents(PersonBase *pPerson);
+	void getPendingEvents(std::vector<PopulationEvent *> &events);
 
 	// TODO: shield these from the user somehow? These functions should not be used
 	//       directly by the user, they are used internally by the algorithm
@@ -112,6 +114,7 @@ private:
 	bool_t initEventTimes() const;
 	bool_t getNextScheduledEvent(double &dt, EventBase **ppEvt);
 	void advanceEventTimes(EventBase *pScheduledEvent, double dt);
+	void onRejectedEvent(EventBase *pEvt);
 	void onAboutToFire(EventBase *pEvt);
 	PopulationEvent *getEarliestEvent(const std::vector<PersonBase *> &people);
 	PersonalEventList *personalEventList(PersonBase *pPerson);
@@ -71,6 +71,8 @@ void PopulationAlgorithmSimple::onAlgorithmLoop(bool finished)
 	for (size_t i = 0 ; i < m_eventsToRemove.size() ; i++)
 		delete m_eventsToRemove[i];
 	m_eventsToRemove.resize(0);
+
+	m_popState.releaseUnreferencedDeceasedPeople();
 }
 
 bool_t PopulationAlgorithmSimple::initEventTimes() const
@@ -86,6 +88,20 @@ void PopulationAlgorithmSimple::scheduleForRemoval(PopulationEvent *pEvt)
 	m_eventsToRemove.push_back(pEvt);
 }
 
+void PopulationAlgorithmSimple::getPendingEvents(std::vector<PopulationEvent *> &events)
+{
+	assert(m_init);
+	events.clear();
+
+	for (size_t i = 0 ; i < m_allEvents.size() ; i++)
+	{
+		PopulationEvent *pEvt = static_cast<PopulationEvent *>(m_allEvents[i]);
+
+		if (!pEvt->isScheduledForRemoval())
+			events.push_back(pEvt);
+	}
+}
+
 void PopulationAlgorithmSimple::onNewEvent(PopulationEvent *pEvt)
 {
 	assert(pEvt != 0);
@@ -98,6 +114,7 @@ void PopulationAlgorithmSimple::onNewEvent(PopulationEvent *pEvt)
 	pEvt->generateNewInternalTimeDifference(getRandomNumberGenerator(), &m_popState);
 
 	m_allEvents.push_back(pEvt);
+	pEvt->addPersonReferences();
 }
 
 void PopulationAlgorithmSimple::onFiredEvent(EventBase *pEvt, int position)
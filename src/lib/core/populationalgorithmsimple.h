@@ -50,8 +50,12 @@ public:
 	~PopulationAlgorithmSimple();
 
 	bool_t init();
+
+	bool isParallel() const							{ return m_parallelRequested; }
 	bool_t run(double &tMax, int64_t &maxEvents, double startTime = 0);
 	void onNewEvent(PopulationEvent *pEvt);
+	void removeUselessEvents(PersonBase *pPerson)									{ } // all events are already checked after an event fired
+	void getPendingEvents(std::vector<PopulationEvent *> &events);
 
 	// TODO: shield these from the user somehow? These functions should not be used
 	//       directly by the user, they are used internally by the algorithm
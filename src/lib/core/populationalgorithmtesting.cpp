@@ -83,6 +83,8 @@ void PopulationAlgorithmTesting::onAlgorithmLoop(bool finished)
 #endif // POPULATIONEVENT_FAKEDELETE
 	}
 	m_eventsToRemove.resize(0);
+
+	m_popState.releaseUnreferencedDeceasedPeople();
 }
 
 bool_t PopulationAlgorithmTesting::initEventTimes() const
@@ -208,6 +210,9 @@ void PopulationAlgorithmTesting::advanceEventTimes(EventBase *pScheduledEvent, d
 	m_otherAffectedPeople.clear();
 	if (POPULATION_ALWAYS_RECALCULATE_FLAG || pEvt->isEveryoneAffected())
 	{
+		// The event itself can restrict the recalculation to certain events
+		const PopulationEvent *pFilterEvent = (POPULATION_ALWAYS_RECALCULATE_FLAG)?0:pEvt;
+
 		int num = m_people.size();
 		for (int i = m_numGlobalDummies ; i < num ; i++)
 		{
@@ -216,7 +221,7 @@ void PopulationAlgorithmTesting::advanceEventTimes(EventBase *pScheduledEvent, d
 			assert(pPerson != 0);
 			assert(pPerson->getGender() == PersonBase::Male || pPerson->getGender() == PersonBase::Female);
 
-			personalEventList(pPerson)->advanceEventTimes(*this, m_popState, newRefTime);
+			personalEventList(pPerson)->advanceEventTimes(*this, m_popState, newRefTime, pFilterEvent);
 		}
 	}
 	else
@@ -251,6 +256,27 @@ void PopulationAlgorithmTesting::advanceEventTimes(EventBase *pScheduledEvent, d
 	}
 }
 
+// The candidate time of an event that uses thinning was rejected: it was already
+// removed from the lists in getNextScheduledEvent, so we just need to add it again
+// to the lists of the persons involved (nothing changed for their other events)
+void PopulationAlgorithmTesting::onRejectedEvent(EventBase *pScheduledEvent)
+{
+	PopulationEvent *pEvt = static_cast<PopulationEvent *>(pScheduledEvent);
+
+	assert(!pEvt->isDeleted());
+	assert(pEvt->needsEventTimeCalculation());
+
+	int numPersons = pEvt->getNumberOfPersons();
+	for (int i = 0 ; i < numPersons ; i++)
+	{
+		PersonBase *pPerson = pEvt->getPerson(i);
+
+		assert(pPerson != 0);
+
+		personalEventList(pPerson)->registerPersonalEvent(pEvt);
+	}
+}
+
 PopulationEvent *PopulationAlgorithmTesting::getEarliestEvent(const std::vector<PersonBase *> &people)
 {
 	if (!m_init)
@@ -285,6 +311,35 @@ void PopulationAlgorithmTesting::scheduleForRemoval(PopulationEvent *pEvt)
 	m_eventsToRemove.push_back(pEvt);
 }
 
+void PopulationAlgorithmTesting::removeUselessEvents(PersonBase *pPerson)
+{
+	assert(m_init);
+	assert(pPerson != 0);
+
+	personalEventList(pPerson)->removeUselessEvents(*this, m_popState);
+}
+
+void PopulationAlgorithmTesting::getPendingEvents(std::vector<PopulationEvent *> &events)
+{
+	assert(m_init);
+	events.clear();
+
+	// Each event is present in the primary list of exactly one person, the
+	// secondary lists only refer to these same events
+	for (int k = 0 ; k < 2 ; k++)
+	{
+		const std::vector<PersonBase *> &people = (k == 0)?m_popState.m_people:m_popState.m_deceasedPersons;
+
+		for (size_t i = 0 ; i < people.size() ; i++)
+		{
+			PersonalEventListTesting *pList = personalEventList(people[i]);
+
+			events.insert(events.end(), pList->m_timedEventsPrimary.begin(), pList->m_timedEventsPrimary.end());
+			events.insert(events.end(), pList->m_untimedEventsPrimary.begin(), pList->m_untimedEventsPrimary.end());
+		}
+	}
+}
+
 void PopulationAlgorithmTesting::onNewEvent(PopulationEvent *pEvt)
 {
 	assert(pEvt != 0);
@@ -318,6 +373,8 @@ void PopulationAlgorithmTesting::onNewEvent(PopulationEvent *pEvt)
 			personalEventList(pPerson)->registerPersonalEvent(pEvt);
 		}
 	}
+
+	pEvt->addPersonReferences();
 }
 
 #ifdef ALGORITHM_SHOW_EVENTS
@@ -12,6 +12,7 @@
 #include "populationinterfaces.h"
 #include "populationevent.h"
 #include "personaleventlisttesting.h"
+#include "eventbatchsolver.h"
 #include <assert.h>
 
 class GslRandomNumberGenerator;
@@ -93,10 +94,13 @@ public:
 	bool isParallel() const							{ return m_parallel; }
 	bool_t run(double &tMax, int64_t &maxEvents, double startTime = 0);
 	void onNewEvent(PopulationEvent *pEvt);
+	void removeUselessEvents(PersonBase *pPerson);
+	void getPendingEvents(std::vector<PopulationEvent *> &events);
 
 	// TODO: shield these from the user somehow? These functions should not be used
 	//       directly by the user, they are used internally by the algorithm
 	void scheduleForRemoval(PopulationEvent *pEvt);
+	EventBatchList &getEventBatchList()												{ return m_batchList; }
 
 	double getTime() const															{ return Algorithm::getTime(); }
 	GslRandomNumberGenerator *getRandomNumberGenerator() const						{ return Algorithm::getRandomNumberGenerator(); }
@@ -106,6 +110,7 @@ private:
 	bool_t initEventTimes() const;
 	bool_t getNextScheduledEvent(double &dt, EventBase **ppEvt);
 	void advanceEventTimes(EventBase *pScheduledEvent, double dt);
+	void onRejectedEvent(EventBase *pEvt);
 	void onAboutToFire(EventBase *pEvt)												{ if (m_pOnAboutToFire) m_pOnAboutToFire->onAboutToFire(static_cast<PopulationEvent *>(pEvt)); }
 	PopulationEvent *getEarliestEvent(const std::vector<PersonBase *> &people);
 	PersonalEventListTesting *personalEventList(PersonBase *pPerson);
@@ -121,6 +126,7 @@ private:
 	int64_t getNextEventID();
 
 	std::vector<EventBase *> m_eventsToRemove;
+	EventBatchList m_batchList;
 
 	// For the parallel version
 	bool m_parallel;
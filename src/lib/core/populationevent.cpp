@@ -67,6 +67,27 @@ PopulationEvent::PopulationEvent(PersonBase *pPerson1, PersonBase *pPerson2)
 	
 PopulationEvent::~PopulationEvent()
 {
+	// Let the persons know that this event no longer refers to them, a
+	// deceased person can only be released when no event refers to him/her.
+	// Events are only deleted by the algorithm, so the references were taken
+	// in addPersonReferences
+	for (int i = 0 ; i < m_numPersons ; i++)
+	{
+		assert(m_pPersons[i] != 0);
+		m_pPersons[i]->removeReference();
+	}
+}
+
+// Called by the algorithm when the event is registered (after setGlobalEventPerson),
+// which is always done serially. Events may be constructed in parallel, so this is
+// not done in the constructor.
+void PopulationEvent::addPersonReferences()
+{
+	for (int i = 0 ; i < m_numPersons ; i++)
+	{
+		assert(m_pPersons[i] != 0);
+		m_pPersons[i]->addReference();
+	}
 }
 
 bool PopulationEvent::isNoLongerUseful(const PopulationStateInterface &population)
@@ -45,6 +45,9 @@ class PopulationStateInterface;
  *    if everyone in the population is affected by the event, you can override
  *    this and return true. Since this will cause all event fire times to be
  *    recalculated, it should be avoided. But it can be useful for testing purposes.
+ *  - PopulationEvent::isEventAffected: if everyone is affected, but only the
+ *    fire times of certain events really change, this function can be used
+ *    to limit the recalculation to those events.
  *  - PopulationEvent::markOtherAffectedPeople: if other people are affected,
  *    you should implement this function and mark which persons are affected
  *    by calling the Population::markAffectedPerson function.
@@ -80,6 +83,7 @@ public:
 
 	// These are for internal use
 	void setGlobalEventPerson(PersonBase *pDummyPerson);
+	void addPersonReferences();
 	void setEventID(int64_t id);
 	int64_t getEventID() const;
 
@@ -97,6 +101,12 @@ public:
 	 *  function can be overridden to indicate this. */
 	virtual bool isEveryoneAffected() const							{ return false; }
 
+	/** When PopulationEvent::isEveryoneAffected returns true, this function is called
+	 *  for the events in the lists of the other people, and only the fire times of the
+	 *  events for which true is returned will be recalculated. By default all events
+	 *  are affected. */
+	virtual bool isEventAffected(const PopulationEvent *pEvt) const				{ return true; }
+
 	/** If other people than the one(s) mentioned in the constructor are also affected
 	 *  by this event, it should be indicated in this function. */
 	virtual void markOtherAffectedPeople(const PopulationStateInterface &population)			{ }
@@ -139,16 +149,19 @@ protected:
 private:
 	void commonConstructor();
 
-	PersonBase *m_pPersons[POPULATIONEVENT_MAXPERSONS];
-	int m_eventIndex[POPULATIONEVENT_MAXPERSONS];
+	// The small members are placed first, so that the compiler can store them in the
+	// padding at the end of EventBase. Only the lower 31 bits of the event ID are kept,
+	// the ID is only used to tell events apart (e.g. to select a mutex), for which this
+	// suffices even when more events are created during a simulation.
 	int8_t m_numPersons; 
-
 	bool m_scheduledForRemoval;
-	int64_t m_eventID;
-
 #ifdef POPULATIONEVENT_FAKEDELETE
 	bool m_deleted;
 #endif // POPULATIONEVENT_FAKEDELETE
+	int32_t m_eventID;
+
+	PersonBase *m_pPersons[POPULATIONEVENT_MAXPERSONS];
+	int m_eventIndex[POPULATIONEVENT_MAXPERSONS];
 };
 
 inline void PopulationEvent::setEventIndex(PersonBase *pPerson, int idx)
@@ -207,7 +220,7 @@ inline void PopulationEvent::setEventID(int64_t id)
 #endif
 	assert(m_eventID < 0); 
 	assert(id >= 0); 
-	m_eventID = id; 
+	m_eventID = (int32_t)(id & 0x7fffffff); 
 }
 
 inline int64_t PopulationEvent::getEventID() const								
@@ -8,6 +8,7 @@
 
 #include "algorithm.h"
 #include "booltype.h"
+#include <vector>
 
 class PersonBase;
 class PopulationEvent;
@@ -19,6 +20,23 @@ class PopulationStateExtra
 public:
 	PopulationStateExtra()																{ }
 	virtual ~PopulationStateExtra()														{ }
+
+	/** Is called when a living person is stored at position \c idx in the array returned
+	 *  by PopulationStateInterface::getAllPeople, either because the person was just added
+	 *  or because the person was moved to fill the place of someone who died. When the person
+	 *  itself died, this is called with a negative index. Can be used to keep per-person
+	 *  information in arrays that have the same layout as the one with the persons. */
+	virtual void onPersonIndexChanged(PersonBase *pPerson, int idx)						{ }
+
+	/** Is called when the length of the array returned by PopulationStateInterface::getAllPeople
+	 *  changes. When a person is added, this is called before the new person is stored; when
+	 *  someone died, this is called after the other persons have been moved. */
+	virtual void onNumberOfPeopleChanged(int numPeople)									{ }
+
+	/** When PopulationStateInterface::setReleaseDeceasedPeople is enabled, this is called
+	 *  right before a deceased person is deleted, which happens once no event refers to
+	 *  the person anymore. Other references to this person must be removed here. */
+	virtual void onReleaseDeceasedPerson(PersonBase *pPerson)							{ }
 };
 
 /** Interface for a simulation state for the population-based algorithm, specifying
@@ -72,6 +90,13 @@ public:
 	 *  mentioned in the event constructor. */
 	virtual void markAffectedPerson(PersonBase *pPerson) const = 0;
 
+	/** By default, deceased persons are kept in the array returned by
+	 *  PopulationStateInterface::getDeceasedPeople until the end of the simulation.
+	 *  If this is enabled, a deceased person is deleted as soon as no event refers
+	 *  to him/her anymore, and PopulationStateExtra::onReleaseDeceasedPerson is called
+	 *  right before this happens. */
+	virtual void setReleaseDeceasedPeople(bool f) = 0;
+
 	/** This allows you to store additional information for a state that implements this
 	 *  PopulationStateInterface class, note that this is _not_ automatically deleted in
 	 *  the destructor. */
@@ -107,6 +132,10 @@ public:
 	/** Abstract function to initialize the implementation used. */
 	virtual bool_t init() = 0;
 
+	/** Returns true if a parallel version of the algorithm is being used, in which
+	 *  case the simulation itself may also perform some work in parallel. */
+	virtual bool isParallel() const = 0;
+
 	/** This should be called to actually start the simulation, do not call
 	 *  Algorithm::evolve for this.
 	 *  \param tMax Stop the simulation if the simulation time exceeds the specified time. Upon
@@ -132,6 +161,20 @@ public:
 	 *  this function. */
 	virtual void onNewEvent(PopulationEvent *pEvt) = 0;
 
+	/** When something changed for a person that can make some of the events that
+	 *  involve this person useless (e.g. death, relocation or the dissolution of
+	 *  a relationship), this can be called at the end of PopulationEvent::fire to
+	 *  remove those events right away. Otherwise they are only discarded when the
+	 *  algorithm encounters them, and until then they remain in the lists of the
+	 *  persons involved. */
+	virtual void removeUselessEvents(PersonBase *pPerson) = 0;
+
+	/** Stores the events that are currently present in the algorithm in \c events,
+	 *  each event only once. This is meant for reporting purposes (e.g. to see how
+	 *  much memory is used by the events of each type) and should not be called
+	 *  while the algorithm is executing an event. */
+	virtual void getPendingEvents(std::vector<PopulationEvent *> &events) = 0;
+
 	/** Must return the simulation tilme of the algorithm. */
 	virtual double getTime() const = 0;
 
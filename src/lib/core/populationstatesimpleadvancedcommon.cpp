@@ -4,6 +4,7 @@
 
 PopulationStateSimpleAdvancedCommon::PopulationStateSimpleAdvancedCommon() : m_numGlobalDummies(1)
 {
+	m_releaseDeceased = false;
 }
 
 PopulationStateSimpleAdvancedCommon::~PopulationStateSimpleAdvancedCommon()
@@ -43,15 +44,14 @@ void PopulationStateSimpleAdvancedCommon::setPersonDied(PersonBase *pPerson)
 		{
 			PersonBase *pWoman = m_people[lastFemaleIdx];
 
-			m_people[listIndex] = pWoman;
-			setListIndex(pWoman, listIndex);
+			storePerson(pWoman, listIndex);
 
 			assert(listIndex >= (m_numMen+m_numGlobalDummies)); // in m_people there are first a number of global event dummies, then men, then a number of women
 
 			// m_firstEventTracker.taint(listIndex);
 		}
 
-		m_people.resize(lastFemaleIdx);
+		resizePeople(lastFemaleIdx);
 		m_numWomen--;
 
 		// m_firstEventTracker.removedLast();
@@ -72,8 +72,7 @@ void PopulationStateSimpleAdvancedCommon::setPersonDied(PersonBase *pPerson)
 		{
 			PersonBase *pMan = m_people[lastMaleIdx];
 
-			m_people[listIndex] = pMan;
-			setListIndex(pMan, listIndex);
+			storePerson(pMan, listIndex);
 
 			// m_firstEventTracker.taint(listIndex);
 		}
@@ -87,21 +86,55 @@ void PopulationStateSimpleAdvancedCommon::setPersonDied(PersonBase *pPerson)
 
 			PersonBase *pWoman = m_people[lastFemaleIdx];
 
-			m_people[newIdx] = pWoman;
-			setListIndex(pWoman, newIdx);
+			storePerson(pWoman, newIdx);
 
 			// m_firstEventTracker.tain(m_numMen);
 		}
 
-		m_people.resize(m_numGlobalDummies+m_numMen+m_numWomen);
+		resizePeople(m_numGlobalDummies+m_numMen+m_numWomen);
 
 		// m_firstEventTracker.removedLast();
 	}
 
 	setListIndex(pPerson, -1); // not needed for the deceased list
+	PopulationStateExtra *pExtra = getExtraStateInfo();
+	if (pExtra)
+		pExtra->onPersonIndexChanged(pPerson, -1);
+
 	m_deceasedPersons.push_back(pPerson);
 }
 
+// When a deceased person may be released, he/she stays in the deceased list
+// until no event refers to him/her anymore. Events are only deleted in batches
+// by the algorithm, so this is checked after such a batch.
+void PopulationStateSimpleAdvancedCommon::releaseUnreferencedDeceasedPeople()
+{
+	if (!m_releaseDeceased)
+		return;
+
+	PopulationStateExtra *pExtra = getExtraStateInfo();
+	size_t numKept = 0;
+
+	for (size_t i = 0 ; i < m_deceasedPersons.size() ; i++)
+	{
+		PersonBase *pPerson = m_deceasedPersons[i];
+
+		assert(pPerson != 0);
+		assert(pPerson->hasDied());
+
+		if (pPerson->getReferenceCount() > 0)
+			m_deceasedPersons[numKept++] = pPerson;
+		else
+		{
+			if (pExtra)
+				pExtra->onReleaseDeceasedPerson(pPerson);
+			delete pPerson;
+		}
+	}
+
+	m_deceasedPersons.resize(numKept);
+}
+
 void PopulationStateSimpleAdvancedCommon::addNewPerson(PersonBase *pPerson)
 {
 	assert(pPerson != 0);
@@ -121,10 +154,9 @@ void PopulationStateSimpleAdvancedCommon::addNewPerson(PersonBase *pPerson)
 			assert((int)m_people.size() == m_numMen+m_numGlobalDummies);
 
 			int pos = m_people.size();
-			m_people.resize(pos+1);
+			resizePeople(pos+1);
 
-			m_people[pos] = pPerson;
-			setListIndex(pPerson, pos);
+			storePerson(pPerson, pos);
 
 			m_numMen++;
 		}
@@ -135,14 +167,12 @@ void PopulationStateSimpleAdvancedCommon::addNewPerson(PersonBase *pPerson)
 			assert(pFirstWoman->getGender() == PersonBase::Female);
 
 			int s = m_people.size();
-			m_people.resize(s+1);
+			resizePeople(s+1);
 
-			m_people[s] = pFirstWoman;
-			setListIndex(pFirstWoman, s);
+			storePerson(pFirstWoman, s);
 
 			int newIdx = m_numMen+m_numGlobalDummies;
-			m_people[newIdx] = pPerson;
-			setListIndex(pPerson, newIdx);
+			storePerson(pPerson, newIdx);
 
 			m_numMen++;
 		}
@@ -152,15 +182,33 @@ void PopulationStateSimpleAdvancedCommon::addNewPerson(PersonBase *pPerson)
 		int pos = m_numGlobalDummies + m_numMen + m_numWomen;
 
 		assert(pos == (int)m_people.size());
-		m_people.resize(pos+1);
+		resizePeople(pos+1);
 
-		m_people[pos] = pPerson;
-		setListIndex(pPerson, pos);
+		storePerson(pPerson, pos);
 
 		m_numWomen++;
 	}
 }
 
+void PopulationStateSimpleAdvancedCommon::storePerson(PersonBase *pPerson, int listIndex)
+{
+	m_people[listIndex] = pPerson;
+	setListIndex(pPerson, listIndex);
+
+	PopulationStateExtra *pExtra = getExtraStateInfo();
+	if (pExtra)
+		pExtra->onPersonIndexChanged(pPerson, listIndex - m_numGlobalDummies);
+}
+
+void PopulationStateSimpleAdvancedCommon::resizePeople(int listSize)
+{
+	m_people.resize(listSize);
+
+	PopulationStateExtra *pExtra = getExtraStateInfo();
+	if (pExtra)
+		pExtra->onNumberOfPeopleChanged(listSize - m_numGlobalDummies);
+}
+
 PersonBase **PopulationStateSimpleAdvancedCommon::getMen()
 {
 	assert(m_numMen >= 0);
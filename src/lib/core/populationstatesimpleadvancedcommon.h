@@ -27,11 +27,19 @@ public:
 	void addNewPerson(PersonBase *pPerson);
 	void setPersonDied(PersonBase *pPerson);
 	void markAffectedPerson(PersonBase *pPerson) const;
+	void setReleaseDeceasedPeople(bool f)							{ m_releaseDeceased = f; }
+
+	// Called by the algorithms after a batch of events has been deleted
+	void releaseUnreferencedDeceasedPeople();
 protected:
 	virtual int64_t getNextPersonID() = 0;
 	virtual void addAlgorithmInfo(PersonBase *pPerson) = 0;
 	virtual void setListIndex(PersonBase *pPerson, int idx) = 0;
 	virtual int getListIndex(PersonBase *pPerson) = 0;
+private:
+	void storePerson(PersonBase *pPerson, int listIndex);
+	void resizePeople(int listSize);
+protected:
 
 	// These are living persons, the first part men, the second are women
 	std::vector<PersonBase *> m_people;
@@ -40,6 +48,7 @@ protected:
 
 	// Deceased persons
 	std::vector<PersonBase *> m_deceasedPersons;
+	bool m_releaseDeceased;
 	mutable std::vector<PersonBase *> m_otherAffectedPeople;
 };
 
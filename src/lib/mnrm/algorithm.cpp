@@ -117,6 +117,28 @@ bool_t Algorithm::evolve(double &tMax, int64_t &maxEvents, double startTime, boo
 		//std::cerr << "dtMin = " << dtMin << std::endl;
 		assert(dtMin >= 0);
 
+		// If the event uses thinning, its time is only a candidate which may be rejected.
+		// In that case the event doesn't fire and nothing changes in the state, so the
+		// other event times remain valid; only this event needs to be rescheduled
+		if (dtMin == dtMin && !pNextScheduledEvent->acceptCandidateTime(m_pRndGen, m_pState, m_time + dtMin))
+		{
+			m_time += dtMin;
+			m_pState->setTime(m_time);
+
+			pNextScheduledEvent->generateNewInternalTimeDifference(m_pRndGen, m_pState);
+			onRejectedEvent(pNextScheduledEvent);
+
+			if (m_time > tMax)
+				done = true;
+
+			onAlgorithmLoop(done);
+
+#ifdef ALGORITHM_DEBUG_TIMER
+			pLoopTimer->stop();
+#endif // ALGORITHM_DEBUG_TIMER
+			continue;
+		}
+
 #ifdef ALGORITHM_DEBUG_TIMER
 		pAdvanceTimer->start();
 #endif // ALGORITHM_DEBUG_TIMER
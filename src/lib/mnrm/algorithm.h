@@ -116,6 +116,20 @@ public:
 	 *  	if (pNextScheduledEvent == 0)
 	 *  		return false;
 	 *  
+	 *  	// For an event that uses thinning, the time is only a candidate
+	 *  	if (!pNextScheduledEvent->acceptCandidateTime(m_pRndGen, m_pState, m_time + dtMin))
+	 *  	{
+	 *  		m_time += dtMin;
+	 *  		pNextScheduledEvent->generateNewInternalTimeDifference(m_pRndGen, m_pState);
+	 *  		onRejectedEvent(pNextScheduledEvent);
+	 *  
+	 *  		if (m_time > tMax)
+	 *  			done = true;
+	 *  
+	 *  		onAlgorithmLoop(done);
+	 *  		continue;
+	 *  	}
+	 *  
 	 *  	advanceEventTimes(pNextScheduledEvent, dtMin);
 	 *  
 	 *  	m_time += dtMin;
@@ -147,6 +161,7 @@ public:
 	 *
 	 *   - onAboutToFire: called right before an event will fire
 	 *   - onFiredEvent: called right after an event fired
+	 *   - onRejectedEvent: called when the candidate time of an event that uses thinning was rejected
 	 *   - onAboutToFire: called when the algoritm is going to loop
 	 */
 	bool_t evolve(double &tMax, int64_t &maxEvents, double startTime = 0, bool initEvents = true);
@@ -178,6 +193,12 @@ protected:
 	/** Called after pEvt is fired. */
 	virtual void onFiredEvent(EventBase *pEvt)							{ }
 
+	/** Called when the candidate fire time of \c pEvt, which uses thinning, was rejected. The
+	 *  event did not fire and already has a new internal time difference, the state did not
+	 *  change so only this event needs to be rescheduled. Since the event is still part of
+	 *  the event list of a simple algorithm, nothing needs to be done by default. */
+	virtual void onRejectedEvent(EventBase *pEvt)							{ }
+
 	/** Called at the end of each algorithm loop, with \c finished set to true if
 	 *  the loop will be exited. */
 	virtual void onAlgorithmLoop(bool finished)							{ }
@@ -13,6 +13,7 @@
 #include <cmath>
 
 class GslRandomNumberGenerator;
+class EventBatchSolver;
 
 // IMPORTANT: this is only meant for positive times! we use a negative
 // event time to indicate that a recalculation is necessary
@@ -51,6 +52,13 @@ class GslRandomNumberGenerator;
  *  fire time. Because the \c calculateInternalTimeInterval and \c solveForRealTimeInterval function by default
  *  use the trivial \f$ \Delta T = dt \f$ mapping onto real world times, you won't need to implement them to
  *  make the event fire at the correct time.
+ *
+ *  For hazards for which the mapping between internal and real world time is expensive
+ *  to calculate, an event can use thinning instead: it then maps the time intervals using
+ *  a constant upper bound for the hazard, which is trivial, and re-implements
+ *  EventBase::acceptCandidateTime to accept the candidate time with probability
+ *  \f$ h(t)/h_{max} \f$. If it is rejected, the event doesn't fire but simply gets a new
+ *  internal time difference.
  */
 class EventBase
 {
@@ -90,11 +98,34 @@ public:
 	// for that reason that we also store m_tLastCalc
 	void subtractInternalTimeInterval(const State *pState, double t1);
 
+	/** If the time calculations of this event can be done together with those of
+	 *  other events, this should return the EventBatchSolver to use. By default
+	 *  no such solver exists and null is returned. */
+	virtual EventBatchSolver *getBatchSolver(const State *pState)				{ return 0; }
+
+	/** Returns the time at which the event time was last calculated, which is the start of
+	 *  the interval for which EventBase::subtractInternalTimeInterval will be called. */
+	double getLastCalculationTime() const							{ return m_tLastCalc; }
+
+	/** To be used by an EventBatchSolver: stores the real world time interval \c dt that
+	 *  corresponds to the internal time left, calculated starting from \c t0. */
+	void setRealTimeInterval(const State *pState, double t0, double dt);
+
+	/** To be used by an EventBatchSolver: subtracts the internal time interval \c dT,
+	 *  which corresponds to the real world interval from EventBase::getLastCalculationTime
+	 *  until \c t1. */
+	void subtractInternalTimeInterval(const State *pState, double t1, double dT);
+
 	// May be useful to check for events that can only happen once
 	// (e.g. someone dying)
 	bool isInitialized() const								{ return !(m_Tdiff < 0); }
 
 	bool needsEventTimeCalculation() const							{ return (m_tEvent < 0); }
+
+	/** When the (candidate) event time is reached, the algorithm must call this function to
+	 *  check if the event should really fire. By default this simply returns true, an event
+	 *  that uses thinning should accept the time with probability \f$ h(t)/h_{max} \f$. */
+	virtual bool acceptCandidateTime(GslRandomNumberGenerator *pRndGen, const State *pState, double t)	{ return true; }
 	void setNeedEventTimeCalculation()							{ m_tEvent = -12345; }
 
 	/** Check if the event has been marked for deletion, can avoid a call to the random
@@ -166,6 +197,13 @@ inline double EventBase::solveForRealTimeInterval(const State *pState, double t0
 	}
 
 	double dt = solveForRealTimeInterval(pState, m_Tdiff, t0);
+	setRealTimeInterval(pState, t0, dt);
+
+	return dt;
+}
+
+inline void EventBase::setRealTimeInterval(const State *pState, double t0, double dt)
+{
 	assert(dt >= 0);
 
 #ifndef NDEBUG
@@ -190,8 +228,6 @@ inline double EventBase::solveForRealTimeInterval(const State *pState, double t0
 #endif // EVENTBASE_ALWAYS_CHECK_NANTIME
 
 	m_tLastCalc = t0;
-
-	return dt;
 }
 
 inline void EventBase::subtractInternalTimeInterval(const State *pState, double t1)
@@ -200,6 +236,13 @@ inline void EventBase::subtractInternalTimeInterval(const State *pState, double
 	assert(m_tLastCalc >= 0);
 
 	double dT = calculateInternalTimeInterval(pState, m_tLastCalc, t1 - m_tLastCalc); 
+	subtractInternalTimeInterval(pState, t1, dT);
+}
+
+inline void EventBase::subtractInternalTimeInterval(const State *pState, double t1, double dT)
+{ 
+	assert(m_Tdiff >= 0); // Could be the case for simultaneous events
+	assert(m_tLastCalc >= 0);
 
 #ifndef NDEBUG
 	if (s_checkInverse)
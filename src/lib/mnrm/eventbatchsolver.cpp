@@ -0,0 +1,61 @@
+#include "eventbatchsolver.h"
+#include "eventbase.h"
+
+EventBatchList::EventBatchList()
+{
+}
+
+EventBatchList::~EventBatchList()
+{
+}
+
+bool EventBatchList::addEvent(EventBase *pEvt, const State *pState)
+{
+	assert(pEvt != 0);
+
+	EventBatchSolver *pSolver = pEvt->getBatchSolver(pState);
+	if (!pSolver)
+		return false;
+
+	// There will only be a few different solvers, a linear search is fine
+	size_t idx = 0;
+	while (idx < m_solvers.size() && m_solvers[idx] != pSolver)
+		idx++;
+
+	if (idx == m_solvers.size())
+	{
+		m_solvers.push_back(pSolver);
+		m_events.resize(m_solvers.size());
+	}
+
+	m_events[idx].push_back(pEvt);
+	return true;
+}
+
+void EventBatchList::solveForRealTimeIntervals(const State *pState, double t0)
+{
+	for (size_t i = 0 ; i < m_solvers.size() ; i++)
+	{
+		std::vector<EventBase *> &events = m_events[i];
+
+		if (events.size() == 0)
+			continue;
+
+		m_solvers[i]->solveForRealTimeIntervals(pState, &(events[0]), (int)events.size(), t0);
+		events.resize(0);
+	}
+}
+
+void EventBatchList::subtractInternalTimeIntervals(const State *pState, double t1)
+{
+	for (size_t i = 0 ; i < m_solvers.size() ; i++)
+	{
+		std::vector<EventBase *> &events = m_events[i];
+
+		if (events.size() == 0)
+			continue;
+
+		m_solvers[i]->subtractInternalTimeIntervals(pState, &(events[0]), (int)events.size(), t1);
+		events.resize(0);
+	}
+}
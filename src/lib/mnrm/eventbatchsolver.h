@@ -0,0 +1,71 @@
+#ifndef EVENTBATCHSOLVER_H
+
+#define EVENTBATCHSOLVER_H
+
+/**
+ * \file eventbatchsolver.h
+ */
+
+#include <vector>
+
+class State;
+class EventBase;
+
+/** An event can return an instance of a class derived from this one in its
+ *  EventBase::getBatchSolver implementation, to indicate that its fire time can be
+ *  calculated together with the fire times of other events that return the same
+ *  solver.
+ *
+ *  Instead of calling EventBase::solveForRealTimeInterval and EventBase::subtractInternalTimeInterval
+ *  for each event separately, an algorithm can then collect such events (see EventBatchList)
+ *  and process them at once. This allows an implementation to store the parameters of the
+ *  hazards in arrays, so that the calculations can be vectorized, and to calculate things that
+ *  are the same for every event only once.
+ *
+ *  The results should correspond to the ones of the events' own EventBase::calculateInternalTimeInterval
+ *  and EventBase::solveForRealTimeInterval implementations, to within a tolerance that
+ *  the implementation should document.
+ */
+class EventBatchSolver
+{
+public:
+	EventBatchSolver()										{ }
+	virtual ~EventBatchSolver()									{ }
+
+	/** For each of the \c num events in \c ppEvents, this should calculate the real world
+	 *  time interval starting at \c t0 that corresponds to the internal time that's left
+	 *  for the event (EventBase::getInternalTimeLeft), and store it using EventBase::setRealTimeInterval. */
+	virtual void solveForRealTimeIntervals(const State *pState, EventBase **ppEvents, int num, double t0) = 0;
+
+	/** For each of the \c num events in \c ppEvents, this should calculate the internal time
+	 *  interval that corresponds to the real world interval from EventBase::getLastCalculationTime
+	 *  until \c t1, and subtract it using EventBase::subtractInternalTimeInterval(const State *, double, double). */
+	virtual void subtractInternalTimeIntervals(const State *pState, EventBase **ppEvents, int num, double t1) = 0;
+};
+
+/** Helper class to collect events per EventBatchSolver, so that the time calculations
+ *  for each solver can be performed at once. */
+class EventBatchList
+{
+public:
+	EventBatchList();
+	~EventBatchList();
+
+	/** Adds the event to the list of its batch solver, or returns false if the
+	 *  event doesn't have a batch solver, in which case its time calculations
+	 *  need to be done by the event itself. */
+	bool addEvent(EventBase *pEvt, const State *pState);
+
+	/** Lets each batch solver calculate the fire times of the collected events,
+	 *  starting from \c t0, and clears the lists. */
+	void solveForRealTimeIntervals(const State *pState, double t0);
+
+	/** Lets each batch solver subtract the internal time intervals up to \c t1 for
+	 *  the collected events, and clears the lists. */
+	void subtractInternalTimeIntervals(const State *pState, double t1);
+private:
+	std::vector<EventBatchSolver *> m_solvers;
+	std::vector<std::vector<EventBase *> > m_events;
+};
+
+#endif // EVENTBATCHSOLVER_H
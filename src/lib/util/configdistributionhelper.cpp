@@ -414,9 +414,9 @@ ProbabilityDistribution2D *getDistribution2DFromConfig(ConfigSettings &config, G
 	}
 	else if (distName == "discrete")
 	{
-		string densFileName, maskFileName;
+		string densFileName, maskFileName, cacheFileName;
 		double xOffset = 0, yOffset = 0, width = 0, height = 0;
-		bool flipy = false, floor = false;
+		bool flipy = false, floor = false, compact = false;
 
 		if (!(r = config.getKeyValue(prefix + ".dist2d.discrete.densfile", densFileName)) ||
 		    !(r = config.getKeyValue(prefix + ".dist2d.discrete.maskfile", maskFileName)) ||
@@ -425,14 +425,16 @@ ProbabilityDistribution2D *getDistribution2DFromConfig(ConfigSettings &config, G
 		    !(r = config.getKeyValue(prefix + ".dist2d.discrete.width", width)) ||
 		    !(r = config.getKeyValue(prefix + ".dist2d.discrete.height", height)) ||
 		    !(r = config.getKeyValue(prefix + ".dist2d.discrete.flipy", flipy)) ||
-			!(r = config.getKeyValue(prefix + ".dist2d.discrete.floor", floor)) 
+			!(r = config.getKeyValue(prefix + ".dist2d.discrete.floor", floor)) ||
+			!(r = config.getKeyValue(prefix + ".dist2d.discrete.cachefile", cacheFileName)) ||
+			!(r = config.getKeyValue(prefix + ".dist2d.discrete.compact", compact))
 		   )
 			abortWithMessage(r.getErrorString());
 
 		DiscreteDistributionWrapper2D *pDist0 = new DiscreteDistributionWrapper2D(pRndGen);
 		pDist = pDist0;
 
-		if (!(r = pDist0->init(densFileName, maskFileName, xOffset, yOffset, width, height, flipy, floor)))
+		if (!(r = pDist0->init(densFileName, maskFileName, xOffset, yOffset, width, height, flipy, floor, cacheFileName, compact)))
 			abortWithMessage("Unable to initialize 2D discrete distribution for " + prefix + ": " + r.getErrorString());
 	}
 	else
@@ -533,7 +535,9 @@ void addDistribution2DToConfig(ProbabilityDistribution2D *pSrcDist, ConfigWriter
 			    !(r = config.addKey(prefix + ".dist2d.discrete.width", pDist->getWidth())) ||
 			    !(r = config.addKey(prefix + ".dist2d.discrete.height", pDist->getHeight())) ||
 			    !(r = config.addKey(prefix + ".dist2d.discrete.flipy", pDist->isYFlipped())) ||
-				!(r = config.addKey(prefix + ".dist2d.discrete.floor", pDist->isFloored())) )
+				!(r = config.addKey(prefix + ".dist2d.discrete.floor", pDist->isFloored())) ||
+				!(r = config.addKey(prefix + ".dist2d.discrete.cachefile", pDist->getCacheFileName())) ||
+				!(r = config.addKey(prefix + ".dist2d.discrete.compact", pDist->isCompact())) )
 				abortWithMessage(r.getErrorString());
 
 			return;
@@ -674,7 +678,9 @@ JSONConfig distribution2DJSONConfig("distTypes2D", R"JSON(
                 [ "width", 1 ],
                 [ "height", 1 ],
                 [ "flipy", "yes", [ "yes", "no"] ],
-				[ "floor", "no" ]
+				[ "floor", "no" ],
+				[ "cachefile", "" ],
+				[ "compact", "no", [ "yes", "no" ] ]
             ],
             "info": [ 
                 "The 'densfile' parameter specifies a TIFF file you want to use to base a",
@@ -691,7 +697,15 @@ JSONConfig distribution2DJSONConfig("distTypes2D", R"JSON(
                 "point down and the (0,0) pixel would be the upper-left pixel. This is what",
                 "is used when 'flipy' is set to 'no'. The default however is 'yes', which",
                 "causes the lower-left pixel to be the (0,0) pixel of the TIFF file, and",
-                "which causes the y-axis to point up, as usually will be desired."
+                "which causes the y-axis to point up, as usually will be desired.",
+                "",
+                "If 'cachefile' is set, the tables that are built from the density and",
+                "mask files are stored in this file, and the next time they are read from",
+                "it directly, as long as the density and mask files have not changed.",
+                "",
+                "Setting 'compact' to 'yes' uses less memory for large grids with many",
+                "zeros, by storing single precision sums and skipping the parts that are",
+                "zero. This can't be combined with a cache file."
             ]
         })JSON");
 
@@ -13,7 +13,14 @@ ConfigFunctions::ConfigFunctions(ProcessConfigFunction processFunction, ObtainCo
 {
 	check();
 
-	(*s_pConfigFunctionMap)[categoryName].push_back(ConfigFunctionsInternal(processFunction, obtainFunction, name));
+	// The functions are kept sorted by name, so that they are always executed in
+	// the same order. This is only done here, while registering the functions during
+	// the static initialization, so that the map isn't modified afterwards.
+	vector<ConfigFunctionsInternal> &v = (*s_pConfigFunctionMap)[categoryName];
+	ConfigFunctionsInternal newFunction(processFunction, obtainFunction, name);
+	ConfigFunctionsInternal compareFunction;
+
+	v.insert(upper_bound(v.begin(), v.end(), newFunction, compareFunction), newFunction);
 }
 
 void ConfigFunctions::check()
@@ -22,33 +29,59 @@ void ConfigFunctions::check()
 		s_pConfigFunctionMap = new map<string, vector<ConfigFunctionsInternal> > ;
 }
 
-void ConfigFunctions::processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen,
+void ConfigFunctions::processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen, ReadKeysMap *pReadKeys,
 										    const vector<string> &excludeCategories)
+{
+	processConfigurations(config, pRndGen, pReadKeys, excludeCategories, 0);
+}
+
+void ConfigFunctions::processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen, ReadKeysMap *pReadKeys,
+										    const vector<string> &excludeCategories, const vector<string> &names)
+{
+	processConfigurations(config, pRndGen, pReadKeys, excludeCategories, &names);
+}
+
+void ConfigFunctions::processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen, ReadKeysMap *pReadKeys,
+										    const vector<string> &excludeCategories, const vector<string> *pNames)
 {
 	check();
 
-	map<string, vector<ConfigFunctionsInternal> >::iterator it = s_pConfigFunctionMap->begin();
-	ConfigFunctionsInternal compareFunction;
+	map<string, vector<ConfigFunctionsInternal> >::const_iterator it = s_pConfigFunctionMap->begin();
 
 	while (it != s_pConfigFunctionMap->end())
 	{
 		string cat = it->first;
-		vector<ConfigFunctionsInternal> &v = it->second;
+		const vector<ConfigFunctionsInternal> &v = it->second;
 
 		//cout << "Processing category " << cat << " (" << v.size() << ")" << endl;
 
 		if (!contains(excludeCategories, cat))
 		{
-			sort(v.begin(), v.end(), compareFunction);
-
 			for (size_t i = 0 ; i < v.size() ; i++)
 			{
 				ProcessConfigFunction procFunc = v[i].procFunc;
 
+				if (pNames && !contains(*pNames, v[i].name))
+					continue;
+
 				//cout << "  " << v[i].name << endl;
 
 				if (procFunc)
-					procFunc(config, pRndGen);
+				{
+					if (pReadKeys)
+					{
+						// Keep track of the keys that are used, so that we can check later
+						// on if this function needs to be executed again for a changed config
+						set<string> &readKeys = (*pReadKeys)[v[i].name];
+
+						readKeys.clear();
+						config.startRecordingReadKeys(readKeys);
+						procFunc(config, pRndGen);
+						config.stopRecordingReadKeys();
+					}
+					else
+						procFunc(config, pRndGen);
+				}
 			}
 		}
 		//else
@@ -58,22 +91,63 @@ void ConfigFunctions::processConfigurations(ConfigSettings &config, GslRandomNum
 	}
 }
 
+void ConfigFunctions::getChangedConfigurations(const ReadKeysMap &readKeys, const ConfigSettings &oldConfig, const ConfigSettings &newConfig,
+		                                       const vector<string> &excludeCategories, vector<string> &names)
+{
+	check();
+
+	names.clear();
+
+	map<string, vector<ConfigFunctionsInternal> >::const_iterator it = s_pConfigFunctionMap->begin();
+
+	while (it != s_pConfigFunctionMap->end())
+	{
+		const vector<ConfigFunctionsInternal> &v = it->second;
+
+		if (!contains(excludeCategories, it->first))
+		{
+			for (size_t i = 0 ; i < v.size() ; i++)
+			{
+				ReadKeysMap::const_iterator keysIt = readKeys.find(v[i].name);
+
+				if (keysIt == readKeys.end()) // hasn't been executed yet
+					continue;
+
+				const set<string> &keys = keysIt->second;
+				bool changed = false;
+
+				for (set<string>::const_iterator kit = keys.begin() ; !changed && kit != keys.end() ; kit++)
+				{
+					string oldValue, newValue;
+					bool used;
+					bool hasOld = oldConfig.getStringKeyValue(*kit, oldValue, used);
+					bool hasNew = newConfig.getStringKeyValue(*kit, newValue, used);
+
+					if (hasOld != hasNew || oldValue != newValue)
+						changed = true;
+				}
+
+				if (changed)
+					names.push_back(v[i].name);
+			}
+		}
+		it++;
+	}
+}
+
 void ConfigFunctions::obtainConfigurations(ConfigWriter &config, const vector<string> &excludeCategories)
 {
 	check();
 
-	map<string, vector<ConfigFunctionsInternal> >::iterator it = s_pConfigFunctionMap->begin();
-	ConfigFunctionsInternal compareFunction;
+	map<string, vector<ConfigFunctionsInternal> >::const_iterator it = s_pConfigFunctionMap->begin();
 
 	while (it != s_pConfigFunctionMap->end())
 	{
 		string cat = it->first;
-		vector<ConfigFunctionsInternal> &v = it->second;
+		const vector<ConfigFunctionsInternal> &v = it->second;
 
 		if (!contains(excludeCategories, cat))
 		{
-			sort(v.begin(), v.end(), compareFunction);
-
 			for (size_t i = 0 ; i < v.size() ; i++)
 			{
 				ObtainConfigFunction obtFunc = v[i].obtFunc;
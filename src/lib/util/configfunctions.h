@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
 
 class ConfigSettings;
 class ConfigWriter;
@@ -16,14 +17,35 @@ public:
 	typedef void (*ProcessConfigFunction)(ConfigSettings &config, GslRandomNumberGenerator *pRngGen);
 	typedef void (*ObtainConfigFunction)(ConfigWriter &config);
 
+	// For each processing function, the keys it read during its last execution
+	typedef std::map<std::string, std::set<std::string> > ReadKeysMap;
+
 	ConfigFunctions(ProcessConfigFunction processFunction, ObtainConfigFunction obtainFunction,
 			        const std::string &name, const std::string &categoryName = "default");
 
-	static void processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen, 
+	// If pReadKeys is not null, the keys that are read by each processing function
+	// are stored in it
+	static void processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen, ReadKeysMap *pReadKeys,
 			                          const std::vector<std::string> &excludeCategories = std::vector<std::string>() );
+
+	// Executes only the processing functions with the specified names, in the same order
+	// as processConfigurations would
+	static void processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen, ReadKeysMap *pReadKeys,
+			                          const std::vector<std::string> &excludeCategories,
+									  const std::vector<std::string> &names);
+
+	// Stores the names of the processing functions that read a key (during their last
+	// execution, as stored in readKeys) for which the value differs between oldConfig
+	// and newConfig
+	static void getChangedConfigurations(const ReadKeysMap &readKeys, const ConfigSettings &oldConfig, const ConfigSettings &newConfig,
+			                             const std::vector<std::string> &excludeCategories,
+										 std::vector<std::string> &names);
 	static void obtainConfigurations(ConfigWriter &config, const std::vector<std::string> &excludeCategories = std::vector<std::string>());
 private:
 	static void check();
+	static void processConfigurations(ConfigSettings &config, GslRandomNumberGenerator *pRndGen, ReadKeysMap *pReadKeys,
+			                          const std::vector<std::string> &excludeCategories,
+									  const std::vector<std::string> *pNames);
 
 	class ConfigFunctionsInternal
 	{
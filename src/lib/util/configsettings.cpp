@@ -1,6 +1,7 @@
 #include "configsettings.h"
 #include <stdlib.h>
 #include <iostream>
+#include <algorithm>
 
 #define __STDC_FORMAT_MACROS // Need this for PRId64
 #include <inttypes.h>
@@ -10,6 +11,7 @@ using namespace std;
 
 ConfigSettings::ConfigSettings()
 {
+	m_pReadKeys = 0;
 }
 
 ConfigSettings::~ConfigSettings()
@@ -25,7 +27,7 @@ bool_t ConfigSettings::load(const std::string &fileName)
 		return "Unable to load file: " + r.getErrorString();
 
 	clear();
-	
+
 	vector<string> keys;
 
 	reader.getKeys(keys);
@@ -36,7 +38,7 @@ bool_t ConfigSettings::load(const std::string &fileName)
 		if (!reader.getKeyValue(keys[i], value))
 			abortWithMessage("ConfigSettings: internal error: lost value for key " + keys[i]);
 
-		m_keyValues[keys[i]] = pair<string,bool>(value, false);
+		m_keyValues[ConfigKey(keys[i])] = Entry(value);
 	}
 
 	return true;
@@ -49,38 +51,51 @@ void ConfigSettings::clear()
 
 void ConfigSettings::getKeys(std::vector<std::string> &keys) const
 {
-	map<string,pair<string,bool> >::const_iterator it = m_keyValues.begin();
+	unordered_map<ConfigKey,Entry,KeyHash>::const_iterator it = m_keyValues.begin();
 
 	keys.clear();
 	while (it != m_keyValues.end())
 	{
-		keys.push_back(it->first);
+		keys.push_back(it->first.getKey());
 		it++;
 	}
+
+	// The order in the hash table is not well defined
+	sort(keys.begin(), keys.end());
 }
 
-bool_t ConfigSettings::getStringKeyValue(const string &key, string &value, bool &used) const
+ConfigSettings::Entry *ConfigSettings::findEntry(const ConfigKey &key)
 {
-	map<string,pair<string,bool> >::const_iterator it;
+	if (m_pReadKeys)
+		m_pReadKeys->insert(key.getKey());
 
-	it = m_keyValues.find(key);
+	unordered_map<ConfigKey,Entry,KeyHash>::iterator it = m_keyValues.find(key);
 	if (it == m_keyValues.end())
-		return "Key '" + key + "' not found";
+		return 0;
 
-	value = it->second.first;
-	used = it->second.second;
-	return true;
+	return &(it->second);
 }
 
-bool_t ConfigSettings::getKeyValue(const std::string &key, std::string &value, const vector<string> &allowedValues)
+bool_t ConfigSettings::getStringKeyValue(const ConfigKey &key, string &value, bool &used) const
 {
-	map<string,pair<string,bool> >::iterator it;
+	unordered_map<ConfigKey,Entry,KeyHash>::const_iterator it;
 
 	it = m_keyValues.find(key);
 	if (it == m_keyValues.end())
-		return "Key '" + key + "' not found";
+		return "Key '" + key.getKey() + "' not found";
+
+	value = it->second.value;
+	used = it->second.used;
+	return true;
+}
 
-	value = it->second.first;
+bool_t ConfigSettings::getKeyValue(const ConfigKey &key, std::string &value, const vector<string> &allowedValues)
+{
+	Entry *pEntry = findEntry(key);
+	if (!pEntry)
+		return "Key '" + key.getKey() + "' not found";
+
+	value = pEntry->value;
 
 	if (allowedValues.size() > 0)
 	{
@@ -102,107 +117,144 @@ bool_t ConfigSettings::getKeyValue(const std::string &key, std::string &value, c
 				extraInfo += "'" + allowedValues[i] + "'";
 			}
 			extraInfo += ")";
-			return "Specified value '" + value + "' for key '" + key + "' is not an allowed value " + extraInfo + ".";
+			return "Specified value '" + value + "' for key '" + key.getKey() + "' is not an allowed value " + extraInfo + ".";
 		}
 	}
 
-	it->second.second = true; // mark the key as used
+	pEntry->used = true; // mark the key as used
 	return true;
 }
 
 void ConfigSettings::getUnusedKeys(std::vector<std::string> &keys) const
 {
-	map<string,pair<string,bool> >::const_iterator it = m_keyValues.begin();
+	unordered_map<ConfigKey,Entry,KeyHash>::const_iterator it = m_keyValues.begin();
 
 	keys.clear();
 	while (it != m_keyValues.end())
 	{
-		if (!it->second.second) // boolean flag is still set to false
-			keys.push_back(it->first);
+		if (!it->second.used) // boolean flag is still set to false
+			keys.push_back(it->first.getKey());
 		it++;
 	}
+
+	sort(keys.begin(), keys.end());
 }
 
-bool_t ConfigSettings::getKeyValue(const std::string &key, double &value, double minValue, double maxValue)
+// The string is only parsed the first time the value is requested as a number
+bool_t ConfigSettings::getDoubleValue(const ConfigKey &key, double &value)
 {
-	string valueStr;
-	bool_t r = getKeyValue(key, valueStr);
+	Entry *pEntry = findEntry(key);
+	if (!pEntry)
+		return "Key '" + key.getKey() + "' not found";
+
+	if (pEntry->doubleState == Entry::NotParsed)
+	{
+		if (parseAsDouble(pEntry->value, pEntry->doubleValue))
+			pEntry->doubleState = Entry::Parsed;
+		else
+			pEntry->doubleState = Entry::ParseFailed;
+	}
+
+	pEntry->used = true;
+	if (pEntry->doubleState == Entry::ParseFailed)
+		return "Can't interpret value for key '" + key.getKey() + "' as a floating point number";
+
+	value = pEntry->doubleValue;
+	return true;
+}
+
+bool_t ConfigSettings::getIntegerValue(const ConfigKey &key, int64_t &value)
+{
+	Entry *pEntry = findEntry(key);
+	if (!pEntry)
+		return "Key '" + key.getKey() + "' not found";
+
+	if (pEntry->intState == Entry::NotParsed)
+	{
+		if (parseAsInt(pEntry->value, pEntry->intValue))
+			pEntry->intState = Entry::Parsed;
+		else
+			pEntry->intState = Entry::ParseFailed;
+	}
+
+	pEntry->used = true;
+	if (pEntry->intState == Entry::ParseFailed)
+		return "Can't interpret value for key '" + key.getKey() + "' as an integer number";
+
+	value = pEntry->intValue;
+	return true;
+}
+
+bool_t ConfigSettings::getKeyValue(const ConfigKey &key, double &value, double minValue, double maxValue)
+{
+	bool_t r = getDoubleValue(key, value);
 
 	if (!r)
 		return r;
 
-	if (!parseAsDouble(valueStr, value))
-		return "Can't interpret value for key '" + key + "' as a floating point number";
-
 	if (value < minValue || value > maxValue)
-		return strprintf("The value for '%s' must lie between %g and %g, but is %g", key.c_str(), minValue, maxValue, value);
+		return strprintf("The value for '%s' must lie between %g and %g, but is %g", key.getKey().c_str(), minValue, maxValue, value);
 
 	return true;
 }
 
-bool_t ConfigSettings::getKeyValue(const std::string &key, int &value, int minValue, int maxValue)
+bool_t ConfigSettings::getKeyValue(const ConfigKey &key, int &value, int minValue, int maxValue)
 {
-	string valueStr;
-	bool_t r = getKeyValue(key, valueStr);
+	int64_t v = 0;
+	bool_t r = getIntegerValue(key, v);
 
 	if (!r)
 		return r;
 
-	if (!parseAsInt(valueStr, value))
-		return "Can't interpret value for key '" + key + "' as an integer number";
+	value = (int)v;
+	if ((int64_t)value != v)
+		return "Can't interpret value for key '" + key.getKey() + "' as an integer number";
 
 	if (value < minValue || value > maxValue)
-		return strprintf("The value for '%s' must lie between %d and %d, but is %d", key.c_str(), minValue, maxValue, value);
+		return strprintf("The value for '%s' must lie between %d and %d, but is %d", key.getKey().c_str(), minValue, maxValue, value);
 
 	return true;
 }
 
-bool_t ConfigSettings::getKeyValue(const std::string &key, int64_t &value, int64_t minValue, int64_t maxValue)
+bool_t ConfigSettings::getKeyValue(const ConfigKey &key, int64_t &value, int64_t minValue, int64_t maxValue)
 {
-	string valueStr;
-	bool_t r = getKeyValue(key, valueStr);
+	bool_t r = getIntegerValue(key, value);
 
 	if (!r)
 		return r;
 
-	if (!parseAsInt(valueStr, value))
-		return "Can't interpret value for key '" + key + "' as an integer number";
-
 	if (value < minValue || value > maxValue)
-		return strprintf("The value for '%s' must lie between %" PRId64 " and %" PRId64 ", but is %" PRId64 "", key.c_str(), minValue, maxValue, value);
+		return strprintf("The value for '%s' must lie between %" PRId64 " and %" PRId64 ", but is %" PRId64 "", key.getKey().c_str(), minValue, maxValue, value);
 
 	return true;
 }
 
 void ConfigSettings::clearUsageFlags()
 {
-	map<string,pair<string,bool> >::iterator it = m_keyValues.begin();
+	unordered_map<ConfigKey,Entry,KeyHash>::iterator it = m_keyValues.begin();
 
 	while (it != m_keyValues.end())
 	{
-		it->second.second = false;
+		it->second.used = false;
 		it++;
 	}
 }
 
 void ConfigSettings::merge(const ConfigSettings &src)
 {
-	map<string,pair<string,bool> >::const_iterator srcIt = src.m_keyValues.begin();
-	map<string,pair<string,bool> >::const_iterator srcEndIt = src.m_keyValues.end();
+	unordered_map<ConfigKey,Entry,KeyHash>::const_iterator srcIt = src.m_keyValues.begin();
+	unordered_map<ConfigKey,Entry,KeyHash>::const_iterator srcEndIt = src.m_keyValues.end();
 
 	while (srcIt != srcEndIt)
 	{
-		string key = srcIt->first;
-		pair<string,bool> value = srcIt->second;
-
 		// Overwrites an existing entry or adds a non-existing one
-		m_keyValues[key] = value;
+		m_keyValues[srcIt->first] = srcIt->second;
 
 		srcIt++;
 	}
 }
 
-bool_t ConfigSettings::getKeyValue(const string &key, vector<double> &values, double minValue, double maxValue)
+bool_t ConfigSettings::getKeyValue(const ConfigKey &key, vector<double> &values, double minValue, double maxValue)
 {
 	string valueStr;
 	bool_t r = getKeyValue(key, valueStr);
@@ -213,19 +265,19 @@ bool_t ConfigSettings::getKeyValue(const string &key, vector<double> &values, do
 	string badField;
 
 	if (!parseAsDoubleVector(valueStr, values, badField))
-		return "Can't interpret value for key '" + key + "' as a list of floating point numbers (field '" + badField + "' is bad)";
+		return "Can't interpret value for key '" + key.getKey() + "' as a list of floating point numbers (field '" + badField + "' is bad)";
 
 	for (size_t i = 0 ; i < values.size() ; i++)
 	{
 		double value = values[i];
 		if (value < minValue || value > maxValue)
-			return strprintf("Each value for '%s' must lie between %g and %g, but one is %g", key.c_str(), minValue, maxValue, value);
+			return strprintf("Each value for '%s' must lie between %g and %g, but one is %g", key.getKey().c_str(), minValue, maxValue, value);
 	}
 
 	return true;
 }
 
-bool_t ConfigSettings::getKeyValue(const std::string &key, bool &value)
+bool_t ConfigSettings::getKeyValue(const ConfigKey &key, bool &value)
 {
 	vector<string> yesNoOptions;
 	string yesNo;
@@ -245,4 +297,3 @@ bool_t ConfigSettings::getKeyValue(const std::string &key, bool &value)
 
 	return true;
 }
-
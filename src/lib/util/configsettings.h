@@ -10,6 +10,31 @@
 #include "util.h"
 #include <stdint.h>
 #include <limits>
+#include <set>
+#include <unordered_map>
+#include <functional>
+
+/** A key for the ConfigSettings class, for which the hash value is calculated only once.
+ *
+ *  A processing function that reads the same keys each time it is executed can store
+ *  these in static ConfigKey instances, so that the key strings don't need to be built
+ *  and hashed again for each lookup. Since a ConfigKey can be constructed implicitly
+ *  from a string, the plain key names can still be used as well.
+ */
+class ConfigKey
+{
+public:
+	ConfigKey(const std::string &key) : m_key(key), m_hash(std::hash<std::string>()(key))		{ }
+	ConfigKey(const char *pKey) : m_key(pKey), m_hash(std::hash<std::string>()(m_key))			{ }
+
+	const std::string &getKey() const								{ return m_key; }
+	size_t getHash() const										{ return m_hash; }
+
+	bool operator==(const ConfigKey &k) const							{ return m_hash == k.m_hash && m_key == k.m_key; }
+private:
+	std::string m_key;
+	size_t m_hash;
+};
 
 /** Helper class to read configuration settings, more advanced than ConfigReader.
  *  
@@ -17,12 +42,16 @@
  *  files should have the same format. Extra features of this class are the
  *  ability to interpret specific keys as integer or floating point values for
  *  example, and to check which keys have actually been read.
+ *
+ *  The keys are stored in a hash table, and a value that is requested as a number
+ *  is only parsed the first time, so that reading the same configuration again
+ *  (e.g. for an intervention) is cheap.
  */
 class ConfigSettings
 {
 public:
 	ConfigSettings();
-	ConfigSettings(const ConfigSettings &src)						{ m_keyValues = src.m_keyValues; }
+	ConfigSettings(const ConfigSettings &src)						{ m_keyValues = src.m_keyValues; m_pReadKeys = 0; }
 	virtual ~ConfigSettings();
 
 	ConfigSettings &operator=(const ConfigSettings &src)					{ m_keyValues = src.m_keyValues; return *this; }
@@ -33,44 +62,44 @@ public:
 	/** Clears the loaded key/value pairs. */
 	void clear();
 
-	/** Returns a list of all the keys in the read config file. */
+	/** Returns a (sorted) list of all the keys in the read config file. */
 	void getKeys(std::vector<std::string> &keys) const;
 
 	/** Stores the string value for key parameter \c key into argument \c value, checking
 	 *  if the value is one of the allowed values in the list \c allowedValues, if specified. */
-	bool_t getKeyValue(const std::string &key, std::string &value, const std::vector<std::string> &allowedValues = std::vector<std::string>() );
+	bool_t getKeyValue(const ConfigKey &key, std::string &value, const std::vector<std::string> &allowedValues = std::vector<std::string>() );
 
 	/** Interprets the value for the specified key as a double precision floating point number,
 	 *  checking that it lies withing the bounds if specified. */
 	// std::numeric_limits<double>::min() is the smallest in absolute value, can't use that here!
-	bool_t getKeyValue(const std::string &key, double &value, double minValue = -std::numeric_limits<double>::infinity(), 
+	bool_t getKeyValue(const ConfigKey &key, double &value, double minValue = -std::numeric_limits<double>::infinity(), 
 	                 double maxValue = std::numeric_limits<double>::infinity());
 
 	/** Interprets the value for the specified key as a list of double precision floating point numbers,
 	 *  checking that each lies withing the bounds if specified. */
 	// std::numeric_limits<double>::min() is the smallest in absolute value, can't use that here!
-	bool_t getKeyValue(const std::string &key, std::vector<double> &values, 
+	bool_t getKeyValue(const ConfigKey &key, std::vector<double> &values, 
 			 double minValue = -std::numeric_limits<double>::infinity(), 
 	                 double maxValue = std::numeric_limits<double>::infinity());
 
 	/** Interprets the value for the specified key as an integer number,
 	 *  checking that it lies withing the bounds if specified. */
-	bool_t getKeyValue(const std::string &key, int &value, int minValue = std::numeric_limits<int>::min(),
+	bool_t getKeyValue(const ConfigKey &key, int &value, int minValue = std::numeric_limits<int>::min(),
 	                 int maxValue = std::numeric_limits<int>::max());
 
 	/** Interprets the value for the specified key as an integer number,
 	 *  checking that it lies withing the bounds if specified. */
-	bool_t getKeyValue(const std::string &key, int64_t &value, int64_t minValue = std::numeric_limits<int64_t>::min(),
+	bool_t getKeyValue(const ConfigKey &key, int64_t &value, int64_t minValue = std::numeric_limits<int64_t>::min(),
 	                 int64_t maxValue = std::numeric_limits<int64_t>::max());
 
 	/** Interprets the value for the specified key as a boolean, possible values can be 'yes' or 'no'. */
-	bool_t getKeyValue(const std::string &key, bool &value);
+	bool_t getKeyValue(const ConfigKey &key, bool &value);
 
 	/** Obtains the value for the specified key, not marking the key as used, but instead
 	 *  storing information about the key's prior usage in the \c used parameter. */
-	bool_t getStringKeyValue(const std::string &key, std::string &value, bool &used) const;
+	bool_t getStringKeyValue(const ConfigKey &key, std::string &value, bool &used) const;
 	
-	/** Stores a list of keys that have not been read by any of the getKeyValue functions into \c keys (allows
+	/** Stores a (sorted) list of keys that have not been read by any of the getKeyValue functions into \c keys (allows
 	 *  you to check if the config file contains more lines than necessary). */
 	void getUnusedKeys(std::vector<std::string> &keys) const;
 
@@ -79,9 +108,45 @@ public:
 
 	/** Merges the specified config settings object into the current one. */
 	void merge(const ConfigSettings &src);
+
+	/** Until ConfigSettings::stopRecordingReadKeys is called, each key that is requested
+	 *  by one of the getKeyValue functions (whether it exists or not) will be stored in
+	 *  \c keys. */
+	void startRecordingReadKeys(std::set<std::string> &keys)					{ m_pReadKeys = &keys; }
+
+	/** Stops recording the requested keys. */
+	void stopRecordingReadKeys()										{ m_pReadKeys = 0; }
 private:
-	std::map<std::string, std::pair<std::string, bool> > m_keyValues;
+	// The string value of a key, and the number it represents once it has been
+	// requested as such
+	class Entry
+	{
+	public:
+		Entry(const std::string &v = std::string()) : value(v), used(false), doubleState(NotParsed), 
+		                                              doubleValue(0), intState(NotParsed), intValue(0) { }
+
+		enum ParseState : int8_t { NotParsed, Parsed, ParseFailed };
+
+		std::string value;
+		bool used;
+		ParseState doubleState;
+		double doubleValue;
+		ParseState intState;
+		int64_t intValue;
+	};
+
+	class KeyHash
+	{
+	public:
+		size_t operator()(const ConfigKey &k) const						{ return k.getHash(); }
+	};
+
+	Entry *findEntry(const ConfigKey &key);
+	bool_t getDoubleValue(const ConfigKey &key, double &value);
+	bool_t getIntegerValue(const ConfigKey &key, int64_t &value);
+
+	std::unordered_map<ConfigKey, Entry, KeyHash> m_keyValues;
+	std::set<std::string> *m_pReadKeys;
 };
 
 #endif // CONFIGSETTINGS_H
-
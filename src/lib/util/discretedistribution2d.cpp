@@ -3,6 +3,7 @@
 #include "util.h"
 #include <iostream>
 #include <limits>
+#include <algorithm>
 
 using namespace std;
 
@@ -27,6 +28,110 @@ DiscreteDistribution2D::DiscreteDistribution2D(double xOffset, double yOffset, d
 	m_floor = floor;
 }
 
+#ifndef OLDTEST
+DiscreteDistribution2D::DiscreteDistribution2D(double xOffset, double yOffset, double xSize, double ySize,
+					       int width, int height, bool flippedY, const double *pTables, size_t numTableValues,
+					       bool floor, GslRandomNumberGenerator *pRngGen) : ProbabilityDistribution2D(pRngGen, true)
+{
+	assert(width > 0 && height > 0);
+	assert(pTables != 0);
+
+	if (numTableValues != getNumberOfTableValues(width, height))
+		abortWithMessage("Number of table values does not match the dimensions in DiscreteDistribution2D");
+
+	m_xSize = xSize;
+	m_ySize = ySize;
+	m_xOffset = xOffset;
+	m_yOffset = yOffset;
+
+	m_width = width;
+	m_height = height;
+
+	// Same order as in writeTables
+	const int rowSize = DiscreteDistributionFast::getTableSize(width);
+	const int columnSize = DiscreteDistributionFast::getTableSize(height);
+	const double *pTable = pTables;
+
+	m_pMarginalYDist = new DiscreteDistributionFast(0, height, height, pTable, false, pRngGen);
+	pTable += columnSize;
+	for (int y = 0 ; y < height ; y++, pTable += rowSize)
+		m_conditionalXDists.push_back(new DiscreteDistributionFast(0, width, width, pTable, false, pRngGen));
+
+	m_pMarginalXDist = new DiscreteDistributionFast(0, width, width, pTable, false, pRngGen);
+	pTable += rowSize;
+	for (int x = 0 ; x < width ; x++, pTable += columnSize)
+		m_conditionalYDists.push_back(new DiscreteDistributionFast(0, height, height, pTable, false, pRngGen));
+
+	assert(pTable == pTables + numTableValues);
+
+	m_flippedY = flippedY;
+	m_floor = floor;
+}
+
+size_t DiscreteDistribution2D::getNumberOfTableValues(int width, int height)
+{
+	size_t rowSize = DiscreteDistributionFast::getTableSize(width);
+	size_t columnSize = DiscreteDistributionFast::getTableSize(height);
+
+	return (1 + (size_t)height)*rowSize + (1 + (size_t)width)*columnSize;
+}
+
+// The marginal distribution for y and the conditional ones for x, followed
+// by the marginal distribution for x and the conditional ones for y
+void DiscreteDistribution2D::getTableDistributions(vector<const DiscreteDistributionFast *> &dists, vector<int> &sizes) const
+{
+	dists.clear();
+	sizes.clear();
+
+	dists.push_back(m_pMarginalYDist);
+	sizes.push_back(m_height);
+	for (size_t i = 0 ; i < m_conditionalXDists.size() ; i++)
+	{
+		dists.push_back(m_conditionalXDists[i]);
+		sizes.push_back(m_width);
+	}
+
+	dists.push_back(m_pMarginalXDist);
+	sizes.push_back(m_width);
+	for (size_t i = 0 ; i < m_conditionalYDists.size() ; i++)
+	{
+		dists.push_back(m_conditionalYDists[i]);
+		sizes.push_back(m_height);
+	}
+}
+
+bool_t DiscreteDistribution2D::writeTables(FILE *pFile) const
+{
+	vector<const DiscreteDistributionFast *> dists;
+	vector<int> sizes;
+
+	getTableDistributions(dists, sizes);
+	for (size_t i = 0 ; i < dists.size() ; i++)
+	{
+		size_t num = DiscreteDistributionFast::getTableSize(sizes[i]);
+		if (fwrite(dists[i]->getTable(), sizeof(double), num, pFile) != num)
+			return "Unable to write table values";
+	}
+	return true;
+}
+
+void DiscreteDistribution2D::getTables(vector<double> &tables) const
+{
+	vector<const DiscreteDistributionFast *> dists;
+	vector<int> sizes;
+
+	getTableDistributions(dists, sizes);
+
+	tables.clear();
+	tables.reserve(getNumberOfTableValues(m_width, m_height));
+	for (size_t i = 0 ; i < dists.size() ; i++)
+	{
+		const double *pTable = dists[i]->getTable();
+		tables.insert(tables.end(), pTable, pTable + DiscreteDistributionFast::getTableSize(sizes[i]));
+	}
+}
+#endif // !OLDTEST
+
 DiscreteDistribution2D::~DiscreteDistribution2D()
 {
 	delete m_pMarginalXDist;
@@ -144,6 +249,16 @@ double DiscreteDistribution2D::pickConditionalOnY(double y) const
 	return x;
 }
 
+bool DiscreteDistribution2D::getBoundingBox(double &xMin, double &xMax, double &yMin, double &yMax) const
+{
+	// All points are picked in the region covered by the grid
+	xMin = std::min(m_xOffset, m_xOffset + m_xSize);
+	xMax = std::max(m_xOffset, m_xOffset + m_xSize);
+	yMin = std::min(m_yOffset, m_yOffset + m_ySize);
+	yMax = std::max(m_yOffset, m_yOffset + m_ySize);
+	return true;
+}
+
 void DiscreteDistribution2D::generateConditionalsAndMarginal(double xOffset, double yOffset, double xSize, double ySize,
 		                                             const GridValues &density, GslRandomNumberGenerator *pRngGen,
 		                                             const Polygon2D &filter, bool transpose,
@@ -6,6 +6,8 @@
 #include "discretedistribution.h"
 #include "discretedistributionfast.h"
 #include "polygon2d.h"
+#include "booltype.h"
+#include <stdio.h>
 #include <vector>
 
 class GridValues;
@@ -19,6 +21,13 @@ public:
 			       const GridValues &density, bool floor, GslRandomNumberGenerator *pRngGen,
 			       const Polygon2D &filter = Polygon2D()
 			       );
+#ifndef OLDTEST
+	// Uses tables that were stored using writeTables, for a density of the specified number
+	// of pixels; these are not copied and must remain valid while this instance is used
+	DiscreteDistribution2D(double xOffset, double yOffset, double xSize, double ySize,
+			       int width, int height, bool flippedY, const double *pTables, size_t numTableValues,
+			       bool floor, GslRandomNumberGenerator *pRngGen);
+#endif // !OLDTEST
 	~DiscreteDistribution2D();
 
 	Point2D pickPoint() const;
@@ -33,9 +42,24 @@ public:
 	double getXSize() const									{ return m_xSize; }
 	double getYSize() const									{ return m_ySize; }
 
+	bool getBoundingBox(double &xMin, double &xMax, double &yMin, double &yMax) const;
+
 	bool isYFlipped() const									{ return m_flippedY; }
 	bool getFloor() const									{ return m_floor; }
+
+	int getPixelWidth() const								{ return m_width; }
+	int getPixelHeight() const								{ return m_height; }
+#ifndef OLDTEST
+	// The number of doubles that writeTables stores for a density of this size
+	static size_t getNumberOfTableValues(int width, int height);
+	bool_t writeTables(FILE *pFile) const;
+	// Stores the same values as writeTables
+	void getTables(std::vector<double> &tables) const;
+#endif // !OLDTEST
 private:
+#ifndef OLDTEST
+	void getTableDistributions(std::vector<const DiscreteDistributionFast *> &dists, std::vector<int> &sizes) const;
+#endif // !OLDTEST
 	static void generateConditionalsAndMarginal(double xOffset, double yOffset, double xSize, double ySize,
 		                                             const GridValues &density, GslRandomNumberGenerator *pRngGen,
 		                                             const Polygon2D &filter, bool transpose,
@@ -0,0 +1,348 @@
+#include "discretedistribution2dcompact.h"
+#include "gridvalues.h"
+#include "gslrandomnumbergenerator.h"
+#include "util.h"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+DiscreteDistribution2DCompact::DiscreteDistribution2DCompact(double xOffset, double yOffset, double xSize, double ySize,
+			       		                     const GridValues &density, bool floor, GslRandomNumberGenerator *pRngGen)
+	: ProbabilityDistribution2D(pRngGen, true)
+{
+	m_pColumns = 0;
+	m_xSize = xSize;
+	m_ySize = ySize;
+	m_xOffset = xOffset;
+	m_yOffset = yOffset;
+
+	m_width = density.getWidth();
+	m_height = density.getHeight();
+
+	m_rows.build(density, false);
+
+	if (m_rows.getNumberOfUsedLines() == 0)
+		abortWithMessage("No non-zero value found in DiscreteDistribution2DCompact. Bad data file.");
+
+	m_flippedY = density.isYFlipped();
+	m_floor = floor;
+
+	cerr << "# Compact 2D discrete distribution: " << m_rows.getNumberOfUsedLines() << " of " << m_height 
+	     << " rows are used, tables need " << (double)getMemoryUsage()/(1024.0*1024.0) << " MB" << endl;
+}
+
+DiscreteDistribution2DCompact::~DiscreteDistribution2DCompact()
+{
+	delete m_pColumns;
+}
+
+Point2D DiscreteDistribution2DCompact::pickPoint() const
+{
+	GslRandomNumberGenerator *pRndGen = getRandomNumberGenerator();
+	double y = m_rows.pickLine(pRndGen);
+	int yi = (int)y;
+	assert(yi >= 0 && yi < m_height);
+
+	double x = m_rows.pickInLine(yi, pRndGen);
+
+	return Point2D(toX(x), toY(y));
+}
+
+double DiscreteDistribution2DCompact::pickMarginalX() const
+{
+	return toX(getColumns().pickLine(getRandomNumberGenerator()));
+}
+
+double DiscreteDistribution2DCompact::pickMarginalY() const
+{
+	return toY(m_rows.pickLine(getRandomNumberGenerator()));
+}
+
+double DiscreteDistribution2DCompact::pickConditionalOnX(double x) const
+{
+	x = (x - m_xOffset)/m_xSize * (double)m_width;
+
+	int xi = (int)x;
+	if (xi < 0 || xi >= m_width)
+		return numeric_limits<double>::quiet_NaN();
+
+	return toY(getColumns().pickInLine(xi, getRandomNumberGenerator()));
+}
+
+double DiscreteDistribution2DCompact::pickConditionalOnY(double y) const
+{
+	y = (y - m_yOffset)/m_ySize * (double)m_height;
+
+	int yi = (int)y;
+	if (yi < 0 || yi >= m_height)
+		return numeric_limits<double>::quiet_NaN();
+
+	return toX(m_rows.pickInLine(yi, getRandomNumberGenerator()));
+}
+
+bool DiscreteDistribution2DCompact::getBoundingBox(double &xMin, double &xMax, double &yMin, double &yMax) const
+{
+	// All points are picked in the region covered by the grid
+	xMin = std::min(m_xOffset, m_xOffset + m_xSize);
+	xMax = std::max(m_xOffset, m_xOffset + m_xSize);
+	yMin = std::min(m_yOffset, m_yOffset + m_ySize);
+	yMax = std::max(m_yOffset, m_yOffset + m_ySize);
+	return true;
+}
+
+size_t DiscreteDistribution2DCompact::getMemoryUsage() const
+{
+	size_t s = m_rows.getMemoryUsage();
+
+	m_columnsMutex.lock();
+	if (m_pColumns)
+		s += m_pColumns->getMemoryUsage();
+	m_columnsMutex.unlock();
+
+	return s;
+}
+
+const DiscreteDistribution2DCompact::Lines &DiscreteDistribution2DCompact::getColumns() const
+{
+	m_columnsMutex.lock();
+	if (!m_pColumns)
+	{
+		Lines *pColumns = new Lines();
+		pColumns->buildTransposed(m_rows, m_width);
+		m_pColumns = pColumns;
+
+		cerr << "# Compact 2D discrete distribution: built tables for " << m_pColumns->getNumberOfUsedLines() << " of " 
+		     << m_width << " columns, using " << (double)m_pColumns->getMemoryUsage()/(1024.0*1024.0) << " MB" << endl;
+	}
+	m_columnsMutex.unlock();
+
+	return *m_pColumns;
+}
+
+// Same conversions as in DiscreteDistribution2D
+inline double DiscreteDistribution2DCompact::toX(double x) const
+{
+	x = (x/(double)m_width)*m_xSize;
+
+	// If we want to floor it, we calculate that here
+	if (m_floor)
+	{
+		double xBinSize = m_xSize/(double)m_width;
+		x = ((int)(x/xBinSize))*xBinSize;
+	}
+	
+	x += m_xOffset;
+	return x;
+}
+
+inline double DiscreteDistribution2DCompact::toY(double y) const
+{
+	y = (y/(double)m_height)*m_ySize;
+	
+	// If we want to floor it, we calculate that here
+	if (m_floor)
+	{
+		double yBinSize = m_ySize/(double)m_height;
+		y = ((int)(y/yBinSize))*yBinSize;
+	}
+
+	y += m_yOffset;
+	return y;
+}
+
+// The values are processed twice: first to know how much memory the tables will
+// need, so that no more than that is allocated
+void DiscreteDistribution2DCompact::Lines::build(const GridValues &density, bool columns)
+{
+	const int numLines = (columns)?density.getWidth():density.getHeight();
+	const int lineLength = (columns)?density.getHeight():density.getWidth();
+	vector<double> values(lineLength);
+	size_t total = 0;
+
+	for (int pass = 0 ; pass < 2 ; pass++)
+	{
+		for (int l = 0 ; l < numLines ; l++)
+		{
+			for (int i = 0 ; i < lineLength ; i++)
+			{
+				double val = (columns)?density.getValue(l, i):density.getValue(i, l);
+				assert(val >= 0);
+				values[i] = val;
+			}
+
+			if (pass == 0)
+				total += getNonZeroCount(values);
+			else
+				addLine(values);
+		}
+
+		if (pass == 0)
+			reserve(numLines, total);
+	}
+}
+
+// Retrieves the values from the cumulative sums of the other lines
+void DiscreteDistribution2DCompact::Lines::buildTransposed(const Lines &src, int lineLength)
+{
+	const int numLines = lineLength;
+	const int srcLines = src.getNumberOfLines();
+	vector<double> values(srcLines);
+	size_t total = 0;
+
+	for (int pass = 0 ; pass < 2 ; pass++)
+	{
+		for (int l = 0 ; l < numLines ; l++)
+		{
+			for (int i = 0 ; i < srcLines ; i++)
+				values[i] = src.getValue(i, l);
+
+			if (pass == 0)
+				total += getNonZeroCount(values);
+			else
+				addLine(values);
+		}
+
+		if (pass == 0)
+			reserve(numLines, total);
+	}
+}
+
+void DiscreteDistribution2DCompact::Lines::reserve(int numLines, size_t numValues)
+{
+	m_marginal.reserve(numLines);
+	m_lineStart.reserve(numLines);
+	m_lineFirst.reserve(numLines);
+	m_lineCount.reserve(numLines);
+	m_cumulative.reserve(numValues);
+}
+
+void DiscreteDistribution2DCompact::Lines::getNonZeroRange(const vector<double> &values, int &first, int &last)
+{
+	const int num = (int)values.size();
+
+	first = 0;
+	last = num-1;
+
+	while (first < num && values[first] == 0)
+		first++;
+	while (last >= first && values[last] == 0)
+		last--;
+}
+
+size_t DiscreteDistribution2DCompact::Lines::getNonZeroCount(const vector<double> &values)
+{
+	int first, last;
+
+	getNonZeroRange(values, first, last);
+	return (first > last)?0:(size_t)(last-first+1);
+}
+
+void DiscreteDistribution2DCompact::Lines::addLine(const vector<double> &values)
+{
+	int first, last;
+
+	getNonZeroRange(values, first, last);
+
+	double prevTotal = (m_marginal.size() == 0)?0:m_marginal.back();
+
+	if (first > last) // only zeros
+	{
+		m_lineStart.push_back(-1);
+		m_lineFirst.push_back(0);
+		m_lineCount.push_back(0);
+		m_marginal.push_back(prevTotal);
+		return;
+	}
+
+	const int count = last-first+1;
+
+	m_lineStart.push_back((int)m_cumulative.size());
+	m_lineFirst.push_back(first);
+	m_lineCount.push_back(count);
+
+	double sum = 0;
+	for (int i = first ; i <= last ; i++)
+	{
+		sum += values[i];
+		m_cumulative.push_back((float)sum);
+	}
+
+	// Use the sum as it is stored, so that the row total is consistent with the table
+	m_marginal.push_back(prevTotal + (double)m_cumulative.back());
+}
+
+int DiscreteDistribution2DCompact::Lines::getNumberOfUsedLines() const
+{
+	int count = 0;
+	for (size_t i = 0 ; i < m_lineStart.size() ; i++)
+	{
+		if (m_lineStart[i] >= 0)
+			count++;
+	}
+	return count;
+}
+
+size_t DiscreteDistribution2DCompact::Lines::getMemoryUsage() const
+{
+	return m_marginal.capacity()*sizeof(double) + m_cumulative.capacity()*sizeof(float) +
+	       (m_lineStart.capacity() + m_lineFirst.capacity() + m_lineCount.capacity())*sizeof(int);
+}
+
+double DiscreteDistribution2DCompact::Lines::getValue(int line, int pos) const
+{
+	assert(line >= 0 && line < getNumberOfLines());
+
+	int start = m_lineStart[line];
+	int idx = pos - m_lineFirst[line];
+
+	if (start < 0 || idx < 0 || idx >= m_lineCount[line])
+		return 0;
+
+	double v = m_cumulative[start+idx];
+	if (idx > 0)
+		v -= m_cumulative[start+idx-1];
+
+	return std::max(v, 0.0);
+}
+
+// A bin is selected in the same way as in DiscreteDistributionFast: it's the
+// first one for which the cumulative sum is larger than the picked value
+double DiscreteDistribution2DCompact::Lines::pickLine(GslRandomNumberGenerator *pRng) const
+{
+	assert(m_marginal.size() > 0);
+
+	double x = pRng->pickRandomDouble() * m_marginal.back();
+
+	vector<double>::const_iterator it = upper_bound(m_marginal.begin(), m_marginal.end(), x);
+	if (it == m_marginal.end()) // can only happen due to round-off, use the last non-empty bin
+		it = lower_bound(m_marginal.begin(), m_marginal.end(), m_marginal.back());
+
+	int bin = (int)(it - m_marginal.begin());
+	double d = (bin > 0)?m_marginal[bin-1]:0;
+
+	return (double)bin + (x-d)/(m_marginal[bin]-d);
+}
+
+double DiscreteDistribution2DCompact::Lines::pickInLine(int line, GslRandomNumberGenerator *pRng) const
+{
+	assert(line >= 0 && line < getNumberOfLines());
+
+	int start = m_lineStart[line];
+	if (start < 0)
+		return numeric_limits<double>::quiet_NaN();
+
+	const float *pStart = &(m_cumulative[start]);
+	const float *pEnd = pStart + m_lineCount[line];
+	double x = pRng->pickRandomDouble() * (double)pEnd[-1];
+
+	const float *pBin = upper_bound(pStart, pEnd, x);
+	if (pBin == pEnd) // can only happen due to round-off, use the last non-empty bin
+		pBin = lower_bound(pStart, pEnd, pEnd[-1]);
+
+	double d = (pBin != pStart)?(double)pBin[-1]:0;
+	double pos = (double)(pBin - pStart) + (x-d)/((double)pBin[0]-d);
+
+	return pos + (double)m_lineFirst[line];
+}
@@ -0,0 +1,91 @@
+#ifndef DISCRETEDISTRIBUTION2DCOMPACT_H
+
+#define DISCRETEDISTRIBUTION2DCOMPACT_H
+
+#include "probabilitydistribution2d.h"
+#include "mutex.h"
+#include <vector>
+
+class GridValues;
+class GslRandomNumberGenerator;
+
+// A variant of DiscreteDistribution2D that needs far less memory for large grids
+// that contain many zeros. For each row, the cumulative sums are only stored for
+// the part between the first and the last non-zero value, as floats, and rows that
+// only contain zeros are not stored at all. The tables for the columns are only
+// needed by pickMarginalX and pickConditionalOnX, and are only built (from the
+// row tables) when one of these is used for the first time.
+// Because of the float precision, values that are very small compared to the sum
+// of a row will be picked slightly less accurately than with DiscreteDistribution2D.
+class DiscreteDistribution2DCompact : public ProbabilityDistribution2D
+{
+public:
+	DiscreteDistribution2DCompact(double xOffset, double yOffset, double xSize, double ySize,
+			              const GridValues &density, bool floor, GslRandomNumberGenerator *pRngGen);
+	~DiscreteDistribution2DCompact();
+
+	Point2D pickPoint() const;
+
+	double pickMarginalX() const;
+	double pickMarginalY() const;
+	double pickConditionalOnX(double x) const;
+	double pickConditionalOnY(double y) const;
+
+	double getXOffset() const								{ return m_xOffset; }
+	double getYOffset() const								{ return m_yOffset; }
+	double getXSize() const									{ return m_xSize; }
+	double getYSize() const									{ return m_ySize; }
+
+	bool getBoundingBox(double &xMin, double &xMax, double &yMin, double &yMax) const;
+
+	bool isYFlipped() const									{ return m_flippedY; }
+	bool getFloor() const									{ return m_floor; }
+
+	// Number of bytes used by the tables that have been built so far
+	size_t getMemoryUsage() const;
+private:
+	// The tables for either the rows or the columns of the grid: the marginal
+	// distribution over these lines, and the distribution within each line
+	class Lines
+	{
+	public:
+		Lines()											{ }
+
+		void build(const GridValues &density, bool columns);
+		void buildTransposed(const Lines &src, int lineLength);
+
+		int getNumberOfLines() const								{ return (int)m_lineStart.size(); }
+		int getNumberOfUsedLines() const;
+		size_t getMemoryUsage() const;
+
+		// These return the position, including the fraction within a bin
+		double pickLine(GslRandomNumberGenerator *pRng) const;
+		double pickInLine(int line, GslRandomNumberGenerator *pRng) const;
+	private:
+		static void getNonZeroRange(const std::vector<double> &values, int &first, int &last);
+		static size_t getNonZeroCount(const std::vector<double> &values);
+		void reserve(int numLines, size_t numValues);
+		void addLine(const std::vector<double> &values);
+		double getValue(int line, int pos) const;
+
+		std::vector<double> m_marginal; // cumulative
+		std::vector<int> m_lineStart, m_lineFirst, m_lineCount;
+		std::vector<float> m_cumulative;
+	};
+
+	const Lines &getColumns() const;
+	double toX(double x) const;
+	double toY(double y) const;
+
+	Lines m_rows;
+	mutable Lines *m_pColumns;
+	mutable Mutex m_columnsMutex;
+
+	double m_xOffset, m_yOffset;
+	double m_xSize, m_ySize;
+	int m_width, m_height; // discrete size (pixels)
+	bool m_flippedY;
+	bool m_floor;
+};
+
+#endif // DISCRETEDISTRIBUTION2DCOMPACT_H
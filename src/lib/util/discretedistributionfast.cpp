@@ -11,54 +11,64 @@ DiscreteDistributionFast::DiscreteDistributionFast(double xMin, double xMax, con
 
 	assert(probValues.size() > 0);
 
-	int levels = 0;
-	const int largerSize = getLargerPowerOfTwo(probValues.size(), &levels);
-	assert(largerSize >= (int)probValues.size());
+	m_numLevels = getNumberOfLevels((int)probValues.size());
+	m_tableStorage.resize(getTableSize((int)probValues.size()));
 
-	m_probLevels.resize(levels); // last level still should have two entries
-	for (size_t i = 0, s = 2 ; i < m_probLevels.size() ; i++, s *= 2)
-		m_probLevels[i].resize(s);
+	// Initialize the lowest level
+	const int largerSize = 1<<m_numLevels;
+	assert(largerSize >= (int)probValues.size());
 
-	assert((int)m_probLevels[m_probLevels.size()-1].size() == largerSize);
+	double *pLevel = &(m_tableStorage[m_tableStorage.size() - largerSize]);
 
-	// Initialize the lowest level
 	m_totalSum = 0;
-	int levelIdx = (int)m_probLevels.size()-1;
-	int levelSize = (int)m_probLevels[levelIdx].size();
 	for (size_t i = 0 ; i < probValues.size() ; i++)
 	{
 		m_totalSum += probValues[i];
-		m_probLevels[levelIdx][i] = m_totalSum;
+		pLevel[i] = m_totalSum;
 	}
-	for (size_t i = probValues.size() ; i < m_probLevels[levelIdx].size() ; i++)
-		m_probLevels[levelIdx][i] = m_totalSum;
+	for (int i = (int)probValues.size() ; i < largerSize ; i++)
+		pLevel[i] = m_totalSum;
 	
 	// Initialize the other levels
-	levelIdx--;
-
-	while (levelIdx >= 0)
+	for (int levelSize = largerSize/2 ; levelSize >= 2 ; levelSize /= 2)
 	{
-		levelSize = m_probLevels[levelIdx].size();
-		for (int i = 0 ; i < levelSize ; i++)
-			m_probLevels[levelIdx][i] = m_probLevels[levelIdx+1][i*2+1];
+		double *pNextLevel = pLevel;
+		pLevel -= levelSize;
 
-		levelIdx--;
+		for (int i = 0 ; i < levelSize ; i++)
+			pLevel[i] = pNextLevel[i*2+1];
 	}
+	assert(pLevel == &(m_tableStorage[0]));
 
+	m_pTable = &(m_tableStorage[0]);
 	m_xMin = xMin;
 	m_binSize = (xMax-xMin)/(double)probValues.size();
 
 	// Just for logging
 	/*
-	for (int l = 0 ; l < m_probLevels.size() ; l++)
+	for (int l = 0, s = 2, pos = 0 ; l < m_numLevels ; l++, pos += s, s *= 2)
 	{
-		for (int i = 0 ; i < m_probLevels[l].size() ; i++)
-			cout << m_probLevels[l][i] << "\t";
+		for (int i = 0 ; i < s ; i++)
+			cout << m_pTable[pos+i] << "\t";
 		cout << endl;
 	}
 	*/
 }
 
+DiscreteDistributionFast::DiscreteDistributionFast(double xMin, double xMax, int numValues, const double *pTable,
+                                                   bool floor, GslRandomNumberGenerator *pRndGen) : ProbabilityDistribution(pRndGen)
+{
+	assert(numValues > 0);
+	assert(pTable != 0);
+
+	m_floor = floor;
+	m_numLevels = getNumberOfLevels(numValues);
+	m_pTable = pTable;
+	m_totalSum = pTable[getTableSize(numValues)-1];
+	m_xMin = xMin;
+	m_binSize = (xMax-xMin)/(double)numValues;
+}
+
 DiscreteDistributionFast::~DiscreteDistributionFast()
 {
 }
@@ -69,35 +79,38 @@ double DiscreteDistributionFast::pickNumber() const
 	double x = pRndGen->pickRandomDouble() * m_totalSum;
 	//cout << "x = " << x << endl;
 
-	const int numLevels = m_probLevels.size();
+	const int numLevels = m_numLevels;
 	int levelPos = 0;
+	int levelStart = 0;
 	for (int l = 0 ; l < numLevels-1 ; l++)
 	{
-	//	cout << "comparing to " << l << "," << levelPos << " = " << m_probLevels[l][levelPos] << endl;
-		if (m_probLevels[l][levelPos] < x)
+	//	cout << "comparing to " << l << "," << levelPos << " = " << m_pTable[levelStart+levelPos] << endl;
+		if (m_pTable[levelStart+levelPos] < x)
 			levelPos = levelPos*2 + 2;
 		else
 			levelPos = levelPos*2;
+
+		levelStart += (2<<l); // size of level l
 	}
 	
-	const int lastLevel = numLevels-1;
+	const double *pLastLevel = m_pTable + levelStart;
 	int foundBin;
 
-	//cout << "comparing to " << (numLevels-1) << "," << levelPos << " = " << m_probLevels[numLevels-1][levelPos] << endl;
-	if (m_probLevels[lastLevel][levelPos] < x)
+	//cout << "comparing to " << (numLevels-1) << "," << levelPos << " = " << pLastLevel[levelPos] << endl;
+	if (pLastLevel[levelPos] < x)
 		foundBin = levelPos+1;
 	else
 		foundBin = levelPos;
 	
-	assert(foundBin >= 0 && foundBin < (int)m_probLevels[lastLevel].size());
-	assert(x < m_probLevels[lastLevel][foundBin] && (foundBin == 0 || x >= m_probLevels[lastLevel][foundBin-1]));
+	assert(foundBin >= 0 && foundBin < (1<<numLevels));
+	assert(x < pLastLevel[foundBin] && (foundBin == 0 || x >= pLastLevel[foundBin-1]));
 
 	//cout << "x = " << x << " foundBin = " << foundBin << endl;
 	double d = 0;
 	if (foundBin > 0)
-		d = m_probLevels[lastLevel][foundBin-1];
+		d = pLastLevel[foundBin-1];
 	
-	double binFrac = (x-d)/(m_probLevels[lastLevel][foundBin]-d);
+	double binFrac = (x-d)/(pLastLevel[foundBin]-d);
 	double binPos = (double)foundBin;
 	
 	if (!m_floor)
@@ -106,6 +119,23 @@ double DiscreteDistributionFast::pickNumber() const
 	return binPos*m_binSize + m_xMin;
 }
 
+// The last level should still have at least two entries
+int DiscreteDistributionFast::getNumberOfLevels(int numValues)
+{
+	int levels = 0;
+	getLargerPowerOfTwo(numValues, &levels);
+	if (levels < 1)
+		levels = 1;
+	return levels;
+}
+
+// Level l contains 2^(l+1) entries
+int DiscreteDistributionFast::getTableSize(int numValues)
+{
+	int levels = getNumberOfLevels(numValues);
+	return (2<<levels) - 2;
+}
+
 int DiscreteDistributionFast::getLargerPowerOfTwo(const int s0, int *pLevels)
 {
 	assert(pLevels != 0);
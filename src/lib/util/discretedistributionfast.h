@@ -5,18 +5,31 @@
 #include "probabilitydistribution.h"
 #include <vector>
 
+// The levels of the search tree are stored one after the other in a single table,
+// starting with the level containing two entries. This way the table can also be
+// stored elsewhere, e.g. in a memory mapped file (see DiscreteDistribution2D).
 class DiscreteDistributionFast : public ProbabilityDistribution
 {
 public:
 	DiscreteDistributionFast(double xMin, double xMax, const std::vector<double> &probValues, 
 	                         bool floor, GslRandomNumberGenerator *pRndGen);
+	// Uses a table that was obtained using getTable for the same number of values; the
+	// table is not copied and must remain valid while this instance is used
+	DiscreteDistributionFast(double xMin, double xMax, int numValues, const double *pTable,
+	                         bool floor, GslRandomNumberGenerator *pRndGen);
 	~DiscreteDistributionFast();
 
 	double pickNumber() const;
+
+	const double *getTable() const									{ return m_pTable; }
+	static int getTableSize(int numValues);
 private:
 	static int getLargerPowerOfTwo(const int s0, int *pLevels);
+	static int getNumberOfLevels(int numValues);
 
-	std::vector<std::vector<double> > m_probLevels;
+	std::vector<double> m_tableStorage;
+	const double *m_pTable;
+	int m_numLevels;
 	double m_totalSum, m_xMin, m_binSize;
 	bool m_floor;
 };
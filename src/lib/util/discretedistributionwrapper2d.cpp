@@ -1,28 +1,147 @@
 #include "discretedistributionwrapper2d.h"
 #include "tiffdensityfile.h"
 #include "gridvaluescsv.h"
+#include "discretedistribution2dcompact.h"
 #include "util.h"
 #include <memory>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#ifndef WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#define getpid _getpid
+#endif // !WIN32
 
 using namespace std;
 
+// Header of the cache file, followed by the tables of DiscreteDistribution2D::writeTables.
+// The size and modification time of the density and mask files are stored to detect
+// changes in these files; the marker value detects a different floating point format.
+struct DiscreteDistribution2DCacheHeader
+{
+	char m_identifier[8];
+	int32_t m_version;
+	int32_t m_flipY;
+	int32_t m_width, m_height;
+	int64_t m_densSize, m_densTime;
+	int64_t m_maskSize, m_maskTime;
+	double m_marker;
+};
+
+#define DISCRETEDISTRIBUTIONWRAPPER2D_CACHEID		"SIMPDD2C"
+#define DISCRETEDISTRIBUTIONWRAPPER2D_CACHEVERSION	1
+#define DISCRETEDISTRIBUTIONWRAPPER2D_CACHEMARKER	1234.5678
+
+static void fillCacheHeader(DiscreteDistribution2DCacheHeader &hdr, const string &densFile, const string &maskFile,
+		                    bool flipY, int width, int height)
+{
+	memset(&hdr, 0, sizeof(DiscreteDistribution2DCacheHeader));
+	memcpy(hdr.m_identifier, DISCRETEDISTRIBUTIONWRAPPER2D_CACHEID, sizeof(hdr.m_identifier));
+	hdr.m_version = DISCRETEDISTRIBUTIONWRAPPER2D_CACHEVERSION;
+	hdr.m_flipY = (flipY)?1:0;
+	hdr.m_width = width;
+	hdr.m_height = height;
+	hdr.m_marker = DISCRETEDISTRIBUTIONWRAPPER2D_CACHEMARKER;
+
+	struct stat st;
+	if (stat(densFile.c_str(), &st) == 0)
+	{
+		hdr.m_densSize = (int64_t)st.st_size;
+		hdr.m_densTime = (int64_t)st.st_mtime;
+	}
+	if (maskFile.length() > 0 && stat(maskFile.c_str(), &st) == 0)
+	{
+		hdr.m_maskSize = (int64_t)st.st_size;
+		hdr.m_maskTime = (int64_t)st.st_mtime;
+	}
+}
+
+// Identifies the tables that are built for a density and mask file; as for the cache
+// file, the size and modification time are used to detect changes in these files
+static string getSharedTablesKey(const string &densFile, const string &maskFile, bool flipY)
+{
+	DiscreteDistribution2DCacheHeader hdr;
+	fillCacheHeader(hdr, densFile, maskFile, flipY, 0, 0);
+
+	return densFile + "\n" + maskFile + "\n" + strprintf("%d,%lld,%lld,%lld,%lld", (int)hdr.m_flipY, 
+			(long long)hdr.m_densSize, (long long)hdr.m_densTime, (long long)hdr.m_maskSize, (long long)hdr.m_maskTime);
+}
+
+map<string, shared_ptr<const DiscreteDistributionWrapper2D::SharedTables> > DiscreteDistributionWrapper2D::s_sharedTables;
+Mutex DiscreteDistributionWrapper2D::s_sharedTablesMutex;
+
 DiscreteDistributionWrapper2D::DiscreteDistributionWrapper2D(GslRandomNumberGenerator *pRndGen) : ProbabilityDistribution2D(pRndGen, true)
 {
 	m_pDist = 0;
+	m_pCacheFile = 0;
+	m_compact = false;
 }
 
 DiscreteDistributionWrapper2D::~DiscreteDistributionWrapper2D()
 {
 	delete m_pDist;
+	delete m_pCacheFile; // the tables can be in here, so only delete this after m_pDist
 }
 
 bool_t DiscreteDistributionWrapper2D::init(const std::string &densFile, const std::string &maskFile, 
 		                                   double xOffset, double yOffset, double width, double height, 
-										   bool flipY, bool floor)
+										   bool flipY, bool floor, const std::string &cacheFile, bool compact)
 {
 	if (m_pDist)
 		return "Already initialized";
 
+	bool_t r;
+
+	if (compact)
+	{
+		if (cacheFile.length() > 0)
+			return "A cache file can't be used together with the compact storage of the distribution";
+
+		if (!(r = buildDistribution(densFile, maskFile, xOffset, yOffset, width, height, flipY, floor, true)))
+			return r;
+	}
+	else
+	{
+
+#ifndef OLDTEST
+		// Several simulations can be initialized at the same time, which then need
+		// to wait until the first one has built the tables (and written the cache)
+		s_sharedTablesMutex.lock();
+		r = initSharedTables(densFile, maskFile, xOffset, yOffset, width, height, flipY, floor, cacheFile);
+		s_sharedTablesMutex.unlock();
+
+		if (!r)
+			return r;
+#else
+		if (cacheFile.length() > 0)
+			return "Using a cache file is not supported in this version";
+
+		if (!(r = buildDistribution(densFile, maskFile, xOffset, yOffset, width, height, flipY, floor, false)))
+			return r;
+#endif // !OLDTEST
+	}
+
+	m_densFileName = densFile;
+	m_maskFileName = maskFile;
+	m_cacheFileName = cacheFile;
+	m_xOffset = xOffset;
+	m_yOffset = yOffset;
+	m_xSize = width;
+	m_ySize = height;
+	m_flipY = flipY;
+	m_floor = floor;
+	m_compact = compact;
+
+	return true;
+}
+
+bool_t DiscreteDistributionWrapper2D::buildDistribution(const std::string &densFile, const std::string &maskFile, 
+		                                   double xOffset, double yOffset, double width, double height, 
+										   bool flipY, bool floor, bool compact)
+{
 	GridValues *pDens = 0;
 	GridValues *pMask = 0;
 	bool_t r;
@@ -68,19 +187,137 @@ bool_t DiscreteDistributionWrapper2D::init(const std::string &densFile, const st
 		}
 	}
 
-	m_pDist = new DiscreteDistribution2D(xOffset, yOffset, width, height, *pDens, floor, getRandomNumberGenerator());
+	if (compact)
+		m_pDist = new DiscreteDistribution2DCompact(xOffset, yOffset, width, height, *pDens, floor, getRandomNumberGenerator());
+	else
+		m_pDist = new DiscreteDistribution2D(xOffset, yOffset, width, height, *pDens, floor, getRandomNumberGenerator());
+	return true;
+}
 
-	m_densFileName = densFile;
-	m_maskFileName = maskFile;
-	m_xOffset = xOffset;
-	m_yOffset = yOffset;
-	m_xSize = width;
-	m_ySize = height;
-	m_flipY = flipY;
-	m_floor = floor;
+#ifndef OLDTEST
+bool_t DiscreteDistributionWrapper2D::initSharedTables(const std::string &densFile, const std::string &maskFile, 
+		                                   double xOffset, double yOffset, double width, double height, 
+										   bool flipY, bool floor, const std::string &cacheFile)
+{
+	string key = getSharedTablesKey(densFile, maskFile, flipY);
+	auto it = s_sharedTables.find(key);
+	bool_t r;
+
+	if (it == s_sharedTables.end())
+	{
+		// The memory of a cache file is already shared by the operating system
+		if (cacheFile.length() > 0 && loadCache(cacheFile, densFile, maskFile, xOffset, yOffset, width, height, flipY, floor))
+			return true;
+
+		// If the cache file can't be used, we'll just build the tables and try to (re)create the cache
+		if (!(r = buildDistribution(densFile, maskFile, xOffset, yOffset, width, height, flipY, floor, false)))
+			return r;
+
+		if (cacheFile.length() > 0)
+		{
+			if (!(r = writeCache(cacheFile, densFile, maskFile, flipY)))
+				return "Unable to write cache file '" + cacheFile + "': " + r.getErrorString();
+		}
+
+		const DiscreteDistribution2D *pDist = dynamic_cast<const DiscreteDistribution2D *>(m_pDist);
+		assert(pDist);
+
+		SharedTables *pTables = new SharedTables();
+		pTables->m_width = pDist->getPixelWidth();
+		pTables->m_height = pDist->getPixelHeight();
+		pDist->getTables(pTables->m_tables);
+
+		delete m_pDist;
+		m_pDist = 0;
+
+		it = s_sharedTables.insert(make_pair(key, shared_ptr<const SharedTables>(pTables))).first;
+	}
+
+	m_sharedTables = it->second;
+	m_pDist = new DiscreteDistribution2D(xOffset, yOffset, width, height, m_sharedTables->m_width, m_sharedTables->m_height, flipY,
+			                             &(m_sharedTables->m_tables[0]), m_sharedTables->m_tables.size(), floor, getRandomNumberGenerator());
+	return true;
+}
+
+bool_t DiscreteDistributionWrapper2D::loadCache(const std::string &cacheFile, const std::string &densFile, const std::string &maskFile,
+		                                        double xOffset, double yOffset, double width, double height, bool flipY, bool floor)
+{
+	assert(m_pDist == 0 && m_pCacheFile == 0);
 
+	MemoryMappedFile *pFile = new MemoryMappedFile();
+	unique_ptr<MemoryMappedFile> p(pFile);
+	bool_t r;
+
+	if (!(r = pFile->open(cacheFile)))
+		return r;
+
+	const size_t hdrSize = sizeof(DiscreteDistribution2DCacheHeader);
+	if (pFile->getSize() < hdrSize)
+		return "Cache file is too small";
+
+	const DiscreteDistribution2DCacheHeader *pHdr = (const DiscreteDistribution2DCacheHeader *)pFile->getData();
+	DiscreteDistribution2DCacheHeader expected;
+
+	fillCacheHeader(expected, densFile, maskFile, flipY, pHdr->m_width, pHdr->m_height);
+	if (memcmp(pHdr, &expected, hdrSize) != 0)
+		return "Cache file is for different input files or has a different format";
+
+	if (pHdr->m_width <= 0 || pHdr->m_height <= 0)
+		return "Invalid dimensions in cache file";
+
+	size_t numValues = DiscreteDistribution2D::getNumberOfTableValues(pHdr->m_width, pHdr->m_height);
+	if (pFile->getSize() != hdrSize + numValues*sizeof(double))
+		return "Size of cache file does not match the dimensions it contains";
+
+	const double *pTables = (const double *)((const char *)pFile->getData() + hdrSize);
+
+	m_pDist = new DiscreteDistribution2D(xOffset, yOffset, width, height, pHdr->m_width, pHdr->m_height, flipY,
+			                             pTables, numValues, floor, getRandomNumberGenerator());
+	m_pCacheFile = p.release();
+	return true;
+}
+
+// The file is first written under a temporary name and then renamed, so that
+// simulations that are started at the same time never see an incomplete file
+bool_t DiscreteDistributionWrapper2D::writeCache(const std::string &cacheFile, const std::string &densFile, const std::string &maskFile, bool flipY)
+{
+	const DiscreteDistribution2D *pDist = dynamic_cast<const DiscreteDistribution2D *>(m_pDist);
+	assert(pDist);
+
+	DiscreteDistribution2DCacheHeader hdr;
+	fillCacheHeader(hdr, densFile, maskFile, flipY, pDist->getPixelWidth(), pDist->getPixelHeight());
+
+	string tmpFile = cacheFile + strprintf(".tmp%d", (int)getpid());
+	FILE *pFile = fopen(tmpFile.c_str(), "wb");
+	if (!pFile)
+		return "Unable to create '" + tmpFile + "'";
+
+	bool_t r = true;
+	if (fwrite(&hdr, sizeof(DiscreteDistribution2DCacheHeader), 1, pFile) != 1)
+		r = "Unable to write header";
+	else
+		r = pDist->writeTables(pFile);
+
+	if (fclose(pFile) != 0 && r)
+		r = "Error closing file";
+
+	if (!r)
+	{
+		remove(tmpFile.c_str());
+		return r;
+	}
+
+#ifdef WIN32
+	remove(cacheFile.c_str()); // rename does not replace an existing file here
+#endif // WIN32
+	if (rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+	{
+		remove(tmpFile.c_str());
+		return "Unable to rename '" + tmpFile + "'";
+	}
 	return true;
 }
+#endif // !OLDTEST
 
 bool_t DiscreteDistributionWrapper2D::allocateGridFunction(const std::string &fileName, GridValues **pGf)
 {
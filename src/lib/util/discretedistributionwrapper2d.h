@@ -4,9 +4,14 @@
 
 #include "probabilitydistribution2d.h"
 #include "discretedistribution2d.h"
+#include "memorymappedfile.h"
 #include "booltype.h"
+#include "mutex.h"
 #include <string>
 #include <limits>
+#include <vector>
+#include <map>
+#include <memory>
 
 class DiscreteDistributionWrapper2D : public ProbabilityDistribution2D
 {
@@ -14,31 +19,62 @@ public:
 	DiscreteDistributionWrapper2D(GslRandomNumberGenerator *pRng);
 	~DiscreteDistributionWrapper2D();
 
+	// If cacheFile is not empty, the tables that are built from the density and mask files are
+	// stored in that file, and are used directly (memory mapped) the next time if the density
+	// and mask files have not changed. If compact is true, a DiscreteDistribution2DCompact
+	// is used instead of a DiscreteDistribution2D.
+	//
+	// Otherwise, the tables are shared by all instances in this process that use the same
+	// density and mask files (e.g. by the simulations of an ensemble), so they are only
+	// built once.
 	bool_t init(const std::string &densFile, const std::string &maskFile, double xOffset, double yOffset, 
-			    double width, double height, bool flipY, bool floor);
+			    double width, double height, bool flipY, bool floor, const std::string &cacheFile = "",
+			    bool compact = false);
 
 	Point2D pickPoint() const;
 	double pickMarginalX() const;
 	double pickMarginalY() const;
 	double pickConditionalOnX(double x) const;
 	double pickConditionalOnY(double y) const;
+	bool getBoundingBox(double &xMin, double &xMax, double &yMin, double &yMax) const		{ if (!m_pDist) return false; return m_pDist->getBoundingBox(xMin, xMax, yMin, yMax); }
 
 	std::string getDensFileName() const															{ return m_densFileName; }
 	std::string getMaskFileName() const															{ return m_maskFileName; }
+	std::string getCacheFileName() const														{ return m_cacheFileName; }
 	double getXOffset() const																	{ return m_xOffset; }
 	double getYOffset() const																	{ return m_yOffset; }
 	double getWidth() const																		{ return m_xSize; }
 	double getHeight() const																	{ return m_ySize; }
 	bool isYFlipped() const																		{ return m_flipY; }
 	bool isFloored() const																		{ return m_floor; }
+	bool isCompact() const																		{ return m_compact; }
 private:
+	class SharedTables
+	{
+	public:
+		int m_width, m_height;
+		std::vector<double> m_tables;
+	};
+
 	static bool_t allocateGridFunction(const std::string &fileName, GridValues **pGf);
+	bool_t initSharedTables(const std::string &densFile, const std::string &maskFile, double xOffset, double yOffset, 
+			                double width, double height, bool flipY, bool floor, const std::string &cacheFile);
+	bool_t buildDistribution(const std::string &densFile, const std::string &maskFile, double xOffset, double yOffset, 
+			                 double width, double height, bool flipY, bool floor, bool compact);
+	bool_t loadCache(const std::string &cacheFile, const std::string &densFile, const std::string &maskFile,
+			         double xOffset, double yOffset, double width, double height, bool flipY, bool floor);
+	bool_t writeCache(const std::string &cacheFile, const std::string &densFile, const std::string &maskFile, bool flipY);
 
-	DiscreteDistribution2D *m_pDist;
-	std::string m_densFileName, m_maskFileName;
+	ProbabilityDistribution2D *m_pDist;
+	MemoryMappedFile *m_pCacheFile;
+	std::shared_ptr<const SharedTables> m_sharedTables;
+	std::string m_densFileName, m_maskFileName, m_cacheFileName;
 	double m_xOffset, m_yOffset;
 	double m_xSize, m_ySize;
-	bool m_flipY, m_floor;
+	bool m_flipY, m_floor, m_compact;
+
+	static std::map<std::string, std::shared_ptr<const SharedTables> > s_sharedTables;
+	static Mutex s_sharedTablesMutex;
 };
 
 inline Point2D DiscreteDistributionWrapper2D::pickPoint() const
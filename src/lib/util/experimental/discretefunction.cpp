@@ -12,6 +12,7 @@ DiscreteFunction::DiscreteFunction(double minX, double maxX, const std::vector<d
 	m_yValues = yValues;
 
 	m_binWidth = (maxX-minX)/((double)yValues.size()-1);
+	m_cellScale = 0; // not needed
 }
 
 DiscreteFunction::DiscreteFunction(const std::vector< std::pair<double,double> > &xyValues)
@@ -37,6 +38,24 @@ DiscreteFunction::DiscreteFunction(const std::vector< std::pair<double,double> >
 		assert(xyValues[i+1].first > xyValues[i].first);
 	}
 #endif
+
+	// Build the table that's used to find the right bin, it has twice as many
+	// cells as there are bins
+	int numCells = 2*(num-1);
+	int bin = 0;
+
+	m_cellScale = (double)numCells/(m_maxX-m_minX);
+	m_cellBins.resize(numCells);
+
+	for (int i = 0 ; i < numCells ; i++)
+	{
+		double x = m_minX + (double)i/m_cellScale;
+
+		while (bin < num-2 && x >= xyValues[bin+1].first)
+			bin++;
+
+		m_cellBins[i] = bin;
+	}
 }
 
 DiscreteFunction::~DiscreteFunction()
@@ -29,6 +29,8 @@ private:
 	double m_binWidth;
 	std::vector<double> m_yValues;
 	std::vector<std::pair<double,double> > m_xyValues;
+	std::vector<int> m_cellBins;
+	double m_cellScale;
 };
 
 inline double DiscreteFunction::getFunctionValueFixedBinWidth(double x) const
@@ -53,44 +55,30 @@ inline double DiscreteFunction::getFunctionValueFixedBinWidth(double x) const
 	return y;
 }
 
+// For a variable bin width, a table with cells of equal width tells us in which bin
+// each cell starts, from which only a few steps are needed to find the right bin
 inline double DiscreteFunction::getFunctionValueVariableBinWidth(double x) const
 {
 	int num = m_xyValues.size();
-	int middleBin = num/2;
-	int startBin = 0;
-	int endBin = num-1;
-	bool found = false;
-
-	//std::cout << "Start" << std::endl;
-	while (!found)
-	{
-		//std::cout << startBin << " " << middleBin << " " << endBin << " " << m_xyValues[startBin].first << " " 
-		//	  << m_xyValues[middleBin].first << " " << m_xyValues[endBin].first << " -> " << x << std::endl;
-		if (m_xyValues[startBin].first <= x && x <= m_xyValues[middleBin].first)
-		{
-			// it's in the first half
-			endBin = middleBin;
-		}
-		else if (m_xyValues[middleBin].first <= x && x <= m_xyValues[endBin].first)
-		{
-			// it's in the second half
-			startBin = middleBin;
-		}
-		else // should never happen!
-		{
-			assert(0); 
-			return -123456.7;
-		}
-		
-		middleBin = (startBin+endBin)/2;
-
-		if (startBin+1 == endBin)
-			found = true;
-	}
-
-	//std::cout << "Found: " << x << " " << m_xyValues[startBin].first << " " << m_xyValues[endBin].first << std::endl;
-
-	assert(endBin-startBin == 1);
+	int numCells = m_cellBins.size();
+
+	assert(numCells > 0);
+
+	double pos = (x - m_minX)*m_cellScale;
+	int cell = (pos < (double)numCells) ? (int)pos : numCells-1;
+	if (cell < 0)
+		cell = 0;
+
+	int startBin = m_cellBins[cell];
+
+	// Because of round-off the cell may be off by one
+	while (startBin > 0 && x < m_xyValues[startBin].first)
+		startBin--;
+	while (startBin < num-2 && x > m_xyValues[startBin+1].first)
+		startBin++;
+
+	int endBin = startBin+1;
+
 	assert(endBin < num);
 	assert(startBin >= 0);
 
@@ -0,0 +1,216 @@
+#include "hazardfunctionexpbatch.h"
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+
+// Let the compiler know that the loops below can be vectorized, even though
+// they contain some selects that it might otherwise consider too expensive
+#if !defined(DISABLEOPENMP) && defined(_OPENMP) && _OPENMP >= 201307
+#define HAZARDFUNCTIONEXPBATCH_SIMD _Pragma("omp simd")
+#else
+#define HAZARDFUNCTIONEXPBATCH_SIMD
+#endif
+
+// Same small number as in TimeLimitedHazardFunction, to prevent division by zero
+#define HAZARDFUNCTIONEXPBATCH_SMALLNUMBER 1e-100
+
+void HazardFunctionExpBatch::resize(int num)
+{
+	assert(num >= 0);
+
+	m_size = num;
+	m_buffer.resize(6*(size_t)num + 1); // +1 so that the pointers are always valid
+
+	double *pBase = &(m_buffer[0]);
+
+	m_pA = pBase;
+	m_pB = pBase + num;
+	m_pTMax = pBase + 2*num;
+	m_pT0 = pBase + 3*num;
+	m_pX = pBase + 4*num;
+	m_pResult = pBase + 5*num;
+}
+
+// The functions below don't contain branches, only selects, and only use 64-bit integer
+// operations that are available in SSE2. This way, the loops in which they're used can
+// be vectorized on every x86-64 system.
+
+static inline double bitsToDouble(uint64_t x)
+{
+	double d;
+	memcpy(&d, &x, sizeof(double));
+	return d;
+}
+
+static inline uint64_t doubleToBits(double d)
+{
+	uint64_t x;
+	memcpy(&x, &d, sizeof(double));
+	return x;
+}
+
+#define BATCH_LN2_HI 6.93147180369123816490e-01 // last bits are zero, so k*BATCH_LN2_HI is exact
+#define BATCH_LN2_LO 1.90821492927058770002e-10
+#define BATCH_LOG2E 1.44269504088896338700e+00
+#define BATCH_ROUNDSHIFT 6755399441055744.0 // 1.5*2^52, adding this rounds to an integer
+#define BATCH_EXP_MIN -707.0 // exp(-707) is about 9e-308, smaller results are flushed to zero
+#define BATCH_EXP_MAX 709.782712893383973096 // log(DBL_MAX)
+
+static inline double batchExp(double x)
+{
+	const double inf = std::numeric_limits<double>::infinity();
+	double xc = (x < BATCH_EXP_MIN) ? BATCH_EXP_MIN : ((x > BATCH_EXP_MAX) ? BATCH_EXP_MAX : x);
+
+	// Write exp(x) as 2^k * exp(r), with |r| <= log(2)/2. After adding the shift, the
+	// value of k is stored in the low bits of the mantissa
+	double kShifted = xc*BATCH_LOG2E + BATCH_ROUNDSHIFT;
+	double k = kShifted - BATCH_ROUNDSHIFT;
+	double r = (xc - k*BATCH_LN2_HI) - k*BATCH_LN2_LO;
+
+	// Polynomial approximation of exp(r) (a Chebyshev economized Taylor series),
+	// the approximation error is below 1e-17
+	double p = 2.5114879796112015e-08;
+	p = p*r + 2.763265216957956e-07;
+	p = p*r + 2.7557224927351573e-06;
+	p = p*r + 2.4801485448150569e-05;
+	p = p*r + 0.00019841269909250933;
+	p = p*r + 0.0013888888952347069;
+	p = p*r + 0.0083333333333095103;
+	p = p*r + 0.041666666666487974;
+	p = p*r + 0.16666666666666702;
+	p = p*r + 0.50000000000000189;
+	p = p*r + 1.0;
+	p = p*r + 1.0;
+
+	// Build 2^(k-1) directly from the bits (2^k itself would overflow for k = 1024)
+	uint64_t kBits = doubleToBits(kShifted);
+	double scale = bitsToDouble((kBits + 1022) << 52);
+	double result = (2.0*p)*scale;
+
+	result = (x < BATCH_EXP_MIN) ? 0.0 : result;
+	result = (x > BATCH_EXP_MAX) ? inf : result;
+	return result;
+}
+
+static inline double batchLog(double x)
+{
+	const double inf = std::numeric_limits<double>::infinity();
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+
+	// Make sure that a subnormal number has an exponent we can extract
+	bool subNormal = (x < std::numeric_limits<double>::min());
+	double xs = (subNormal) ? x*18014398509481984.0 : x; // 2^54
+
+	// Write x as 2^e * m, with sqrt(0.5) < m <= sqrt(2)
+	uint64_t bits = doubleToBits(xs);
+	double e = bitsToDouble(((bits >> 52) & 0x7ffULL) | 0x4330000000000000ULL) - 4503599627370496.0; // biased exponent as double
+	double m = bitsToDouble((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL); // 1 <= m < 2
+
+	bool large = (m > 1.41421356237309504880);
+	m = (large) ? 0.5*m : m;
+	e = (large) ? e - 1022.0 : e - 1023.0;
+	e = (subNormal) ? e - 54.0 : e;
+
+	// log(m) = 2 atanh(s) = 2*s*(1 + s^2/3 + s^4/5 + ...) with s = (m-1)/(m+1) and |s| < 0.172;
+	// the series in s^2 is replaced by a polynomial approximation with an error below 1e-17
+	double s = (m - 1.0)/(m + 1.0);
+	double s2 = s*s;
+	double p = 0.074052547770825219;
+	p = p*s2 + 0.076562234600626514;
+	p = p*s2 + 0.090918174613756786;
+	p = p*s2 + 0.11111098496280565;
+	p = p*s2 + 0.1428571438064663;
+	p = p*s2 + 0.19999999999649595;
+	p = p*s2 + 0.33333333333333826;
+	p = p*s2 + 1.0;
+
+	double result = e*BATCH_LN2_HI + (e*BATCH_LN2_LO + 2.0*s*p);
+
+	result = (x > 0) ? result : ((x == 0) ? -inf : nan); // also returns NaN for NaN
+	result = (x == inf) ? inf : result;
+	return result;
+}
+
+// Same calculation as the TimeLimitedHazardFunction/HazardFunctionExp combination,
+// but every branch is evaluated and the right one is selected afterwards
+void HazardFunctionExpBatch::calculateInternalTimeIntervals()
+{
+	const double *pA = m_pA;
+	const double *pB = m_pB;
+	const double *pTMax = m_pTMax;
+	const double *pT0 = m_pT0;
+	const double *pDt = m_pX;
+	double *pResult = m_pResult;
+	const int num = m_size;
+
+	HAZARDFUNCTIONEXPBATCH_SIMD
+	for (int i = 0 ; i < num ; i++)
+	{
+		const double A = pA[i];
+		const double B = pB[i];
+		const double tMax = pTMax[i];
+		const double t0 = pT0[i];
+		const double dt = pDt[i];
+
+		const double tMaxMinT0 = tMax - t0;
+		const bool beforeTMax = (t0 + dt <= tMax);
+		const double dt1 = (beforeTMax) ? dt : tMaxMinT0; // part of the interval before tMax
+		const double invB = 1.0/((B == 0) ? 1.0 : B);
+
+		const double hMax = batchExp(A + B*tMax);
+		const double e0 = batchExp(A + B*t0);
+		const double eB = batchExp(B*dt1);
+
+		// When B is zero, e0 is exp(A)
+		const double dT1 = (B == 0) ? dt1*e0 : (e0*invB)*(eB - 1.0);
+		const double dTLimited = (beforeTMax) ? dT1 : dT1 + hMax*(dt - tMaxMinT0);
+		const double dTConstant = (hMax + HAZARDFUNCTIONEXPBATCH_SMALLNUMBER)*dt;
+
+		pResult[i] = (t0 >= tMax) ? dTConstant : dTLimited;
+	}
+}
+
+void HazardFunctionExpBatch::solveForRealTimeIntervals()
+{
+	const double *pA = m_pA;
+	const double *pB = m_pB;
+	const double *pTMax = m_pTMax;
+	const double *pT0 = m_pT0;
+	const double *pTdiff = m_pX;
+	double *pResult = m_pResult;
+	const int num = m_size;
+
+	HAZARDFUNCTIONEXPBATCH_SIMD
+	for (int i = 0 ; i < num ; i++)
+	{
+		const double A = pA[i];
+		const double B = pB[i];
+		const double tMax = pTMax[i];
+		const double t0 = pT0[i];
+		const double Tdiff = pTdiff[i];
+
+		const double tMaxMinT0 = tMax - t0;
+		const double Bsafe = (B == 0) ? 1.0 : B;
+		const double invB = 1.0/Bsafe;
+
+		const double hMax = batchExp(A + B*tMax);
+		const double e0 = batchExp(A + B*t0);
+		const double eB = batchExp(B*tMaxMinT0);
+
+		// Internal time interval until tMax is reached
+		const double TdiffMax = (B == 0) ? tMaxMinT0*e0 : (e0*invB)*(eB - 1.0);
+
+		// Solution if tMax isn't reached; the log can be NaN if it is reached, but
+		// that value is not selected then
+		const double TdiffScaled = Tdiff/e0;
+		const double dtBefore = (B == 0) ? TdiffScaled : invB*batchLog(Bsafe*TdiffScaled + 1.0);
+
+		// Solution if tMax is reached, or if we already start after tMax
+		const double invHMax = 1.0/(hMax + HAZARDFUNCTIONEXPBATCH_SMALLNUMBER);
+		const double dtAfter = (Tdiff - TdiffMax)*invHMax + tMaxMinT0;
+		const double dtLimited = (TdiffMax >= Tdiff) ? dtBefore : dtAfter;
+		const double dtConstant = Tdiff*invHMax;
+
+		pResult[i] = (t0 >= tMax) ? dtConstant : dtLimited;
+	}
+}
@@ -0,0 +1,73 @@
+#ifndef HAZARDFUNCTIONEXPBATCH_H
+
+#define HAZARDFUNCTIONEXPBATCH_H
+
+/**
+ * \file hazardfunctionexpbatch.h
+ */
+
+#include <vector>
+#include <assert.h>
+
+/** Performs the time interval calculations of a number of time limited
+ *  exponential hazards at once.
+ *
+ *  Each entry in the batch corresponds to the hazard \f[ h(t) = \exp(A+Bt) \f] for
+ *  \f$ t < t_{max} \f$, which stays constant for larger times, i.e. to a
+ *  TimeLimitedHazardFunction wrapped around a HazardFunctionExp. The parameters are
+ *  stored as a structure of arrays, so that the calculations, which are dominated by
+ *  the \c exp and \c log calls, can be vectorized by the compiler (2 doubles at a time
+ *  for the default SSE2 build, 4 or 8 when compiled with e.g. \c -mavx2 or \c -mavx512f).
+ *
+ *  To allow this, \c exp and \c log are replaced by branch-free polynomial approximations.
+ *  Their relative error is at most two units in the last place, except that \c exp flushes
+ *  results below 1e-307 to zero. The results of the batched calculations are therefore
+ *  not bit-identical to the scalar TimeLimitedHazardFunction ones: usually they agree to
+ *  about 1e-15, but where the formulas themselves are ill-conditioned (the logarithm
+ *  of a number close to one, or a difference of nearly equal internal times) the
+ *  relative difference can grow to about 1e-11.
+ */
+class HazardFunctionExpBatch
+{
+public:
+	HazardFunctionExpBatch(int num = 0)								{ resize(num); }
+	~HazardFunctionExpBatch()									{ }
+
+	/** Sets the number of entries in the batch. */
+	void resize(int num);
+	int getSize() const										{ return m_size; }
+
+	/** Sets the hazard parameters \c A, \c B and \c tMax for entry \c i, as well as the
+	 *  start time \c t0 of the interval. The last parameter \c x is the real world
+	 *  interval \f$ dt \f$ when calling HazardFunctionExpBatch::calculateInternalTimeIntervals
+	 *  and the internal time interval \f$ \Delta T \f$ for HazardFunctionExpBatch::solveForRealTimeIntervals. */
+	void setEntry(int i, double A, double B, double tMax, double t0, double x);
+
+	/** For each entry, calculates the internal time interval that corresponds to the real
+	 *  world interval \f$ dt \f$ starting from \f$ t_0 \f$, see HazardFunction::calculateInternalTimeInterval. */
+	void calculateInternalTimeIntervals();
+
+	/** For each entry, calculates the real world time interval that corresponds to the
+	 *  internal time interval \f$ \Delta T \f$ starting from \f$ t_0 \f$, see HazardFunction::solveForRealTimeInterval. */
+	void solveForRealTimeIntervals();
+
+	/** Returns the result of the last calculation for entry \c i. */
+	double getResult(int i) const									{ assert(i >= 0 && i < m_size); return m_pResult[i]; }
+private:
+	std::vector<double> m_buffer;
+	double *m_pA, *m_pB, *m_pTMax, *m_pT0, *m_pX, *m_pResult;
+	int m_size;
+};
+
+inline void HazardFunctionExpBatch::setEntry(int i, double A, double B, double tMax, double t0, double x)
+{
+	assert(i >= 0 && i < m_size);
+
+	m_pA[i] = A;
+	m_pB[i] = B;
+	m_pTMax[i] = tMax;
+	m_pT0[i] = t0;
+	m_pX[i] = x;
+}
+
+#endif // HAZARDFUNCTIONEXPBATCH_H
@@ -7,7 +7,9 @@ using namespace std;
 
 LogFile::LogFile()
 {
+	s_allLogFilesMutex.lock();
 	s_allLogFiles.push_back(this);
+	s_allLogFilesMutex.unlock();
 
 	m_pFile = 0;
 }
@@ -16,6 +18,7 @@ LogFile::~LogFile()
 {
 	close();
 
+	s_allLogFilesMutex.lock();
 	for (size_t i = 0 ; i < s_allLogFiles.size() ; i++)
 	{
 		if (s_allLogFiles[i] == this)
@@ -26,6 +29,7 @@ LogFile::~LogFile()
 			break;
 		}
 	}
+	s_allLogFilesMutex.unlock();
 }
 
 
@@ -87,9 +91,11 @@ void LogFile::printNoNewLine(const char *format, ...)
 }
 
 vector<LogFile *> LogFile::s_allLogFiles;
+Mutex LogFile::s_allLogFilesMutex;
 
 void LogFile::writeToAllLogFiles(const std::string &str)
 {
+	s_allLogFilesMutex.lock();
 	for (size_t i = 0 ; i < s_allLogFiles.size() ; i++)
 	{
 		FILE *pFile = s_allLogFiles[i]->m_pFile;
@@ -99,5 +105,6 @@ void LogFile::writeToAllLogFiles(const std::string &str)
 			fflush(pFile);
 		}
 	}
+	s_allLogFilesMutex.unlock();
 }
 
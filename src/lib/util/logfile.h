@@ -7,6 +7,7 @@
  */
 
 #include "booltype.h"
+#include "mutex.h"
 #include <stdio.h>
 #include <vector>
 
@@ -41,7 +42,9 @@ private:
 	FILE *m_pFile;
 	std::string m_fileName;
 
+	// Log files can be created and destroyed by simulations that run in different threads
 	static std::vector<LogFile *> s_allLogFiles;
+	static Mutex s_allLogFilesMutex;
 };
 
 #endif // LOGFILE_H
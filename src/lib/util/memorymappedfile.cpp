@@ -0,0 +1,107 @@
+#include "memorymappedfile.h"
+#include <stdio.h>
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // !WIN32
+
+using namespace std;
+
+MemoryMappedFile::MemoryMappedFile()
+{
+	m_pData = 0;
+	m_size = 0;
+	m_mapped = false;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	close();
+}
+
+#ifndef WIN32
+
+bool_t MemoryMappedFile::open(const string &fileName)
+{
+	if (m_pData)
+		return "A file is already opened";
+
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return "Unable to open file '" + fileName + "'";
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0)
+	{
+		::close(fd);
+		return "Unable to determine size of file '" + fileName + "', or file is empty";
+	}
+
+	size_t size = (size_t)st.st_size;
+	void *pData = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // the mapping stays valid
+
+	if (pData == MAP_FAILED)
+		return "Unable to map file '" + fileName + "' into memory";
+
+	m_pData = pData;
+	m_size = size;
+	m_mapped = true;
+	return true;
+}
+
+#else
+
+bool_t MemoryMappedFile::open(const string &fileName)
+{
+	if (m_pData)
+		return "A file is already opened";
+
+	FILE *pFile = fopen(fileName.c_str(), "rb");
+	if (!pFile)
+		return "Unable to open file '" + fileName + "'";
+
+	fseek(pFile, 0, SEEK_END);
+	long size = ftell(pFile);
+	fseek(pFile, 0, SEEK_SET);
+
+	if (size <= 0)
+	{
+		fclose(pFile);
+		return "Unable to determine size of file '" + fileName + "', or file is empty";
+	}
+
+	m_buffer.resize((size + sizeof(double) - 1)/sizeof(double));
+	if (fread(&(m_buffer[0]), 1, size, pFile) != (size_t)size)
+	{
+		fclose(pFile);
+		m_buffer.clear();
+		return "Unable to read contents of file '" + fileName + "'";
+	}
+	fclose(pFile);
+
+	m_pData = &(m_buffer[0]);
+	m_size = (size_t)size;
+	m_mapped = false;
+	return true;
+}
+
+#endif // !WIN32
+
+void MemoryMappedFile::close()
+{
+	if (!m_pData)
+		return;
+
+#ifndef WIN32
+	if (m_mapped)
+		munmap(const_cast<void *>(m_pData), m_size);
+#endif // !WIN32
+
+	m_buffer.clear();
+	m_pData = 0;
+	m_size = 0;
+	m_mapped = false;
+}
@@ -0,0 +1,31 @@
+#ifndef MEMORYMAPPEDFILE_H
+
+#define MEMORYMAPPEDFILE_H
+
+#include "booltype.h"
+#include <string>
+#include <vector>
+
+// Provides read-only access to the contents of a file. Where possible the file is
+// memory mapped, so that only the parts that are used are actually read, and so
+// that different processes that use the same file share the memory. If this is
+// not supported, the file is simply read into memory.
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile();
+	~MemoryMappedFile();
+
+	bool_t open(const std::string &fileName);
+	void close();
+
+	const void *getData() const										{ return m_pData; }
+	size_t getSize() const											{ return m_size; }
+private:
+	const void *m_pData;
+	size_t m_size;
+	bool m_mapped;
+	std::vector<double> m_buffer; // doubles, to make sure the data is aligned
+};
+
+#endif // MEMORYMAPPEDFILE_H
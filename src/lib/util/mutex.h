@@ -32,4 +32,18 @@ public:
 
 #endif // !DISABLEOPENMP
 
+// Keeps the mutex locked for as long as this object exists, also when an
+// exception is thrown
+class MutexLocker
+{
+public:
+	MutexLocker(Mutex &m) : m_mutex(m)						{ m_mutex.lock(); }
+	~MutexLocker()									{ m_mutex.unlock(); }
+private:
+	MutexLocker(const MutexLocker &);
+	MutexLocker &operator=(const MutexLocker &);
+
+	Mutex &m_mutex;
+};
+
 #endif // MUTEX_H
@@ -4,7 +4,8 @@
 
 using namespace std;
 
-PieceWiseLinearFunction::PieceWiseLinearFunction(const vector<Point2D> &points, double leftValue, double rightValue)
+PieceWiseLinearFunction::PieceWiseLinearFunction(const vector<Point2D> &points, double leftValue, double rightValue,
+                                                 int numTableCells)
 {
 	if (points.size() < 1)
 		abortWithMessage("PieceWiseLinearFunction: at least one point must be specified");
@@ -18,46 +19,52 @@ PieceWiseLinearFunction::PieceWiseLinearFunction(const vector<Point2D> &points,
 	m_leftValue = leftValue;
 	m_rightValue = rightValue;
 	m_points = points;
+
+	m_tableMinX = 0;
+	m_tableScale = 0;
+
+	if (numTableCells < 0) // automatic
+	{
+		if (points.size() > PIECEWISELINEARFUNCTION_AUTOTABLEPOINTS)
+			numTableCells = 2*((int)points.size()-1);
+		else
+			numTableCells = 0;
+	}
+
+	if (numTableCells > 0)
+		buildLookupTable(numTableCells);
 }
 
 PieceWiseLinearFunction::~PieceWiseLinearFunction()
 {
 }
 
-double PieceWiseLinearFunction::evaluate(double x)
+void PieceWiseLinearFunction::buildLookupTable(int numCells)
 {
-	assert(m_points.size() != 0);
-	size_t num = m_points.size() - 1;
+	assert(numCells > 0);
+
+	double xMin = m_points[0].x;
+	double xMax = m_points[m_points.size()-1].x;
 
-	if (num > 0)
+	if (!(xMax > xMin)) // not a useful range
+		return;
+
+	m_tableMinX = xMin;
+	m_tableScale = (double)numCells/(xMax-xMin);
+
+	// Store the interval in which each cell starts, the search in getIntervalIndex
+	// then continues from there
+	m_cellIntervals.resize(numCells);
+
+	int i = 0;
+	for (int cell = 0 ; cell < numCells ; cell++)
 	{
-		if (x < m_points[0].x)
-			return m_leftValue;
-
-		for (size_t i = 0 ; i < num ; i++)
-		{
-			double x0 = m_points[i].x;
-			double x1 = m_points[i+1].x;
-
-			if (x >= x0 && x < x1)
-			{
-				double frac = (x-x0)/(x1-x0);
-				double y0 = m_points[i].y;
-				double y1 = m_points[i+1].y;
-				
-				return (y1-y0)*frac + y0;
-			}
-		}
-		return m_rightValue;
-	}
+		double x = xMin + (double)cell/m_tableScale;
 
-	assert(num == 0);
+		while (i < (int)m_points.size()-1 && !(x < m_points[i+1].x))
+			i++;
 
-	double x0 = m_points[0].x;
-	if (x > x0)
-		return m_rightValue;
-	if (x < x0)
-		return m_leftValue;
-	return m_points[0].y;
+		m_cellIntervals[cell] = i;
+	}
 }
 
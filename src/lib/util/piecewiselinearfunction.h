@@ -6,27 +6,111 @@
 #include "point2d.h"
 #include <vector>
 #include <limits>
+#include <assert.h>
 
-// TODO: this is a slow, trivial implementation for now. Not suited for a large
-//       number of points since at every evaluation all points will be scanned
-//       to find the right interval
+// Using the lookup table is only worth it for more points than this
+#define PIECEWISELINEARFUNCTION_AUTOTABLEPOINTS 8
+
+// To find the interval that contains a specific x-value, a table is used that
+// covers the range of the points with cells of equal width, and that stores for
+// each cell the index of the interval in which the cell starts. Since only the
+// search for the interval is replaced this way, the result is exactly the same as
+// when all points would be scanned, also at the points themselves. For a small
+// number of points, the points are simply scanned.
 class PieceWiseLinearFunction : public Function
 {
 public:
-	PieceWiseLinearFunction(const std::vector<Point2D> &points, 
+	// If numTableCells is negative, a lookup table with a number of cells equal to twice
+	// the number of intervals is used when there are enough points; a value of zero
+	// disables the table
+	PieceWiseLinearFunction(const std::vector<Point2D> &points,
 			        double leftValue = std::numeric_limits<double>::quiet_NaN(),
-				double rightValue = std::numeric_limits<double>::quiet_NaN());
+				double rightValue = std::numeric_limits<double>::quiet_NaN(),
+				int numTableCells = -1);
 	~PieceWiseLinearFunction();
 
-	double evaluate(double x);
+	// Marked as final, so that a call through a PieceWiseLinearFunction pointer does
+	// not need to be a virtual one
+	double evaluate(double x) final;
 
 	double getLeftValue() const									{ return m_leftValue; }
 	double getRightValue() const									{ return m_rightValue; }
 	const std::vector<Point2D> &getPoints() const							{ return m_points; }
 private:
+	void buildLookupTable(int numCells);
+	int getIntervalIndex(double x) const;
+
 	std::vector<Point2D> m_points;
 	double m_leftValue;
 	double m_rightValue;
+
+	std::vector<int> m_cellIntervals;
+	double m_tableMinX, m_tableScale;
 };
 
+// Returns the index i for which x lies in [x_i, x_{i+1}[, or the index of the last
+// point if x is larger than all x-coordinates. Needs at least two points, and x
+// should not be smaller than the first x-coordinate
+inline int PieceWiseLinearFunction::getIntervalIndex(double x) const
+{
+	const int lastIdx = (int)m_points.size() - 1;
+	int i = 0;
+
+	if (m_cellIntervals.size() != 0)
+	{
+		const int numCells = (int)m_cellIntervals.size();
+		double pos = (x - m_tableMinX)*m_tableScale; // compare as a double, x can be very large
+		int cell = (pos < (double)numCells) ? (int)pos : numCells-1;
+		if (cell < 0)
+			cell = 0;
+
+		i = m_cellIntervals[cell];
+
+		// Because of round-off the cell may be off by one
+		while (i > 0 && x < m_points[i].x)
+			i--;
+	}
+
+	while (i < lastIdx && !(x < m_points[i+1].x))
+		i++;
+
+	return i;
+}
+
+inline double PieceWiseLinearFunction::evaluate(double x)
+{
+	assert(m_points.size() != 0);
+	int num = (int)m_points.size() - 1;
+
+	if (num > 0)
+	{
+		if (x < m_points[0].x)
+			return m_leftValue;
+		if (x != x) // NaN, don't use it to look up an interval
+			return m_rightValue;
+
+		int i = getIntervalIndex(x);
+		if (i < num)
+		{
+			double x0 = m_points[i].x;
+			double x1 = m_points[i+1].x;
+			double frac = (x-x0)/(x1-x0);
+			double y0 = m_points[i].y;
+			double y1 = m_points[i+1].y;
+
+			return (y1-y0)*frac + y0;
+		}
+		return m_rightValue;
+	}
+
+	assert(num == 0);
+
+	double x0 = m_points[0].x;
+	if (x > x0)
+		return m_rightValue;
+	if (x < x0)
+		return m_leftValue;
+	return m_points[0].y;
+}
+
 #endif // PIECEWISELINEARFUNCTION_H
@@ -31,6 +31,10 @@ public:
 	virtual double pickConditionalOnX(double x) const				{ return std::numeric_limits<double>::quiet_NaN(); }
 	virtual double pickConditionalOnY(double y) const				{ return std::numeric_limits<double>::quiet_NaN(); }
 
+	/** If the points that can be picked are known to lie in a rectangle, this function
+	 *  stores its bounds and returns true; returns false by default. */
+	virtual bool getBoundingBox(double &xMin, double &xMax, double &yMin, double &yMax) const	{ return false; }
+
 	GslRandomNumberGenerator *getRandomNumberGenerator() const			{ return m_pRng; }
 private:
 	mutable GslRandomNumberGenerator *m_pRng;
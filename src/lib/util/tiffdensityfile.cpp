@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include <tiffio.h>
 #include <string.h>
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -68,8 +69,10 @@ bool_t TIFFDensityFile::readTiffFile(const string &fileName, bool noNeg, bool fl
 	if (sampPerPixel != 1)
 		return "Only one value per pixel is supported";
 
-	if (compression != COMPRESSION_NONE)
-		return "Only uncompressed data is currently supported";
+	// Decompression is done by libtiff
+	if (!(compression == COMPRESSION_NONE || compression == COMPRESSION_LZW ||
+	      compression == COMPRESSION_ADOBE_DEFLATE || compression == COMPRESSION_DEFLATE))
+		return "Only uncompressed, LZW or Deflate compressed data is currently supported";
 
 	uint32_t width, height, depth;
 
@@ -95,144 +98,137 @@ bool_t TIFFDensityFile::readTiffFile(const string &fileName, bool noNeg, bool fl
 	TIFFGetField(pTiff, TIFFTAG_TILEWIDTH, &tileWidth);
 	TIFFGetField(pTiff, TIFFTAG_TILELENGTH, &tileHeight);
 
+	// The rows are stored at their final position immediately, so no
+	// other copy of the image needs to be kept in memory
+	m_width = (int)width;
+	m_height = (int)height;
+	m_values.resize(width*height);
+
+	bool gotNeg = false;
+	bool_t r;
+
 	if (tileWidth > 0 && tileHeight > 0)
 	{
 		if (bps == 32)
-		{
-			bool_t r = readTilesFromTIFF<float>(pTiff, tileWidth, tileHeight, width, height, noNeg, fileName);
-			if (!r)
-				return r;
-		}
+			r = readTilesFromTIFF<float>(pTiff, tileWidth, tileHeight, noNeg, flipY, gotNeg);
 		else if (bps == 64)
-		{
-			bool_t r = readTilesFromTIFF<double>(pTiff, tileWidth, tileHeight, width, height, noNeg, fileName);
-			if (!r)
-				return r;
-		}
+			r = readTilesFromTIFF<double>(pTiff, tileWidth, tileHeight, noNeg, flipY, gotNeg);
 		else
-			return "Internal error: unexpected bits per sample";
-
+			r = "Internal error: unexpected bits per sample";
 	}
 	else
 	{
-		m_values.resize(width*height);
-
-		if (bps == 64)
-		{
-			assert(TIFFScanlineSize(pTiff) == (int)(width*sizeof(double)));
-
-			for (uint32_t y = 0 ; y < height ; y++)
-			{
-				if(TIFFReadScanline(pTiff, &(m_values[width*y]), y, 0) < 0)
-					return "Error reading scan line from file " + fileName;
-			}
-		}
-		else if (bps == 32)
-		{
-			assert(TIFFScanlineSize(pTiff) == (int)(width*sizeof(float)));
-			vector<float> tmpBuf(width);
-
-			for (uint32_t y = 0 ; y < height ; y++)
-			{
-				if(TIFFReadScanline(pTiff, &(tmpBuf[0]), y, 0) < 0)
-					return "Error reading scan line from file " + fileName;
-
-				int offset = y*width;
-				for (uint32_t x = 0 ; x < width ; x++, offset++)
-					m_values[offset] = tmpBuf[x];
-			}
-		}
+		if (bps == 32)
+			r = readScanlinesFromTIFF<float>(pTiff, noNeg, flipY, gotNeg);
+		else if (bps == 64)
+			r = readScanlinesFromTIFF<double>(pTiff, noNeg, flipY, gotNeg);
 		else
-			return "Internal error: unexpected bits per sample";
+			r = "Internal error: unexpected bits per sample";
 	}
 
-	m_width = (int)width;
-	m_height = (int)height;
-
-	if (flipY)
+	if (!r)
 	{
-		// Note: since we're always swapping two lines, we can't iterate over more
-		//       than half the lines, or the flip would be undone again
-		int yMax = m_height/2;
-		vector<double> tmp(m_width);
+		m_values.clear();
+		m_width = 0;
+		m_height = 0;
+		return r;
+	}
 
-		for (int y = 0 ; y < yMax ; y++)
-		{
-			int y0 = y;
-			int y1 = m_height-1-y;
+	if (gotNeg)
+		cerr << "# WARNING! Ignoring negative values when reading " << fileName << endl;
 
-			memcpy(&(tmp[0]),&(m_values[y0*m_width]), sizeof(double)*m_width);
-			memcpy(&(m_values[y0*m_width]), &(m_values[y1*m_width]), sizeof(double)*m_width);
-			memcpy(&(m_values[y1*m_width]), &(tmp[0]), sizeof(double)*m_width);
-		}
-	}
 	m_yFlipped = flipY;
 
 	return true;
 }
 
 template<class T>
-bool_t TIFFDensityFile::readTilesFromTIFF(void *pTiffVoid, int tileWidth, int tileHeight, int width, int height, bool noNeg,
-		                        const string &fileName)
+inline void TIFFDensityFile::storeRow(const T *pSrc, int num, int x, int y, bool noNeg, bool &gotNeg)
 {
-	TIFF *pTiff = (TIFF *)pTiffVoid;
-	uint32_t numXTiles = width/tileWidth + ((width%tileWidth == 0)?0:1);
-	uint32_t numYTiles = height/tileHeight + ((height%tileHeight == 0)?0:1);
-
-#if TIFFVERSION >= 4
-	uint64_t *pNumTileBytes = 0;
-#else
-	uint32_t *pNumTileBytes = 0;
-#endif
-	if (!TIFFGetField(pTiff, TIFFTAG_TILEBYTECOUNTS, &pNumTileBytes))
-		return "Unable to get tile byte counts";
+	assert(x >= 0 && x + num <= m_width);
+	assert(y >= 0 && y < m_height);
 
-	vector<vector<Tile<T> > > tiles;
+	double *pDst = &(m_values[x + y*m_width]);
 
-	tiles.resize(numYTiles);
-	for (size_t y = 0 ; y < numYTiles ; y++)
+	for (int i = 0 ; i < num ; i++)
 	{
-		for (size_t x = 0 ; x < numXTiles ; x++)
-		{
-			size_t tileNumber = x+y*numXTiles;
-			size_t s = (size_t)pNumTileBytes[tileNumber];
+		T val = pSrc[i];
 
-			assert(s == tileWidth*tileHeight*sizeof(T));
-			
-			tiles[y].push_back(Tile<T>(s/sizeof(T)));
-			TIFFReadRawTile(pTiff, tileNumber, tiles[y][x].getData(), s);
+		if (val < 0 && noNeg)
+		{
+			gotNeg = true;
+			val = 0;
 		}
+
+		pDst[i] = val;
 	}
+}
 
-	m_values.resize(width*height);
+// Reads one tile at a time, the tiles are decompressed by libtiff if needed
+template<class T>
+bool_t TIFFDensityFile::readTilesFromTIFF(void *pTiffVoid, int tileWidth, int tileHeight, bool noNeg, bool flipY, bool &gotNeg)
+{
+	TIFF *pTiff = (TIFF *)pTiffVoid;
+	const int width = m_width;
+	const int height = m_height;
+	const int numXTiles = width/tileWidth + ((width%tileWidth == 0)?0:1);
+	const int numYTiles = height/tileHeight + ((height%tileHeight == 0)?0:1);
+	const long tileSize = (long)tileWidth*(long)tileHeight*(long)sizeof(T);
 
-	bool gotNeg = false;
-	for (int y = 0 ; y < height ; y++)
+	if ((long)TIFFTileSize(pTiff) != tileSize)
+		return "Unexpected tile size";
+
+	vector<T> tileBuffer((size_t)tileWidth*(size_t)tileHeight);
+
+	for (int ty = 0 ; ty < numYTiles ; ty++)
 	{
-		for (int x = 0 ; x < width ; x++)
+		for (int tx = 0 ; tx < numXTiles ; tx++)
 		{
-			int tx = x/tileWidth;
-			int ty = y/tileHeight;
-			int xp = x%tileWidth;
-			int yp = y%tileHeight;
+			uint32_t tileNumber = (uint32_t)(tx + ty*numXTiles);
 
-			T *pData = tiles[ty][tx].getData();
-			T val = pData[xp+yp*tileWidth];
+			if (TIFFReadEncodedTile(pTiff, tileNumber, &(tileBuffer[0]), tileSize) < 0)
+				return "Error reading tile";
 
-			if (val < 0 && noNeg)
+			// Tiles at the right and bottom can extend beyond the image
+			const int x0 = tx*tileWidth;
+			const int y0 = ty*tileHeight;
+			const int w = std::min(tileWidth, width - x0);
+			const int h = std::min(tileHeight, height - y0);
+
+			for (int yp = 0 ; yp < h ; yp++)
 			{
-				gotNeg = true;
-				val = 0;
-			}
+				int y = y0 + yp;
+				if (flipY)
+					y = height-1-y;
 
-			m_values[x+y*width] = val;
+				storeRow(&(tileBuffer[yp*tileWidth]), w, x0, y, noNeg, gotNeg);
+			}
 		}
 	}
 
+	return true;
+}
 
-	if (gotNeg)
-		cerr << "# WARNING! Ignoring negative values when reading " << fileName << endl;
+// The scan lines are read in order, which is needed for compressed strips
+template<class T>
+bool_t TIFFDensityFile::readScanlinesFromTIFF(void *pTiffVoid, bool noNeg, bool flipY, bool &gotNeg)
+{
+	TIFF *pTiff = (TIFF *)pTiffVoid;
+	const int width = m_width;
+	const int height = m_height;
+
+	if ((long)TIFFScanlineSize(pTiff) != (long)width*(long)sizeof(T))
+		return "Unexpected scan line size";
+
+	vector<T> rowBuffer(width);
+
+	for (int y = 0 ; y < height ; y++)
+	{
+		if (TIFFReadScanline(pTiff, &(rowBuffer[0]), (uint32_t)y, 0) < 0)
+			return "Error reading scan line";
+
+		storeRow(&(rowBuffer[0]), width, 0, (flipY)?(height-1-y):y, noNeg, gotNeg);
+	}
 
 	return true;
 }
-
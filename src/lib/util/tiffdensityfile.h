@@ -24,23 +24,15 @@ private:
 	bool_t readTiffFile(const std::string &fileName, bool noNeg, bool flipY);
 
 	template<class T>
-	bool_t readTilesFromTIFF(void *pTiffVoid, int tileWidth, int tileHeight, int width, int height, bool noNeg, const std::string &fileName);
+	bool_t readTilesFromTIFF(void *pTiffVoid, int tileWidth, int tileHeight, bool noNeg, bool flipY, bool &gotNeg);
+	template<class T>
+	bool_t readScanlinesFromTIFF(void *pTiffVoid, bool noNeg, bool flipY, bool &gotNeg);
+	template<class T>
+	void storeRow(const T *pSrc, int num, int x, int y, bool noNeg, bool &gotNeg);
 
 	int m_width, m_height;
 	std::vector<double> m_values;
 	bool m_yFlipped;
-
-	template<class T>
-	class Tile
-	{
-	public:
-		Tile() 										{ }
-		Tile(size_t s) 									{ m_buffer.resize(s); }
-		Tile(const Tile &src)								{ m_buffer = src.m_buffer; }
-		T *getData()	 								{ assert(m_buffer.size() > 0); return &(m_buffer[0]); }
-	private:
-		std::vector<T> m_buffer;
-	};
 };
 
 inline double TIFFDensityFile::getValue(int x, int y) const
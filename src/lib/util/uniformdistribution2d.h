@@ -29,6 +29,8 @@ public:
 	double getXMax() const								{ return m_xDist.getMax(); }
 	double getYMin() const								{ return m_yDist.getMin(); }
 	double getYMax() const								{ return m_yDist.getMax(); }
+
+	bool getBoundingBox(double &xMin, double &xMax, double &yMin, double &yMax) const		{ xMin = getXMin(); xMax = getXMax(); yMin = getYMin(); yMax = getYMax(); return true; }
 private:
 	UniformDistribution m_xDist, m_yDist;
 };
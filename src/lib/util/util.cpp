@@ -244,8 +244,18 @@ string createFullPath(const string &dir, const string &file)
 	return full;
 }
 
+static thread_local bool s_throwOnFatalError = false;
+
+void setThrowOnFatalError(bool f)
+{
+	s_throwOnFatalError = f;
+}
+
 void abortWithMessage(const string &msg)
 {
+	if (s_throwOnFatalError)
+		throw FatalErrorException(msg);
+
 	cerr << "FATAL ERROR:" << endl;
 	cerr << msg << endl;
 	cerr << endl;
@@ -7,6 +7,7 @@
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,16 @@ std::string createFullPath(const std::string &dir, const std::string &file);
 
 void abortWithMessage(const std::string &msg);
 
+// When enabled for the calling thread, abortWithMessage throws a FatalErrorException
+// instead of aborting the program, so that only the run that caused it is stopped.
+class FatalErrorException : public std::runtime_error
+{
+public:
+	FatalErrorException(const std::string &msg) : std::runtime_error(msg)	{ }
+};
+
+void setThrowOnFatalError(bool f);
+
 bool parseAsInt(const std::string &str, int &number);
 bool parseAsInt(const std::string &str, int64_t &number);
 bool parseAsDouble(const std::string &str, double &number);
@@ -6,19 +6,23 @@
 #include "configwriter.h"
 #include <algorithm>
 #include <limits>
+#include <cmath>
 
 #include <iostream>
 
 using namespace std;
 
 CoarseMap::CoarseMap(int subDivX, int subDivY)
-	: m_subDivX(subDivX), m_subDivY(subDivY), 
+	: m_initialSubDivX(subDivX), m_initialSubDivY(subDivY), 
+	  m_subDivX(subDivX), m_subDivY(subDivY), 
 	  m_cellWidth(1),
 	  m_cellHeight(1),
 	  m_maxX(-numeric_limits<double>::infinity()),
 	  m_maxY(-numeric_limits<double>::infinity()),
 	  m_minX(numeric_limits<double>::infinity()),
-	  m_minY(numeric_limits<double>::infinity())
+	  m_minY(numeric_limits<double>::infinity()),
+	  m_originX(0), m_originY(0),
+	  m_offsetX(0), m_offsetY(0)
 {
 	//cerr << "CoarseMap:" << m_subDivX << " " << m_subDivY << " " <<  m_offsetX << " " << m_offsetY
 	//	 << " " << m_width << " " << m_height << endl;
@@ -59,91 +63,210 @@ void CoarseMap::initiallizeGrid(vector<CoarseMapCell *> &cells, int subDivX, int
 	}
 }
 
+void CoarseMap::setExtent(double xMin, double xMax, double yMin, double yMax)
+{
+	assert(xMin <= xMax && yMin <= yMax);
+
+	if (m_cells.size() != 0)
+		abortWithMessage("Internal error: the extent of the coarse map can only be set when it's still empty");
+
+	m_minX = xMin;
+	m_maxX = xMax;
+	m_minY = yMin;
+	m_maxY = yMax;
+
+	rebuildGrid();
+}
+
+// The cell indices are calculated relative to the origin of the grid that was created
+// in the last rebuild, so that adding cells at the border does not change the cell of
+// anyone who's already in the grid
+bool CoarseMap::getCellIndices(Point2D location, int &cellX, int &cellY) const
+{
+	if (m_cells.size() == 0)
+		return false;
+
+	double x = std::floor((location.x-m_originX)/m_cellWidth) + (double)m_offsetX;
+	double y = std::floor((location.y-m_originY)/m_cellHeight) + (double)m_offsetY;
+
+	if (!(x >= 0 && x < (double)m_subDivX && y >= 0 && y < (double)m_subDivY)) // also catches NaN
+		return false;
+
+	cellX = (int)x;
+	cellY = (int)y;
+	return true;
+}
+
 CoarseMapCell *CoarseMap::getCell(Person *pPerson, bool canRearrange)
 {
 	assert(pPerson);
 	Point2D location = pPerson->getLocation();
+	int x = -1, y = -1;
 
-	if (location.x < m_maxX && location.x >= m_minX && location.y < m_maxY && location.y >= m_minY)
-	{
-		// Ok, previous grid should be valid
-	}
-	else
+	if (!getCellIndices(location, x, y))
 	{
 		if (!canRearrange)
 			abortWithMessage("Internal error: invalid cell coordinates, but not allowed to rearrange");
 
-		//static int rearrangeCount = 0;
-		//
-		//rearrangeCount++;
-		//cerr << "Rearranging " << rearrangeCount << endl;
-
 		if (location.x < m_minX) m_minX = location.x;
 		if (location.x > m_maxX) m_maxX = location.x;
 		if (location.y < m_minY) m_minY = location.y;
 		if (location.y > m_maxY) m_maxY = location.y;
 
-		// Let's add a bit to the region
-		double dx = (m_maxX-m_minX)/20.0;
-		double dy = (m_maxY-m_minY)/20.0;
+		// Adding some cells at the border is cheap, but if the grid would become too large
+		// we'll start over with the original number of subdivisions for the entire region
+		if (m_cells.size() == 0 || !growGrid(location))
+			rebuildGrid();
 
-		m_minX -= dx;
-		m_maxX += dx;
+		if (!getCellIndices(location, x, y))
+			abortWithMessage("Internal error: location is still outside of the coarse map after rearranging");
+	}
 
-		m_minY -= dy;
-		m_maxY += dy;
+	assert(x >= 0 && x < m_subDivX && y >= 0 && y < m_subDivY);
+
+	int pos = x+y*m_subDivX;
+	assert(pos >= 0 && pos < (int)m_cells.size());
 
-		dx = m_maxX-m_minX;
-		dy = m_maxY-m_minY;
+	return m_cells[pos];
+}
 
-		m_cellWidth = dx/(double)m_subDivX;
-		m_cellHeight = dy/(double)m_subDivY;
+// Creates a new grid with the original number of subdivisions, covering a region that's a bit
+// larger than the one from m_minX to m_maxX and m_minY to m_maxY, and moves everyone to this grid
+void CoarseMap::rebuildGrid()
+{
+	//static int rearrangeCount = 0;
+	//
+	//rearrangeCount++;
+	//cerr << "Rearranging " << rearrangeCount << endl;
 
-		if (m_cellWidth == 0)
-			m_cellWidth = 1.0;
-		if (m_cellHeight == 0)
-			m_cellHeight = 1.0;
+	// Let's add a bit to the region
+	double dx = (m_maxX-m_minX)/20.0;
+	double dy = (m_maxY-m_minY)/20.0;
 
-		vector<CoarseMapCell *> oldCells = m_cells;
-		m_cells.resize(0);
+	m_minX -= dx;
+	m_maxX += dx;
 
-		initiallizeGrid(m_cells, m_subDivX, m_subDivY, m_cellWidth, m_cellHeight, m_minX, m_minY);
-		
-		// move the old grid entries to the new grid
-		for (size_t i = 0 ; i < oldCells.size() ; i++)
+	m_minY -= dy;
+	m_maxY += dy;
+
+	dx = m_maxX-m_minX;
+	dy = m_maxY-m_minY;
+
+	m_subDivX = m_initialSubDivX;
+	m_subDivY = m_initialSubDivY;
+
+	m_cellWidth = dx/(double)m_subDivX;
+	m_cellHeight = dy/(double)m_subDivY;
+
+	if (m_cellWidth == 0)
+		m_cellWidth = 1.0;
+	if (m_cellHeight == 0)
+		m_cellHeight = 1.0;
+
+	m_originX = m_minX;
+	m_originY = m_minY;
+	m_offsetX = 0;
+	m_offsetY = 0;
+
+	vector<CoarseMapCell *> oldCells = m_cells;
+	m_cells.resize(0);
+
+	initiallizeGrid(m_cells, m_subDivX, m_subDivY, m_cellWidth, m_cellHeight, m_minX, m_minY);
+	
+	// move the old grid entries to the new grid
+	for (size_t i = 0 ; i < oldCells.size() ; i++)
+	{
+		CoarseMapCell *pCell = oldCells[i];
+
+		for (int g = 0 ; g < 2 ; g++)
 		{
-			CoarseMapCell *pCell = oldCells[i];
-			vector<Person *> &people = pCell->m_personsInCell;
+			vector<Person *> &people = pCell->m_persons[g];
 
 			for (size_t j = 0 ; j < people.size() ; j++)
+			{
+				people[j]->setCoarseMapIndex(-1);
 				addPersonInternal(people[j], false); // don't allow to rearrange again!
+			}
 		}
-
-		clearGrid(oldCells);
 	}
 
-	int x = (int)((location.x-m_minX)/m_cellWidth);
-	int y = (int)((location.y-m_minY)/m_cellHeight);
+	clearGrid(oldCells);
+}
 
-	assert(x >= 0 && x < m_subDivX && y >= 0 && y < m_subDivY);
+// Adds columns and rows of cells of the same size at the borders, so that the location
+// fits in the grid. The existing cells (and the persons in them) are kept, only the table
+// with the cell pointers needs to be rebuilt. Returns false if this would make the grid more
+// than twice as large as the original number of subdivisions in some direction.
+bool CoarseMap::growGrid(Point2D location)
+{
+	assert(m_cells.size() != 0);
 
-	int pos = x+y*m_subDivX;
-	assert(pos >= 0 && pos < (int)m_cells.size());
+	// Same kind of margin as in rebuildGrid
+	const int marginX = std::max(m_initialSubDivX/20, 1);
+	const int marginY = std::max(m_initialSubDivY/20, 1);
 
-	return m_cells[pos];
+	double x = std::floor((location.x-m_originX)/m_cellWidth) + (double)m_offsetX;
+	double y = std::floor((location.y-m_originY)/m_cellHeight) + (double)m_offsetY;
+
+	if (!(x == x && y == y)) // NaN
+		return false;
+
+	double maxX = (double)(2*m_initialSubDivX);
+	double maxY = (double)(2*m_initialSubDivY);
+	double left = (x < 0) ? (-x + marginX) : 0;
+	double right = (x >= (double)m_subDivX) ? (x - (double)m_subDivX + 1.0 + marginX) : 0;
+	double bottom = (y < 0) ? (-y + marginY) : 0;
+	double top = (y >= (double)m_subDivY) ? (y - (double)m_subDivY + 1.0 + marginY) : 0;
+
+	if ((double)m_subDivX + left + right > maxX || (double)m_subDivY + bottom + top > maxY)
+		return false;
+
+	const int addLeft = (int)left;
+	const int addBottom = (int)bottom;
+	const int newSubDivX = m_subDivX + addLeft + (int)right;
+	const int newSubDivY = m_subDivY + addBottom + (int)top;
+
+	vector<CoarseMapCell *> newCells(newSubDivX*newSubDivY);
+
+	m_offsetX += addLeft;
+	m_offsetY += addBottom;
+
+	for (int Y = 0 ; Y < newSubDivY ; Y++)
+	{
+		int oldY = Y - addBottom;
+
+		for (int X = 0 ; X < newSubDivX ; X++)
+		{
+			int oldX = X - addLeft;
+
+			if (oldX >= 0 && oldX < m_subDivX && oldY >= 0 && oldY < m_subDivY)
+				newCells[X+Y*newSubDivX] = m_cells[oldX+oldY*m_subDivX];
+			else
+				newCells[X+Y*newSubDivX] = new CoarseMapCell(Point2D(getColumnCenter(X), getRowCenter(Y)));
+		}
+	}
+
+	m_cells.swap(newCells);
+	m_subDivX = newSubDivX;
+	m_subDivY = newSubDivY;
+
+	m_minX = getColumnStart(0);
+	m_maxX = getColumnStart(m_subDivX);
+	m_minY = getRowStart(0);
+	m_maxY = getRowStart(m_subDivY);
+
+	return true;
 }
 
 void CoarseMap::addPersonInternal(Person *pPerson, bool canRearrange)
 {
 	CoarseMapCell *pCell = getCell(pPerson, canRearrange);
-	vector<Person *> &cell = pCell->m_personsInCell;
+	vector<Person *> &cell = pCell->m_persons[(int)pPerson->getGender()];
 
-#ifndef NDEBUG
-	// Check that pPerson is not already in the cell
-	for (size_t i = 0 ; i < cell.size() ; i++)
-		assert(cell[i] != pPerson);
-#endif // NDEBUG
+	// Check that pPerson is not already in a cell
+	assert(pPerson->getCoarseMapIndex() < 0);
 
+	pPerson->setCoarseMapIndex(cell.size());
 	cell.push_back(pPerson);
 }
 
@@ -155,75 +278,267 @@ void CoarseMap::addPerson(Person *pPerson)
 void CoarseMap::removePerson(Person *pPerson)
 {
 	CoarseMapCell *pCell = getCell(pPerson, false);
-	vector<Person *> &cell = pCell->m_personsInCell;
+	vector<Person *> &cell = pCell->m_persons[(int)pPerson->getGender()];
+	int idx = pPerson->getCoarseMapIndex();
+
+	if (idx < 0 || idx >= (int)cell.size() || cell[idx] != pPerson)
+		abortWithMessage(strprintf("Internal error: person %d not found in coarse grid", (int)pPerson->getPersonID()));
 
-	for (size_t i = 0 ; i < cell.size() ; i++)
+	// Move the last one in the array to position idx, and resize it
+	int last = cell.size() - 1;
+	cell[idx] = cell[last];
+	cell[idx]->setCoarseMapIndex(idx);
+	cell.resize(last);
+
+	pPerson->setCoarseMapIndex(-1);
+}
+
+void CoarseMap::getDistanceOrderedCells(std::vector<CoarseMapCell *> &cells, Point2D referenceLocation)
+{
+	CoarseMapDistanceIterator it(*this, referenceLocation);
+	CoarseMapCell *pCell;
+
+	cells.resize(0);
+	while ((pCell = it.getCell(cells.size())) != 0)
+		cells.push_back(pCell);
+}
+
+CoarseMapDistanceIterator::CoarseMapDistanceIterator(const CoarseMap &map, Point2D referenceLocation)
+	: m_map(map), m_refLocation(referenceLocation)
+{
+	map.getCellCoordinates(referenceLocation, m_cellX, m_cellY);
+
+	m_maxRing = map.getMaxRing(m_cellX, m_cellY);
+	m_nextRing = 0;
+}
+
+CoarseMapDistanceIterator::~CoarseMapDistanceIterator()
+{
+}
+
+CoarseMapCell *CoarseMapDistanceIterator::getCell(int pos)
+{
+	assert(pos >= 0);
+
+	while (pos >= (int)m_orderedCells.size())
 	{
-		if (cell[i] == pPerson)
+		// Make sure that no ring that hasn't been added yet can contain a cell that's
+		// closer (or equally close, to get the same order for such cells)
+		while (m_nextRing <= m_maxRing)
 		{
-			// Move the last one in the array to position i, and resize it
-			int last = cell.size() - 1;
-			cell[i] = cell[last];
-			cell.resize(last);
-			return;
+			if (!m_candidates.empty())
+			{
+				double bound = getRingDistanceBound(m_nextRing);
+				if (m_candidates.top().m_dist2 < bound*bound)
+					break;
+			}
+
+			addRing(m_nextRing);
+			m_nextRing++;
 		}
-	}
 
-	abortWithMessage(strprintf("Internal error: person %d not found in coarse grid", (int)pPerson->getPersonID()));
+		if (m_candidates.empty())
+			return 0;
+
+		m_orderedCells.push_back(m_map.m_cells[m_candidates.top().m_idx]);
+		m_candidates.pop();
+	}
+	return m_orderedCells[pos];
 }
 
-class DistanceSortOperator
+void CoarseMapDistanceIterator::addRing(int ring)
 {
-public:
-	DistanceSortOperator(Point2D refLocation) : m_refLocation(refLocation) { }
-	~DistanceSortOperator() { }
+	m_map.getCellsInRing(m_cellX, m_cellY, ring, m_ringCells);
 
-	double getDistanceSquaredToCell(const CoarseMapCell *pCell)
+	for (size_t i = 0 ; i < m_ringCells.size() ; i++)
 	{
-		Point2D loc = pCell->m_center;
-		double dx = loc.x - m_refLocation.x;
-		double dy = loc.y - m_refLocation.y;
+		int idx = m_ringCells[i];
+		Point2D center = m_map.m_cells[idx]->m_center;
+		double dx = center.x - m_refLocation.x;
+		double dy = center.y - m_refLocation.y;
 
-		return dx*dx+dy*dy;
+		m_candidates.push(CellDistance(dx*dx+dy*dy, idx));
 	}
+}
+
+// Returns a lower bound for the distance to the centers of the cells in this ring or in the
+// ones after it: these all lie outside the band of centers of the cells in the previous rings
+double CoarseMapDistanceIterator::getRingDistanceBound(int ring) const
+{
+	if (ring == 0)
+		return 0;
+
+	// Calculated in the same way as the cell centers
+	double left = m_map.getColumnCenter(m_cellX - ring);
+	double right = m_map.getColumnCenter(m_cellX + ring);
+	double bottom = m_map.getRowCenter(m_cellY - ring);
+	double top = m_map.getRowCenter(m_cellY + ring);
+
+	double bound = std::min(std::min(m_refLocation.x - left, right - m_refLocation.x),
+	                        std::min(m_refLocation.y - bottom, top - m_refLocation.y));
+	if (bound < 0)
+		bound = 0;
+	return bound;
+}
+
+// Same calculation as in CoarseMap::getCell, but the location does not need
+// to be inside the grid
+void CoarseMap::getCellCoordinates(Point2D location, int &cellX, int &cellY) const
+{
+	double x = std::floor((location.x-m_originX)/m_cellWidth) + (double)m_offsetX;
+	double y = std::floor((location.y-m_originY)/m_cellHeight) + (double)m_offsetY;
+
+	// Compare as doubles, the values can be very large
+	cellX = (x < (double)m_subDivX) ? std::max((int)std::max(x, -1.0), 0) : m_subDivX-1;
+	cellY = (y < (double)m_subDivY) ? std::max((int)std::max(y, -1.0), 0) : m_subDivY-1;
+}
+
+int CoarseMap::getMaxRing(int cellX, int cellY) const
+{
+	if (m_cells.size() == 0) // nothing in the map yet
+		return -1;
+
+	return std::max(std::max(cellX, m_subDivX-1-cellX), std::max(cellY, m_subDivY-1-cellY));
+}
+
+void CoarseMap::getCellsInRing(int cellX, int cellY, int ring, vector<int> &cellIndices) const
+{
+	const int x0 = std::max(cellX - ring, 0);
+	const int x1 = std::min(cellX + ring, m_subDivX-1);
+	const int y0 = std::max(cellY - ring, 0);
+	const int y1 = std::min(cellY + ring, m_subDivY-1);
+
+	cellIndices.resize(0);
 
-	bool operator() (const CoarseMapCell *pCell1, const CoarseMapCell *pCell2)
+	for (int y = y0 ; y <= y1 ; y++)
 	{
-		double dist1 = getDistanceSquaredToCell(pCell1);
-		double dist2 = getDistanceSquaredToCell(pCell2);
+		bool fullRow = (y == cellY - ring || y == cellY + ring);
+		int step = (fullRow) ? 1 : 2*ring;
 
-		return (dist1 < dist2);
+		for (int x = cellX - ring ; x <= cellX + ring ; x += step)
+		{
+			if (x >= x0 && x <= x1)
+				cellIndices.push_back(x + y*m_subDivX);
+		}
 	}
-private:
-	Point2D m_refLocation;
+}
+
+// Returns a lower bound for the distance to the persons in the cells of this ring or
+// the ones after it: they are all outside the area covered by the previous rings
+double CoarseMap::getPersonDistanceBound(Point2D location, int cellX, int cellY, int ring) const
+{
+	if (ring == 0)
+		return 0;
+
+	double left = getColumnStart(cellX - ring + 1);
+	double right = getColumnStart(cellX + ring);
+	double bottom = getRowStart(cellY - ring + 1);
+	double top = getRowStart(cellY + ring);
+
+	double bound = std::min(std::min(location.x - left, right - location.x),
+	                        std::min(location.y - bottom, top - location.y));
+	if (bound < 0)
+		bound = 0;
+	return bound;
+}
+
+class PersonDistance
+{
+public:
+	PersonDistance(double dist2, Person *pPerson) : m_dist2(dist2), m_pPerson(pPerson)	{ }
+	bool operator<(const PersonDistance &p) const
+	{
+		if (m_dist2 != p.m_dist2)
+			return m_dist2 < p.m_dist2;
+		return m_pPerson->getPersonID() < p.m_pPerson->getPersonID();
+	}
+
+	double m_dist2;
+	Person *m_pPerson;
 };
 
-void CoarseMap::getDistanceOrderedCells(std::vector<CoarseMapCell *> &cells, Point2D referenceLocation)
+void CoarseMap::getNearestPersons(Point2D referenceLocation, PersonBase::Gender g, int k, vector<Person *> &persons) const
 {
-	cells = m_cells;
+	assert(g == PersonBase::Male || g == PersonBase::Female);
+
+	persons.resize(0);
+	if (k <= 0)
+		return;
+
+	int cellX, cellY;
+	getCellCoordinates(referenceLocation, cellX, cellY);
 
-	sort(cells.begin(), cells.end(), DistanceSortOperator(referenceLocation));
+	int maxRing = getMaxRing(cellX, cellY);
+	vector<int> ringCells;
+
+	// Contains the k best ones found so far, the one furthest away on top
+	priority_queue<PersonDistance> best;
+
+	for (int ring = 0 ; ring <= maxRing ; ring++)
+	{
+		if ((int)best.size() == k)
+		{
+			// Stop if the remaining rings cannot contain a person that's closer (at the
+			// same distance it's still possible that one with a lower ID is present)
+			double bound = getPersonDistanceBound(referenceLocation, cellX, cellY, ring);
+			if (bound*bound > best.top().m_dist2)
+				break;
+		}
+
+		getCellsInRing(cellX, cellY, ring, ringCells);
+
+		for (size_t i = 0 ; i < ringCells.size() ; i++)
+		{
+			const vector<Person *> &people = m_cells[ringCells[i]]->getPersons(g);
+
+			for (size_t j = 0 ; j < people.size() ; j++)
+			{
+				Point2D loc = people[j]->getLocation();
+				double dx = loc.x - referenceLocation.x;
+				double dy = loc.y - referenceLocation.y;
+				PersonDistance p(dx*dx+dy*dy, people[j]);
+
+				if ((int)best.size() < k)
+					best.push(p);
+				else if (p < best.top())
+				{
+					best.pop();
+					best.push(p);
+				}
+			}
+		}
+	}
+
+	persons.resize(best.size());
+	for (int i = (int)best.size()-1 ; i >= 0 ; i--)
+	{
+		persons[i] = best.top().m_pPerson;
+		best.pop();
+	}
 }
 
-int CoarseMap::s_subdivX = 0;
-int CoarseMap::s_subdivY = 0;
+SimpactContext::Slot<CoarseMapSettings> CoarseMap::s_settings;
 
 void CoarseMap::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	CoarseMapSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("population.coarsemap.subdivx", s_subdivX, 4)) ||
-		!(r = config.getKeyValue("population.coarsemap.subdivy", s_subdivY, 4))
+	if (!(r = config.getKeyValue("population.coarsemap.subdivx", settings.m_subdivX, 4)) ||
+		!(r = config.getKeyValue("population.coarsemap.subdivy", settings.m_subdivY, 4)) ||
+		!(r = config.getKeyValue("population.coarsemap.exactnearest", settings.m_exactNearest))
 		)
 		abortWithMessage(r.getErrorString());
 }
 
 void CoarseMap::obtainConfig(ConfigWriter &config)
 {
+	const CoarseMapSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("population.coarsemap.subdivx", s_subdivX)) ||
-		!(r = config.addKey("population.coarsemap.subdivy", s_subdivY))
+	if (!(r = config.addKey("population.coarsemap.subdivx", settings.m_subdivX)) ||
+		!(r = config.addKey("population.coarsemap.subdivy", settings.m_subdivY)) ||
+		!(r = config.addKey("population.coarsemap.exactnearest", settings.m_exactNearest))
 		)
 		abortWithMessage(r.getErrorString());
 }
@@ -235,9 +550,12 @@ JSONConfig coarseMapConfig(R"JSON(
 			"depends": null,
 			"params": [
 				[ "population.coarsemap.subdivx", 20 ],
-				[ "population.coarsemap.subdivy", 20 ]
+				[ "population.coarsemap.subdivy", 20 ],
+				[ "population.coarsemap.exactnearest", "no", [ "yes", "no" ] ]
 			],
 			"info": [
-				"TODO"
+				"If 'population.coarsemap.exactnearest' is 'yes', the persons of interest of",
+				"someone (when the eyecap fraction is less than one) are the ones that are",
+				"really closest, instead of the people in the nearest cells of the coarse map."
 			]
 		})JSON");
@@ -3,21 +3,44 @@
 #define COARSEMAP_H
 
 #include "point2d.h"
+#include "personbase.h"
+#include "simpactcontext.h"
 #include <vector>
+#include <queue>
 
 class Person;
 class GslRandomNumberGenerator;
 class ConfigWriter;
 class ConfigSettings;
 
+// Men and women are stored in separate lists, and each person knows its position in
+// the list (see Person::getCoarseMapIndex) so that it can be removed quickly
 class CoarseMapCell
 {
 public:
 	CoarseMapCell(Point2D center) : m_center(center) { }
 	~CoarseMapCell() { }
 
+	const std::vector<Person *> &getPersons(PersonBase::Gender g) const				{ assert(g == PersonBase::Male || g == PersonBase::Female); return m_persons[(int)g]; }
+	int getNumberOfPersons(PersonBase::Gender g) const								{ return (int)getPersons(g).size(); }
+	int getNumberOfPersons() const													{ return (int)(m_persons[0].size() + m_persons[1].size()); }
+
 	const Point2D m_center;
-	std::vector<Person *> m_personsInCell;
+private:
+	std::vector<Person *> m_persons[2];
+
+	friend class CoarseMap;
+};
+
+class CoarseMapDistanceIterator;
+
+class CoarseMapSettings
+{
+public:
+	CoarseMapSettings() : m_subdivX(0), m_subdivY(0), m_exactNearest(false)					{ }
+
+	int m_subdivX, m_subdivY;
+	bool m_exactNearest;
 };
 
 class CoarseMap
@@ -26,16 +49,27 @@ public:
 	CoarseMap(int subDixX, int subDivY);
 	~CoarseMap();
 
+	// Creates the grid for the specified region in advance, to avoid having to rearrange it
+	// when people are added. Can only be used while the map is still empty.
+	void setExtent(double xMin, double xMax, double yMin, double yMax);
+
 	// These use the location stored in the person instance
 	void addPerson(Person *pPerson);
 	void removePerson(Person *pPerson);
 	void getDistanceOrderedCells(std::vector<CoarseMapCell *> &cells, Point2D referenceLocation);
+	int getNumberOfCells() const													{ return (int)m_cells.size(); }
+
+	// Stores the (at most) k persons of gender g that are closest to the reference location in
+	// 'persons', in order of increasing distance. Persons at the same distance are ordered by
+	// their ID.
+	void getNearestPersons(Point2D referenceLocation, PersonBase::Gender g, int k, std::vector<Person *> &persons) const;
 
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 
-	static int getXSubdivision()													{ return s_subdivX; }
-	static int getYSubdivision()													{ return s_subdivY; }
+	static int getXSubdivision(const SimpactContext &context)						{ return context.get(s_settings).m_subdivX; }
+	static int getYSubdivision(const SimpactContext &context)						{ return context.get(s_settings).m_subdivY; }
+	static bool useExactNearest(const SimpactContext &context)						{ return context.get(s_settings).m_exactNearest; }
 private:
 	static void clearGrid(std::vector<CoarseMapCell *> &cells);
 	static void initiallizeGrid(std::vector<CoarseMapCell *> &cells, int subDivX, int subDivY, double cellWidth,
@@ -43,16 +77,77 @@ private:
 
 	void addPersonInternal(Person *pPerson, bool canRearrange);
 	CoarseMapCell *getCell(Person *pPerson, bool canRearrange);
+	bool getCellIndices(Point2D location, int &cellX, int &cellY) const;
+	void rebuildGrid();
+	bool growGrid(Point2D location);
+
+	double getColumnStart(int x) const												{ return (double)(x - m_offsetX) * m_cellWidth + m_originX; }
+	double getRowStart(int y) const													{ return (double)(y - m_offsetY) * m_cellHeight + m_originY; }
+	double getColumnCenter(int x) const												{ return ((double)(x - m_offsetX) + 0.5) * m_cellWidth + m_originX; }
+	double getRowCenter(int y) const												{ return ((double)(y - m_offsetY) + 0.5) * m_cellHeight + m_originY; }
 
-	const int m_subDivX, m_subDivY;
+	// The rings around a cell consist of the cells for which the largest of the differences
+	// in x and y index with that cell equals the ring number
+	void getCellCoordinates(Point2D location, int &cellX, int &cellY) const;
+	int getMaxRing(int cellX, int cellY) const;
+	void getCellsInRing(int cellX, int cellY, int ring, std::vector<int> &cellIndices) const;
+	double getPersonDistanceBound(Point2D location, int cellX, int cellY, int ring) const;
+
+	const int m_initialSubDivX, m_initialSubDivY;
+	int m_subDivX, m_subDivY;
 	double m_minX, m_maxX;
 	double m_minY, m_maxY;
 
+	// Cell (m_offsetX, m_offsetY) starts at this point; these are set when the
+	// grid is rebuilt and stay the same when cells are added at the border
+	double m_originX, m_originY;
+	int m_offsetX, m_offsetY;
+
 	double m_mapMinX, m_mapMinY;
 	double m_cellWidth, m_cellHeight;
 	std::vector<CoarseMapCell *> m_cells;
 
-	static int s_subdivX, s_subdivY;
+	static SimpactContext::Slot<CoarseMapSettings> s_settings;
+
+	friend class CoarseMapDistanceIterator;
+};
+
+// Provides the cells of a coarse map in order of increasing distance from a reference
+// location, without sorting all of them: starting from the cell that contains the
+// reference location, rings of cells around it are only added when needed. A cell is
+// returned once it's certain that no cell in a ring that has not been added yet can be
+// closer; cells at the same distance are returned in the order in which they're stored
+// in the map. The map must not change while this is being used.
+class CoarseMapDistanceIterator
+{
+public:
+	CoarseMapDistanceIterator(const CoarseMap &map, Point2D referenceLocation);
+	~CoarseMapDistanceIterator();
+
+	// Returns the cell at position 'pos' in the distance ordered list, or null if the
+	// map doesn't have that many cells. Positions are meant to be accessed in order,
+	// the cells that have been returned already are stored
+	CoarseMapCell *getCell(int pos);
+private:
+	class CellDistance
+	{
+	public:
+		CellDistance(double dist2, int idx) : m_dist2(dist2), m_idx(idx)		{ }
+		bool operator>(const CellDistance &c) const						{ if (m_dist2 != c.m_dist2) return m_dist2 > c.m_dist2; return m_idx > c.m_idx; }
+
+		double m_dist2;
+		int m_idx;
+	};
+
+	void addRing(int ring);
+	double getRingDistanceBound(int ring) const;
+
+	const CoarseMap &m_map;
+	const Point2D m_refLocation;
+	int m_cellX, m_cellY, m_maxRing, m_nextRing;
+	std::vector<int> m_ringCells;
+	std::priority_queue<CellDistance, std::vector<CellDistance>, std::greater<CellDistance> > m_candidates;
+	std::vector<CoarseMapCell *> m_orderedCells;
 };
 
 #endif // COARSEMAP_H
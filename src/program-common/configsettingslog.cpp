@@ -91,7 +91,7 @@ void ConfigSettingsLog::addConfigSettings(double t, const ConfigSettings &config
 
 }
 
-map<string, vector<string> > ConfigSettingsLog::m_configLog;
+SimpactContext::Slot<ConfigSettingsLog> ConfigSettingsLog::s_configSettingsLog;
 
 void ConfigSettingsLog::writeConfigSettings(LogFile &s)
 {
@@ -5,17 +5,25 @@
 #include <vector>
 #include <string>
 #include <map>
+#include "simpactcontext.h"
 
 class ConfigSettings;
 class LogFile;
 
+// Keeps track of the configuration settings that were used in a simulation,
+// one entry for the start and one for each intervention
 class ConfigSettingsLog
 {
 public:
-	static void addConfigSettings(double t, const ConfigSettings &s);
-	static void writeConfigSettings(LogFile &s);
+	// The log of the simulation that uses this context
+	static ConfigSettingsLog &get(SimpactContext &context)							{ return context.get(s_configSettingsLog); }
+
+	void addConfigSettings(double t, const ConfigSettings &s);
+	void writeConfigSettings(LogFile &s);
 private:
-	static std::map<std::string, std::vector<std::string> > m_configLog;
+	std::map<std::string, std::vector<std::string> > m_configLog;
+
+	static SimpactContext::Slot<ConfigSettingsLog> s_configSettingsLog;
 };
 
 #endif // CONFIGSETTINGSLOG_H
@@ -8,18 +8,23 @@
 #include "configsettingslog.h"
 #include "gslrandomnumbergenerator.h"
 #include "configfunctions.h"
+#include "eventintervention.h"
 #include <vector>
 #include <iostream>
 
 using namespace std;
 
 void checkConfiguration(const ConfigSettings &loadedConfig, const SimpactPopulationConfig &populationConfig, double tMax,
-		        int64_t maxEvents);
+		        int64_t maxEvents, ostream &out);
 
+// The messages are written to 'out', which is different for each simulation
+// of an ensemble
 bool_t configure(ConfigSettings &config, SimpactPopulationConfig &populationConfig, PopulationDistributionCSV &ageDist,
-	       GslRandomNumberGenerator *pRndGen, double &tMax, int64_t &maxEvents)
+	       GslRandomNumberGenerator *pRndGen, double &tMax, int64_t &maxEvents, ostream &out)
 {
-	ConfigFunctions::processConfigurations(config, pRndGen);
+	// The keys that are read are recorded in the context of this simulation, so that
+	// an intervention event knows which settings need to be processed again
+	ConfigFunctions::processConfigurations(config, pRndGen, &EventIntervention::getReadKeys(SimpactContext::getConfigContext()));
 
 	// TODO: absorb these things into similar process/obtain functions?
 
@@ -27,6 +32,7 @@ bool_t configure(ConfigSettings &config, SimpactPopulationConfig &populationConf
 	double eyecapFraction = 1;
 	string ageDistFile;
 	bool msm = false;
+	bool releaseDeceased = false;
 	bool_t r;
 
 	if (!(r = config.getKeyValue("population.nummen", numMen, 0)) ||
@@ -35,7 +41,8 @@ bool_t configure(ConfigSettings &config, SimpactPopulationConfig &populationConf
 	    !(r = config.getKeyValue("population.simtime", tMax)) ||
 	    !(r = config.getKeyValue("population.maxevents", maxEvents)) ||
 	    !(r = config.getKeyValue("population.eyecap.fraction", eyecapFraction, 0, 1)) ||
-		!(r = config.getKeyValue("population.msm", msm)) 
+		!(r = config.getKeyValue("population.msm", msm)) ||
+		!(r = config.getKeyValue("population.deceased.release", releaseDeceased))
 		)
 		abortWithMessage(r.getErrorString());
 
@@ -43,10 +50,11 @@ bool_t configure(ConfigSettings &config, SimpactPopulationConfig &populationConf
 	populationConfig.setInitialWomen(numWomen);
 	populationConfig.setEyeCapsFraction(eyecapFraction);
 	populationConfig.setMSM(msm);
+	populationConfig.setReleaseDeceased(releaseDeceased);
 
 	if (!(r = ageDist.load(ageDistFile)))
 	{
-		cerr << "Can't load age distribution data: " << r.getErrorString() << endl;
+		out << "Can't load age distribution data: " << r.getErrorString() << endl;
 		return false;
 	}
 
@@ -56,30 +64,30 @@ bool_t configure(ConfigSettings &config, SimpactPopulationConfig &populationConf
 	config.getUnusedKeys(keys);
 	if (keys.size() != 0)
 	{
-		cerr << "Error: the following entries from the configuration file were not used:" << endl;
+		out << "Error: the following entries from the configuration file were not used:" << endl;
 		for (size_t i = 0 ; i < keys.size() ; i++)
-			cerr << "  " << keys[i] << endl;
+			out << "  " << keys[i] << endl;
 		
-		cerr << endl;
+		out << endl;
 		return false;
 	}
 	
 	// Sanity check on configuration parameters
-	cerr << "# Performing extra check on read configuration parameters" << endl;
-	checkConfiguration(config, populationConfig, tMax, maxEvents);
+	out << "# Performing extra check on read configuration parameters" << endl;
+	checkConfiguration(config, populationConfig, tMax, maxEvents, out);
 
-	ConfigSettingsLog::addConfigSettings(0, config);
+	ConfigSettingsLog::get(SimpactContext::getConfigContext()).addConfigSettings(0, config);
 
 	return true;
 }
 
-bool areValuesCompatible(const string &key, const std::string &A, const std::string &B, bool canIgnore = true) // B can be 'IGNORE', just print a warning then
+bool areValuesCompatible(const string &key, const std::string &A, const std::string &B, ostream &out, bool canIgnore = true) // B can be 'IGNORE', just print a warning then
 {
 	if (canIgnore)
 	{
 		if (B == "IGNORE")
 		{
-			cerr << "# WARNING: ignoring consistency check for config key " << key << " (config value is '" << A << "')" << endl;
+			out << "# WARNING: ignoring consistency check for config key " << key << " (config value is '" << A << "')" << endl;
 			return true;
 		}
 	}
@@ -112,10 +120,10 @@ bool areValuesCompatible(const string &key, const std::string &A, const std::str
 
 		if (diff < 1e-10)
 		{
-			cerr << "# WARNING: ignoring small (" << diff << ") difference between " << A << " and " << B << " in key " << key << endl;
+			out << "# WARNING: ignoring small (" << diff << ") difference between " << A << " and " << B << " in key " << key << endl;
 			return true;
 		}
-		cerr << "# ERROR: relative difference between two doubles (" << A << " and " << B << ") is too large: " << diff << endl;
+		out << "# ERROR: relative difference between two doubles (" << A << " and " << B << ") is too large: " << diff << endl;
 		return false;
 	}
 
@@ -142,7 +150,7 @@ bool areValuesCompatible(const string &key, const std::string &A, const std::str
 		string subA = trim(partsA[i]);
 		string subB = trim(partsB[i]);
 
-		if (!areValuesCompatible(key, subA, subB, false))
+		if (!areValuesCompatible(key, subA, subB, out, false))
 			return false;
 	}
 
@@ -151,7 +159,7 @@ bool areValuesCompatible(const string &key, const std::string &A, const std::str
 }
 
 void checkConfiguration(const ConfigSettings &loadedConfig, const SimpactPopulationConfig &populationConfig, double tMax,
-		        int64_t maxEvents)
+		        int64_t maxEvents, ostream &out)
 {
 	ConfigWriter config;
 	bool_t r;
@@ -166,7 +174,8 @@ void checkConfiguration(const ConfigSettings &loadedConfig, const SimpactPopulat
 	    !(r = config.addKey("population.simtime", tMax)) ||
 	    !(r = config.addKey("population.maxevents", maxEvents)) ||
 	    !(r = config.addKey("population.eyecap.fraction", populationConfig.getEyeCapsFraction())) ||
-		!(r = config.addKey("population.msm", populationConfig.getMSM()))
+		!(r = config.addKey("population.msm", populationConfig.getMSM())) ||
+		!(r = config.addKey("population.deceased.release", populationConfig.getReleaseDeceased()))
 		)
 		abortWithMessage(r.getErrorString());
 
@@ -188,7 +197,7 @@ void checkConfiguration(const ConfigSettings &loadedConfig, const SimpactPopulat
 			abortWithMessage("Consistency error: " + keys[i] + " is present in config file but doesn't seem to be configured");
 	
 		//cerr << "Checking " << keys[i] << ":" << val1 << " vs " << val2 << endl;
-		if (!areValuesCompatible(keys[i], val1, val2))
+		if (!areValuesCompatible(keys[i], val1, val2, out))
 			abortWithMessage("Consistency error: inconsistency for key " + keys[i] + " (" + val1 + " <-> " + val2 + ")");
 	}
 
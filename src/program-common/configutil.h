@@ -4,6 +4,7 @@
 
 #include "booltype.h"
 #include <stdint.h>
+#include <ostream>
 
 class ConfigSettings;
 class GslRandomNumberGenerator;
@@ -12,6 +13,6 @@ class PopulationDistributionCSV;
 
 void processNonInterventionEventConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 bool_t configure(ConfigSettings &config, SimpactPopulationConfig &populationConfig, PopulationDistributionCSV &ageDist,
-	             GslRandomNumberGenerator *pRndGen, double &tMax, int64_t &maxEvents);
+	             GslRandomNumberGenerator *pRndGen, double &tMax, int64_t &maxEvents, std::ostream &out);
 
 #endif // CONFIGUTIL_H
@@ -24,9 +24,9 @@ string EventAIDSMortality::getDescription(double tNow) const
 void EventAIDSMortality::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(false, "aidsmortality", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), false, "aidsmortality", tNow, pPerson, 0);
 
-	LogEvent.print(",intreatment,%d", (int)pPerson->hiv().hasLoweredViralLoad());
+	LogSystem::get(pop.getContext()).logEvents.print(",intreatment,%d", (int)pPerson->hiv().hasLoweredViralLoad());
 }
 
 double EventAIDSMortality::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
@@ -42,8 +42,7 @@ double EventAIDSMortality::getNewInternalTimeDifference(GslRandomNumberGenerator
 	return m_eventHelper.getNewInternalTimeDifference(pRndGen, pState);
 }
 
-double EventAIDSMortality::m_C = 0;
-double EventAIDSMortality::m_k = 0;
+SimpactContext::Slot<EventAIDSMortalitySettings> EventAIDSMortality::s_settings;
 
 double EventAIDSMortality::calculateInternalTimeInterval(const State *pState, double t0, double dt)
 {
@@ -89,27 +88,32 @@ void EventAIDSMortality::fire(Algorithm *pAlgorithm, State *pState, double t)
 
 	m_eventHelper.checkFireTime(t);
 
+	// This is marked first, since the person log entry may already be written
+	// when the person is marked as deceased
+	pPerson->hiv().markAIDSDeath();
+
 	// Note that we need to call this after the previous check, otherwise the person will
 	// already have been marked as deceased
 	EventMortalityBase::fire(pAlgorithm, pState, t);
-	pPerson->hiv().markAIDSDeath(); // The person already needs to be marked as deceased
 }
 
 void EventAIDSMortality::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventAIDSMortalitySettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("mortality.aids.survtime.C", m_C, 0)) ||
-	    !(r = config.getKeyValue("mortality.aids.survtime.k", m_k)))
+	if (!(r = config.getKeyValue("mortality.aids.survtime.C", settings.m_C, 0)) ||
+	    !(r = config.getKeyValue("mortality.aids.survtime.k", settings.m_k)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventAIDSMortality::obtainConfig(ConfigWriter &config)
 {
+	const EventAIDSMortalitySettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("mortality.aids.survtime.C", m_C)) ||
-	    !(r = config.addKey("mortality.aids.survtime.k", m_k)) )
+	if (!(r = config.addKey("mortality.aids.survtime.C", settings.m_C)) ||
+	    !(r = config.addKey("mortality.aids.survtime.k", settings.m_k)) )
 		abortWithMessage(r.getErrorString());
 }
 
@@ -5,6 +5,15 @@
 #include "eventmortalitybase.h"
 #include "eventvariablefiretime.h"
 
+class EventAIDSMortalitySettings
+{
+public:
+	EventAIDSMortalitySettings() : m_C(0), m_k(0)											{ }
+
+	double m_C;
+	double m_k;
+};
+
 // AIDS mortality
 class EventAIDSMortality : public EventMortalityBase
 {
@@ -28,19 +37,18 @@ private:
 
 	EventVariableFireTime_Helper m_eventHelper;
 
-	// TODO: use access functions
-	static double m_C;
-	static double m_k;
+	static SimpactContext::Slot<EventAIDSMortalitySettings> s_settings;
 };
 
 inline double EventAIDSMortality::getExpectedSurvivalTime(const Person *pPerson)
 {
 	assert(pPerson);
+	const EventAIDSMortalitySettings &settings = pPerson->getContext().get(s_settings);
 	double Vsp = pPerson->hiv().getSetPointViralLoad();
 	double log10Offset = pPerson->getSurvivalTimeLog10Offset();
 	assert(Vsp > 0);
 
-	double tSurvival = m_C/std::pow(Vsp, -m_k) * std::pow(10.0, log10Offset);
+	double tSurvival = settings.m_C/std::pow(Vsp, -settings.m_k) * std::pow(10.0, log10Offset);
 	assert(tSurvival > 0);
 
 	return tSurvival;
@@ -35,7 +35,7 @@ void EventAIDSStage::writeLogs(const SimpactPopulation &pop, double tNow) const
 	else
 		name = "aidsstage";
 
-	writeEventLogStart(true, name, tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), true, name, tNow, pPerson, 0);
 }
 
 void EventAIDSStage::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -91,6 +91,7 @@ void EventAIDSStage::checkFireTime(double t0)
 double EventAIDSStage::getNewStageTime(double currentTime) const
 {
 	const Person *pPerson = getPerson(0);
+	const EventAIDSStageSettings &settings = pPerson->getContext().get(s_settings);
 
 	double expectedTimeOfDeath = pPerson->hiv().getAIDSMortalityTime();
 	double newStageTime = expectedTimeOfDeath;
@@ -98,12 +99,12 @@ double EventAIDSStage::getNewStageTime(double currentTime) const
 	if (m_finalStage)
 	{
 		assert(pPerson->hiv().getInfectionStage() == Person_HIV::AIDS);
-		newStageTime -= m_relativeFinalTime;
+		newStageTime -= settings.m_relativeFinalTime;
 	}
 	else
 	{
 		assert(pPerson->hiv().getInfectionStage() == Person_HIV::Chronic);
-		newStageTime -= m_relativeStartTime;
+		newStageTime -= settings.m_relativeStartTime;
 	}
 	
 	// TODO: What's  a good approach in this case? for now, we'll advance to the
@@ -117,24 +118,25 @@ double EventAIDSStage::getNewStageTime(double currentTime) const
 	return newStageTime;
 }
 
-double EventAIDSStage::m_relativeStartTime = -1;
-double EventAIDSStage::m_relativeFinalTime = -1;
+SimpactContext::Slot<EventAIDSStageSettings> EventAIDSStage::s_settings;
 
 void EventAIDSStage::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventAIDSStageSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("aidsstage.final", m_relativeFinalTime, 0)) ||
-	    !(r = config.getKeyValue("aidsstage.start", m_relativeStartTime, m_relativeFinalTime)) )
+	if (!(r = config.getKeyValue("aidsstage.final", settings.m_relativeFinalTime, 0)) ||
+	    !(r = config.getKeyValue("aidsstage.start", settings.m_relativeStartTime, settings.m_relativeFinalTime)) )
 		abortWithMessage(r.getErrorString());
 }
 
 void EventAIDSStage::obtainConfig(ConfigWriter &config)
 {
+	const EventAIDSStageSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("aidsstage.final", m_relativeFinalTime)) ||
-	    !(r = config.addKey("aidsstage.start", m_relativeStartTime)) )
+	if (!(r = config.addKey("aidsstage.final", settings.m_relativeFinalTime)) ||
+	    !(r = config.addKey("aidsstage.start", settings.m_relativeStartTime)) )
 		abortWithMessage(r.getErrorString());
 }
 
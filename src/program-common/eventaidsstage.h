@@ -4,6 +4,15 @@
 
 #include "eventvariablefiretime.h"
 
+class EventAIDSStageSettings
+{
+public:
+	EventAIDSStageSettings() : m_relativeStartTime(-1), m_relativeFinalTime(-1)			{ }
+
+	double m_relativeStartTime;
+	double m_relativeFinalTime;
+};
+
 class EventAIDSStage : public SimpactEvent
 {
 public:
@@ -27,8 +36,7 @@ private:
 	EventVariableFireTime_Helper m_eventHelper;
 	bool m_finalStage;
 
-	static double m_relativeStartTime;
-	static double m_relativeFinalTime;
+	static SimpactContext::Slot<EventAIDSStageSettings> s_settings;
 };
 
 #endif // EVENTAIDSSTAGE_H
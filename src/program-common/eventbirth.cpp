@@ -19,6 +19,8 @@ EventBirth::EventBirth(Person *pMother) : SimpactEvent(pMother)
 
 EventBirth::~EventBirth()
 {
+	if (m_pFather)
+		m_pFather->removeReference();
 }
 
 string EventBirth::getDescription(double tNow) const
@@ -30,14 +32,16 @@ void EventBirth::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pMother = getPerson(0);
 
-	writeEventLogStart(true, "birth", tNow, pMother, 0);
+	writeEventLogStart(pop.getContext(), true, "birth", tNow, pMother, 0);
 }
 
 double EventBirth::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	assert(m_pPregDurationDist);
+	const EventBirthSettings &settings = SIMPACTPOPULATION(pState).getContext().get(s_settings);
 
-	double dt = m_pPregDurationDist->pickNumber();
+	assert(settings.m_pPregDurationDist);
+
+	double dt = settings.m_pPregDurationDist->pickNumber();
 
 	return dt;
 }
@@ -45,6 +49,7 @@ double EventBirth::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGe
 void EventBirth::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	const EventBirthSettings &settings = population.getContext().get(s_settings);
 
 	Woman *pMother = WOMAN(getPerson(0));
 	assert(pMother->isPregnant());
@@ -56,11 +61,11 @@ void EventBirth::fire(Algorithm *pAlgorithm, State *pState, double t)
 	GslRandomNumberGenerator *pRndGen = population.getRandomNumberGenerator();
 	Person *pChild = 0;
 	
-	assert(m_boyGirlRatio >= 0 && m_boyGirlRatio <= 1.0);
-	if (pRndGen->pickRandomDouble() < m_boyGirlRatio)
-		pChild = new Man(t);
+	assert(settings.m_boyGirlRatio >= 0 && settings.m_boyGirlRatio <= 1.0);
+	if (pRndGen->pickRandomDouble() < settings.m_boyGirlRatio)
+		pChild = new Man(t, population.getContext());
 	else
-		pChild = new Woman(t);
+		pChild = new Woman(t, population.getContext());
 
 	assert(m_pFather != 0);
 	pChild->setFather(m_pFather);
@@ -70,7 +75,7 @@ void EventBirth::fire(Algorithm *pAlgorithm, State *pState, double t)
 	pMother->addChild(pChild);
 
 	population.addNewPerson(pChild);
-	writeEventLogStart(true, "(childborn)", t, pChild, 0);
+	writeEventLogStart(population.getContext(), true, "(childborn)", t, pChild, 0);
 
 	// TODO!
 	// Currently children are assumed to be non-infected, even if the mother is infected
@@ -85,23 +90,16 @@ void EventBirth::fire(Algorithm *pAlgorithm, State *pState, double t)
 	// TODO: this needs to be changed if breastfeeding event is included
 	// Schedule conception events for current relationships the mother is in
 	int numRelations = pMother->getNumberOfRelationships();
-	pMother->startRelationshipIteration();
 	
 	for (int i = 0 ; i < numRelations ; i++)
 	{
-		double formationTime = -1;
-		Person *pPartner = pMother->getNextRelationshipPartner(formationTime);
+		Person *pPartner = pMother->getRelationshipPartner(i);
 
 		assert(pPartner->getGender() == Person::Male);
 
 		EventConception *pEvtCon = new EventConception(pPartner, pMother, t);
 		population.onNewEvent(pEvtCon);
 	}
-
-#ifndef NDEBUG
-	double tDummy;
-	assert(pMother->getNextRelationshipPartner(tDummy) == 0);
-#endif // NDEBUG
 }
 
 void EventBirth::setFather(Person *pFather)
@@ -110,6 +108,10 @@ void EventBirth::setFather(Person *pFather)
 	assert(m_pFather == 0); // should only be set once
 
 	m_pFather = MAN(pFather);
+
+	// The father is not one of the persons this event was created with, but
+	// he may die before the birth; make sure he's not released before that
+	m_pFather->addReference();
 }
 
 void EventBirth::markOtherAffectedPeople(const PopulationStateInterface &population)
@@ -120,30 +122,43 @@ void EventBirth::markOtherAffectedPeople(const PopulationStateInterface &populat
 		population.markAffectedPerson(m_pFather);
 }
 
-double EventBirth::m_boyGirlRatio = -1;
-ProbabilityDistribution *EventBirth::m_pPregDurationDist = 0;
+EventBirthSettings::EventBirthSettings()
+{
+	m_boyGirlRatio = -1;
+	m_pPregDurationDist = 0;
+}
+
+EventBirthSettings::~EventBirthSettings()
+{
+	delete m_pPregDurationDist;
+}
+
+SimpactContext::Slot<EventBirthSettings> EventBirth::s_settings;
 
 void EventBirth::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
-	if (m_pPregDurationDist)
+	EventBirthSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	if (settings.m_pPregDurationDist)
 	{
-		delete m_pPregDurationDist;
-		m_pPregDurationDist = 0;
+		delete settings.m_pPregDurationDist;
+		settings.m_pPregDurationDist = 0;
 	}
 
-	m_pPregDurationDist = getDistributionFromConfig(config, pRndGen, "birth.pregnancyduration");
+	settings.m_pPregDurationDist = getDistributionFromConfig(config, pRndGen, "birth.pregnancyduration");
 
 	bool_t r;
-	if (!(r = config.getKeyValue("birth.boygirlratio", m_boyGirlRatio, 0, 1)))
+	if (!(r = config.getKeyValue("birth.boygirlratio", settings.m_boyGirlRatio, 0, 1)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventBirth::obtainConfig(ConfigWriter &config)
 {
+	const EventBirthSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	addDistributionToConfig(m_pPregDurationDist, config, "birth.pregnancyduration");
-	if (!(r = config.addKey("birth.boygirlratio", m_boyGirlRatio)))
+	addDistributionToConfig(settings.m_pPregDurationDist, config, "birth.pregnancyduration");
+	if (!(r = config.addKey("birth.boygirlratio", settings.m_boyGirlRatio)))
 		abortWithMessage(r.getErrorString());
 }
 
@@ -4,6 +4,16 @@
 
 #include "simpactevent.h"
 
+class EventBirthSettings
+{
+public:
+	EventBirthSettings();
+	~EventBirthSettings();
+
+	double m_boyGirlRatio;
+	ProbabilityDistribution *m_pPregDurationDist;
+};
+
 class EventBirth : public SimpactEvent
 {
 public:
@@ -26,8 +36,7 @@ private:
 
 	Man *m_pFather;
 
-	static double m_boyGirlRatio;
-	static ProbabilityDistribution *m_pPregDurationDist;
+	static SimpactContext::Slot<EventBirthSettings> s_settings;
 };
 
 #endif // EVENTBIRTH_H
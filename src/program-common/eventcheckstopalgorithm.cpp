@@ -34,17 +34,18 @@ void EventCheckStopAlgorithm::writeLogs(const SimpactPopulation &pop, double tNo
 void EventCheckStopAlgorithm::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	const EventCheckStopAlgorithmSettings &settings = population.getContext().get(s_settings);
 	int popSize = population.getNumberOfPeople();
 	double curTime = getCurrentTime();
 
-	if (popSize > s_maxPopSize)
-		pState->setAbortAlgorithm(strprintf("Check failed (simulation time = %g): Population size %d exceeds specified maximum %g", t, popSize, s_maxPopSize));
-	if (curTime - m_startTime > s_maxRunningTime)
-		pState->setAbortAlgorithm(strprintf("Check failed (simulation time = %g): Maximum running time (real time, not simulation time) of %g seconds is exceeded", t, s_maxRunningTime));
+	if (popSize > settings.m_maxPopSize)
+		pState->setAbortAlgorithm(strprintf("Check failed (simulation time = %g): Population size %d exceeds specified maximum %g", t, popSize, settings.m_maxPopSize));
+	if (curTime - m_startTime > settings.m_maxRunningTime)
+		pState->setAbortAlgorithm(strprintf("Check failed (simulation time = %g): Maximum running time (real time, not simulation time) of %g seconds is exceeded", t, settings.m_maxRunningTime));
 
-	//cout << "# curTime = " << curTime << " m_startTime = " << m_startTime << " s_maxRunningTime = " << s_maxRunningTime << endl;
+	//cout << "# curTime = " << curTime << " m_startTime = " << m_startTime << " settings.m_maxRunningTime = " << settings.m_maxRunningTime << endl;
 
-	if (isEnabled())
+	if (isEnabled(population.getContext()))
 	{
 		EventCheckStopAlgorithm *pEvt = new EventCheckStopAlgorithm(m_startTime);
 		population.onNewEvent(pEvt);
@@ -53,8 +54,10 @@ void EventCheckStopAlgorithm::fire(Algorithm *pAlgorithm, State *pState, double
 
 double EventCheckStopAlgorithm::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	assert(s_interval > 0);
-	return s_interval;
+	double dt = getInterval(SIMPACTPOPULATION(pState).getContext());
+
+	assert(dt > 0);
+	return dt;
 }
 
 inline double EventCheckStopAlgorithm::getCurrentTime()
@@ -65,35 +68,35 @@ inline double EventCheckStopAlgorithm::getCurrentTime()
 	return (double)msec.time_since_epoch().count()/1000.0;
 }
 
-double EventCheckStopAlgorithm::s_interval = -1.0;
-double EventCheckStopAlgorithm::s_maxRunningTime = -1.0;
-double EventCheckStopAlgorithm::s_maxPopSize = 0;
+SimpactContext::Slot<EventCheckStopAlgorithmSettings> EventCheckStopAlgorithm::s_settings;
 
 void EventCheckStopAlgorithm::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventCheckStopAlgorithmSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("checkstop.interval", s_interval)) ||
-		!(r = config.getKeyValue("checkstop.max.runtime", s_maxRunningTime)) ||
-		!(r = config.getKeyValue("checkstop.max.popsize", s_maxPopSize)) )
+	if (!(r = config.getKeyValue("checkstop.interval", settings.m_interval)) ||
+		!(r = config.getKeyValue("checkstop.max.runtime", settings.m_maxRunningTime)) ||
+		!(r = config.getKeyValue("checkstop.max.popsize", settings.m_maxPopSize)) )
 		abortWithMessage(r.getErrorString());
 
-	if (isEnabled())
+	if (settings.m_interval > 0)
 	{
-		if (s_maxPopSize <= 0)
+		if (settings.m_maxPopSize <= 0)
 			abortWithMessage("Specified maximum population size must be positive");
-		if (s_maxRunningTime <= 0)
+		if (settings.m_maxRunningTime <= 0)
 			abortWithMessage("Specified running time (wallclock time, not simulation time!) must be positive");
 	}
 }
 
 void EventCheckStopAlgorithm::obtainConfig(ConfigWriter &config)
 {
+	const EventCheckStopAlgorithmSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("checkstop.interval", s_interval)) ||
-		!(r = config.addKey("checkstop.max.runtime", s_maxRunningTime)) ||
-		!(r = config.addKey("checkstop.max.popsize", s_maxPopSize)) )
+	if (!(r = config.addKey("checkstop.interval", settings.m_interval)) ||
+		!(r = config.addKey("checkstop.max.runtime", settings.m_maxRunningTime)) ||
+		!(r = config.addKey("checkstop.max.popsize", settings.m_maxPopSize)) )
 		abortWithMessage(r.getErrorString());
 }
 
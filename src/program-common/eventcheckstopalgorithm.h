@@ -4,6 +4,16 @@
 
 #include "simpactevent.h"
 
+class EventCheckStopAlgorithmSettings
+{
+public:
+	EventCheckStopAlgorithmSettings() : m_interval(-1.0), m_maxRunningTime(-1.0), m_maxPopSize(0)	{ }
+
+	double m_interval;
+	double m_maxRunningTime;
+	double m_maxPopSize;
+};
+
 class EventCheckStopAlgorithm : public SimpactEvent
 {
 public:
@@ -18,17 +28,15 @@ public:
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 
-	static bool isEnabled()																{ return s_interval > 0; }
-	static double getInterval()															{ return s_interval; }
+	static bool isEnabled(const SimpactContext &context)								{ return getInterval(context) > 0; }
+	static double getInterval(const SimpactContext &context)							{ return context.get(s_settings).m_interval; }
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 	static double getCurrentTime();
 
 	double m_startTime;
 
-	static double s_interval;
-	static double s_maxRunningTime;
-	static double s_maxPopSize;
+	static SimpactContext::Slot<EventCheckStopAlgorithmSettings> s_settings;
 };
 
 #endif // EVENTCHECKSTOPALGORITHM_H
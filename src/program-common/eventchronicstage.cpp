@@ -24,9 +24,10 @@ double EventChronicStage::getNewInternalTimeDifference(GslRandomNumberGenerator
 	assert(getNumberOfPersons() == 1);
 	assert(pPerson->hiv().isInfected());
 
-	assert(m_acuteTime > 0); 
+	double acuteTime = getAcuteStageTime(population.getContext());
+	assert(acuteTime > 0); 
 
-	double tEvt = pPerson->hiv().getInfectionTime() + m_acuteTime;
+	double tEvt = pPerson->hiv().getInfectionTime() + acuteTime;
 	double dt = tEvt - population.getTime();
 	
 	assert(dt >= 0); // should not be in the past!
@@ -45,7 +46,7 @@ std::string EventChronicStage::getDescription(double tNow) const
 void EventChronicStage::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(true, "chronicstage", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), true, "chronicstage", tNow, pPerson, 0);
 }
 
 void EventChronicStage::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -63,21 +64,23 @@ void EventChronicStage::fire(Algorithm *pAlgorithm, State *pState, double t)
 	population.onNewEvent(pEvt);
 }
 
-double EventChronicStage::m_acuteTime = -1;
+SimpactContext::Slot<EventChronicStageSettings> EventChronicStage::s_settings;
 
 void EventChronicStage::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventChronicStageSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("chronicstage.acutestagetime", m_acuteTime, 0)))
+	if (!(r = config.getKeyValue("chronicstage.acutestagetime", settings.m_acuteTime, 0)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventChronicStage::obtainConfig(ConfigWriter &config)
 {
+	const EventChronicStageSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("chronicstage.acutestagetime", m_acuteTime)))
+	if (!(r = config.addKey("chronicstage.acutestagetime", settings.m_acuteTime)))
 		abortWithMessage(r.getErrorString());
 }
 
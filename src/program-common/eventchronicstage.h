@@ -6,6 +6,14 @@
 
 class ConfigSettings;
 
+class EventChronicStageSettings
+{
+public:
+	EventChronicStageSettings() : m_acuteTime(-1)											{ }
+
+	double m_acuteTime;
+};
+
 class EventChronicStage : public SimpactEvent
 {
 public:
@@ -17,13 +25,13 @@ public:
 
 	void fire(Algorithm *pAlgorithm, State *pState, double t);
 
-	static double getAcuteStageTime() 							{ return m_acuteTime; }
+	static double getAcuteStageTime(const SimpactContext &context)			{ return context.get(s_settings).m_acuteTime; }
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
-	static double m_acuteTime;
+	static SimpactContext::Slot<EventChronicStageSettings> s_settings;
 };
 
 #endif // EVENTCHRONICSTAGE_H
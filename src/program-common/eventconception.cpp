@@ -13,8 +13,10 @@ EventConception::EventConception(Person *pPerson1, Person *pPerson2, double rela
 	assert(pPerson1 && pPerson2);
 	assert(pPerson1->isMan() && pPerson2->isWoman());
 
-	assert(m_pWSFProbDist);
-	m_WSF = m_pWSFProbDist->pickNumber();
+	const EventConceptionSettings &settings = pPerson1->getContext().get(s_settings);
+
+	assert(settings.m_pWSFProbDist);
+	m_WSF = settings.m_pWSFProbDist->pickNumber();
 	m_relationshipFormationTime = relationshipFormationTime;
 }
 
@@ -31,7 +33,7 @@ void EventConception::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson1 = getPerson(0);
 	Person *pPerson2 = getPerson(1);
-	writeEventLogStart(true, "conception", tNow, pPerson1, pPerson2);
+	writeEventLogStart(pop.getContext(), true, "conception", tNow, pPerson1, pPerson2);
 }
 
 void EventConception::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -114,54 +116,68 @@ double EventConception::getTMax(const Person *pPerson1, const Person *pPerson2)
 	if (tb2 < tMax)
 		tMax = tb2;
 
-	assert(m_tMax > 0);
-	tMax += m_tMax;
+	const EventConceptionSettings &settings = pPerson1->getContext().get(s_settings);
+
+	assert(settings.m_tMax > 0);
+	tMax += settings.m_tMax;
 	return tMax;
 }
 
-double EventConception::HazardFunctionConception::m_alphaBase = 0;
-double EventConception::HazardFunctionConception::m_alphaAgeMan = 0;
-double EventConception::HazardFunctionConception::m_alphaAgeWoman = 0;
-double EventConception::HazardFunctionConception::m_alphaWSF = 0;
-double EventConception::HazardFunctionConception::m_beta = 0;
+EventConceptionSettings::EventConceptionSettings()
+{
+	m_alphaBase = 0;
+	m_alphaAgeMan = 0;
+	m_alphaAgeWoman = 0;
+	m_alphaWSF = 0;
+	m_beta = 0;
+	m_tMax = 0;
+	m_pWSFProbDist = 0;
+}
 
-double EventConception::m_tMax = 0;
-ProbabilityDistribution *EventConception::m_pWSFProbDist = 0;
+EventConceptionSettings::~EventConceptionSettings()
+{
+	delete m_pWSFProbDist;
+}
+
+SimpactContext::Slot<EventConceptionSettings> EventConception::s_settings;
 
 void EventConception::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
-	if (m_pWSFProbDist)
+	EventConceptionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	if (settings.m_pWSFProbDist)
 	{
-		delete m_pWSFProbDist;
-		m_pWSFProbDist = 0;
+		delete settings.m_pWSFProbDist;
+		settings.m_pWSFProbDist = 0;
 	}
 
 	bool_t r;
 
-	if (!(r = config.getKeyValue("conception.alpha_base", HazardFunctionConception::m_alphaBase)) ||
-	    !(r = config.getKeyValue("conception.alpha_ageman", HazardFunctionConception::m_alphaAgeMan)) ||
-	    !(r = config.getKeyValue("conception.alpha_agewoman", HazardFunctionConception::m_alphaAgeWoman)) ||
-	    !(r = config.getKeyValue("conception.alpha_wsf", HazardFunctionConception::m_alphaWSF)) ||
-	    !(r = config.getKeyValue("conception.beta", HazardFunctionConception::m_beta)) ||
-	    !(r = config.getKeyValue("conception.t_max", m_tMax, 0))
+	if (!(r = config.getKeyValue("conception.alpha_base", settings.m_alphaBase)) ||
+	    !(r = config.getKeyValue("conception.alpha_ageman", settings.m_alphaAgeMan)) ||
+	    !(r = config.getKeyValue("conception.alpha_agewoman", settings.m_alphaAgeWoman)) ||
+	    !(r = config.getKeyValue("conception.alpha_wsf", settings.m_alphaWSF)) ||
+	    !(r = config.getKeyValue("conception.beta", settings.m_beta)) ||
+	    !(r = config.getKeyValue("conception.t_max", settings.m_tMax, 0))
 		)
 		abortWithMessage(r.getErrorString());
 
-	m_pWSFProbDist = getDistributionFromConfig(config, pRndGen, "conception.wsf");
+	settings.m_pWSFProbDist = getDistributionFromConfig(config, pRndGen, "conception.wsf");
 }
 
 void EventConception::obtainConfig(ConfigWriter &config)
 {
+	const EventConceptionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	addDistributionToConfig(m_pWSFProbDist, config, "conception.wsf");
+	addDistributionToConfig(settings.m_pWSFProbDist, config, "conception.wsf");
 
-	if (!(r = config.addKey("conception.alpha_base", HazardFunctionConception::m_alphaBase)) ||
-	    !(r = config.addKey("conception.alpha_ageman", HazardFunctionConception::m_alphaAgeMan)) ||
-	    !(r = config.addKey("conception.alpha_agewoman", HazardFunctionConception::m_alphaAgeWoman)) ||
-	    !(r = config.addKey("conception.alpha_wsf", HazardFunctionConception::m_alphaWSF)) ||
-	    !(r = config.addKey("conception.beta", HazardFunctionConception::m_beta)) ||
-	    !(r = config.addKey("conception.t_max", m_tMax))
+	if (!(r = config.addKey("conception.alpha_base", settings.m_alphaBase)) ||
+	    !(r = config.addKey("conception.alpha_ageman", settings.m_alphaAgeMan)) ||
+	    !(r = config.addKey("conception.alpha_agewoman", settings.m_alphaAgeWoman)) ||
+	    !(r = config.addKey("conception.alpha_wsf", settings.m_alphaWSF)) ||
+	    !(r = config.addKey("conception.beta", settings.m_beta)) ||
+	    !(r = config.addKey("conception.t_max", settings.m_tMax))
 		)
 		abortWithMessage(r.getErrorString());
 }
@@ -172,11 +188,13 @@ EventConception::HazardFunctionConception::HazardFunctionConception(const Person
 	assert(pMan && pWoman);
 	assert(pMan->isMan() && pWoman->isWoman());
 
+	const EventConceptionSettings &settings = pMan->getContext().get(s_settings);
+
 	double tBMan = pMan->getDateOfBirth();
 	double tBWoman = pWoman->getDateOfBirth();
 
-	double A = m_alphaBase - m_alphaAgeMan*tBMan - m_alphaAgeWoman*tBWoman + m_alphaWSF*WSF - m_beta*tRef;
-	double B = m_alphaAgeMan + m_alphaAgeWoman + m_beta;
+	double A = settings.m_alphaBase - settings.m_alphaAgeMan*tBMan - settings.m_alphaAgeWoman*tBWoman + settings.m_alphaWSF*WSF - settings.m_beta*tRef;
+	double B = settings.m_alphaAgeMan + settings.m_alphaAgeWoman + settings.m_beta;
 
 	// set the parameters of exp(A+B*t) in the base class
 	setAB(A, B);
@@ -7,6 +7,21 @@
 
 class ProbabilityDistribution;
 
+class EventConceptionSettings
+{
+public:
+	EventConceptionSettings();
+	~EventConceptionSettings();
+
+	double m_alphaBase;
+	double m_alphaAgeMan;
+	double m_alphaAgeWoman;
+	double m_alphaWSF;
+	double m_beta;
+	double m_tMax;
+	ProbabilityDistribution *m_pWSFProbDist;
+};
+
 class EventConception : public SimpactEvent
 {
 public:
@@ -29,21 +44,14 @@ private:
 	public:
 		HazardFunctionConception(const Person *pMan, const Person *pWoman, double WSF, double tRef);
 		~HazardFunctionConception();
-		
-		static double m_alphaBase;
-		static double m_alphaAgeMan;
-		static double m_alphaAgeWoman;
-		static double m_alphaWSF;
-		static double m_beta;
 	};
 
 	double m_WSF;
 	double m_relationshipFormationTime;
 
-	static double m_tMax;
-	static ProbabilityDistribution *m_pWSFProbDist;
-
 	static double getTMax(const Person *pPerson1, const Person *pPerson2);
+
+	static SimpactContext::Slot<EventConceptionSettings> s_settings;
 };
 
 #endif // EVENTCONCEPTION_H
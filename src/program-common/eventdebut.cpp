@@ -22,9 +22,10 @@ double EventDebut::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGe
 	assert(pPerson != 0);
 	assert(getNumberOfPersons() == 1);
 
-	assert(m_debutAge > 0);
+	double debutAge = getDebutAge(population.getContext());
+	assert(debutAge > 0);
 
-	double tEvt = pPerson->getDateOfBirth() + m_debutAge;
+	double tEvt = pPerson->getDateOfBirth() + debutAge;
 	double dt = tEvt - population.getTime();
 
 	return dt;
@@ -39,7 +40,7 @@ std::string EventDebut::getDescription(double tNow) const
 void EventDebut::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(true, "debut", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), true, "debut", tNow, pPerson, 0);
 }
 
 void EventDebut::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -57,21 +58,25 @@ void EventDebut::fire(Algorithm *pAlgorithm, State *pState, double t)
 		population.initializeFormationEvents(pPerson, false, false, t);
 }
 
-double EventDebut::m_debutAge = -1;
+SimpactContext::Slot<EventDebutSettings> EventDebut::s_settings;
 
 void EventDebut::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventDebutSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("debut.debutage", m_debutAge, 0, 100)))
+	if (!(r = config.getKeyValue("debut.debutage", settings.m_debutAge, 0, 100)))
 		abortWithMessage(r.getErrorString());
+
+	settings.m_paramGeneration++;
 }
 
 void EventDebut::obtainConfig(ConfigWriter &config)
 {
+	const EventDebutSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("debut.debutage", m_debutAge)))
+	if (!(r = config.addKey("debut.debutage", settings.m_debutAge)))
 		abortWithMessage(r.getErrorString());
 }
 
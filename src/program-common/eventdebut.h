@@ -6,6 +6,15 @@
 
 class ConfigSettings;
 
+class EventDebutSettings
+{
+public:
+	EventDebutSettings()									{ m_debutAge = -1; m_paramGeneration = 0; }
+
+	double m_debutAge;
+	int m_paramGeneration;
+};
+
 class EventDebut : public SimpactEvent
 {
 public:
@@ -17,13 +26,17 @@ public:
 
 	void fire(Algorithm *pAlgorithm, State *pState, double t);
 
-	static double getDebutAge()								{ return m_debutAge; }
+	static double getDebutAge(const SimpactContext &context)	{ return context.get(s_settings).m_debutAge; }
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
+
+	// Is increased each time the debut age is read (e.g. by an intervention), for
+	// cached hazard values that use it
+	static int getParamGeneration(const SimpactContext &context)	{ return context.get(s_settings).m_paramGeneration; }
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
-	static double m_debutAge;
+	static SimpactContext::Slot<EventDebutSettings> s_settings;
 };
 
 #endif // EVENTDEBUT_H
@@ -27,7 +27,7 @@ string EventDiagnosis::getDescription(double tNow) const
 void EventDiagnosis::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(true, "diagnosis", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), true, "diagnosis", tNow, pPerson, 0);
 }
 
 void EventDiagnosis::markOtherAffectedPeople(const PopulationStateInterface &population)
@@ -39,21 +39,13 @@ void EventDiagnosis::markOtherAffectedPeople(const PopulationStateInterface &pop
 	// affected!
 	int numRel = pPerson->getNumberOfRelationships();
 
-	pPerson->startRelationshipIteration();
 	for (int i = 0 ; i < numRel ; i++)
 	{
-		double tDummy;
-		Person *pPartner = pPerson->getNextRelationshipPartner(tDummy);
+		Person *pPartner = pPerson->getRelationshipPartner(i);
 
 		if (pPartner->hiv().isInfected())
 			population.markAffectedPerson(pPartner);
 	}
-
-#ifndef NDEBUG
-	// Double check that the iteration is done
-	double tDummy;
-	assert(pPerson->getNextRelationshipPartner(tDummy) == 0);
-#endif // NDEBUG
 }
 
 void EventDiagnosis::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -75,10 +67,11 @@ void EventDiagnosis::fire(Algorithm *pAlgorithm, State *pState, double t)
 double EventDiagnosis::calculateInternalTimeInterval(const State *pState, double t0, double dt)
 {
 	Person *pPerson = getPerson(0);
+	const EventDiagnosisSettings &settings = pPerson->getContext().get(s_settings);
 	double tMax = getTMax(pPerson);
 
-	HazardFunctionDiagnosis h0(pPerson, s_baseline, s_ageFactor, s_genderFactor, s_diagPartnersFactor,
-			           s_isDiagnosedFactor, s_beta, s_HSV2factor);
+	HazardFunctionDiagnosis h0(pPerson, settings.m_baseline, settings.m_ageFactor, settings.m_genderFactor, settings.m_diagPartnersFactor,
+			           settings.m_isDiagnosedFactor, settings.m_beta, settings.m_HSV2factor);
 	TimeLimitedHazardFunction h(h0, tMax);
 
 	return h.calculateInternalTimeInterval(t0, dt);
@@ -87,10 +80,11 @@ double EventDiagnosis::calculateInternalTimeInterval(const State *pState, double
 double EventDiagnosis::solveForRealTimeInterval(const State *pState, double Tdiff, double t0)
 {
 	Person *pPerson = getPerson(0);
+	const EventDiagnosisSettings &settings = pPerson->getContext().get(s_settings);
 	double tMax = getTMax(pPerson);
 
-	HazardFunctionDiagnosis h0(pPerson, s_baseline, s_ageFactor, s_genderFactor, s_diagPartnersFactor,
-			           s_isDiagnosedFactor, s_beta, s_HSV2factor);
+	HazardFunctionDiagnosis h0(pPerson, settings.m_baseline, settings.m_ageFactor, settings.m_genderFactor, settings.m_diagPartnersFactor,
+			           settings.m_isDiagnosedFactor, settings.m_beta, settings.m_HSV2factor);
 	TimeLimitedHazardFunction h(h0, tMax);
 
 	return h.solveForRealTimeInterval(t0, Tdiff);
@@ -100,49 +94,44 @@ double EventDiagnosis::getTMax(const Person *pPerson)
 {
 	assert(pPerson != 0);
 	double tb = pPerson->getDateOfBirth();
+	double tMax = pPerson->getContext().get(s_settings).m_tMax;
 
-	assert(s_tMax > 0);
-	return tb + s_tMax;
+	assert(tMax > 0);
+	return tb + tMax;
 }
 
-double EventDiagnosis::s_baseline = 0;
-double EventDiagnosis::s_ageFactor = 0;
-double EventDiagnosis::s_genderFactor = 0;
-double EventDiagnosis::s_diagPartnersFactor = 0;
-double EventDiagnosis::s_isDiagnosedFactor = 0;
-double EventDiagnosis::s_beta = 0;
-double EventDiagnosis::s_HSV2factor = 0;
-double EventDiagnosis::s_tMax = 0;
-
+SimpactContext::Slot<EventDiagnosisSettings> EventDiagnosis::s_settings;
 
 void EventDiagnosis::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventDiagnosisSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("diagnosis.baseline", s_baseline)) ||
-	    !(r = config.getKeyValue("diagnosis.agefactor", s_ageFactor)) ||
-	    !(r = config.getKeyValue("diagnosis.genderfactor", s_genderFactor)) ||
-	    !(r = config.getKeyValue("diagnosis.diagpartnersfactor", s_diagPartnersFactor)) ||
-	    !(r = config.getKeyValue("diagnosis.isdiagnosedfactor", s_isDiagnosedFactor)) ||
-	    !(r = config.getKeyValue("diagnosis.beta", s_beta)) ||
-	    !(r = config.getKeyValue("diagnosis.t_max", s_tMax))||
-	    !(r = config.getKeyValue("diagnosis.HSV2factor", s_HSV2factor))
+	if (!(r = config.getKeyValue("diagnosis.baseline", settings.m_baseline)) ||
+	    !(r = config.getKeyValue("diagnosis.agefactor", settings.m_ageFactor)) ||
+	    !(r = config.getKeyValue("diagnosis.genderfactor", settings.m_genderFactor)) ||
+	    !(r = config.getKeyValue("diagnosis.diagpartnersfactor", settings.m_diagPartnersFactor)) ||
+	    !(r = config.getKeyValue("diagnosis.isdiagnosedfactor", settings.m_isDiagnosedFactor)) ||
+	    !(r = config.getKeyValue("diagnosis.beta", settings.m_beta)) ||
+	    !(r = config.getKeyValue("diagnosis.t_max", settings.m_tMax))||
+	    !(r = config.getKeyValue("diagnosis.HSV2factor", settings.m_HSV2factor))
 	   )
 		abortWithMessage(r.getErrorString());
 }
 
 void EventDiagnosis::obtainConfig(ConfigWriter &config)
 {
+	const EventDiagnosisSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("diagnosis.baseline", s_baseline)) ||
-	    !(r = config.addKey("diagnosis.agefactor", s_ageFactor)) ||
-	    !(r = config.addKey("diagnosis.genderfactor", s_genderFactor)) ||
-	    !(r = config.addKey("diagnosis.diagpartnersfactor", s_diagPartnersFactor)) ||
-	    !(r = config.addKey("diagnosis.isdiagnosedfactor", s_isDiagnosedFactor)) ||
-	    !(r = config.addKey("diagnosis.beta", s_beta)) ||
-	    !(r = config.addKey("diagnosis.t_max", s_tMax)) ||
-	    !(r = config.addKey("diagnosis.HSV2factor", s_HSV2factor))
+	if (!(r = config.addKey("diagnosis.baseline", settings.m_baseline)) ||
+	    !(r = config.addKey("diagnosis.agefactor", settings.m_ageFactor)) ||
+	    !(r = config.addKey("diagnosis.genderfactor", settings.m_genderFactor)) ||
+	    !(r = config.addKey("diagnosis.diagpartnersfactor", settings.m_diagPartnersFactor)) ||
+	    !(r = config.addKey("diagnosis.isdiagnosedfactor", settings.m_isDiagnosedFactor)) ||
+	    !(r = config.addKey("diagnosis.beta", settings.m_beta)) ||
+	    !(r = config.addKey("diagnosis.t_max", settings.m_tMax)) ||
+	    !(r = config.addKey("diagnosis.HSV2factor", settings.m_HSV2factor))
 	   )
 		abortWithMessage(r.getErrorString());
 }
@@ -23,6 +23,22 @@ private:
 	const double m_isDiagnosedFactor, m_beta, m_HSV2factor;
 };
 
+class EventDiagnosisSettings
+{
+public:
+	EventDiagnosisSettings() : m_baseline(0), m_ageFactor(0), m_genderFactor(0), m_diagPartnersFactor(0),
+	                           m_isDiagnosedFactor(0), m_beta(0), m_tMax(0), m_HSV2factor(0)		{ }
+
+	double m_baseline;
+	double m_ageFactor;
+	double m_genderFactor;
+	double m_diagPartnersFactor;
+	double m_isDiagnosedFactor;
+	double m_beta;
+	double m_tMax;
+	double m_HSV2factor; 
+};
+
 class EventDiagnosis : public SimpactEvent
 {
 public:
@@ -45,14 +61,7 @@ private:
 	double solveForRealTimeInterval(const State *pState, double Tdiff, double t0);
 	static double getTMax(const Person *pPerson);
 
-	static double s_baseline;
-	static double s_ageFactor;
-	static double s_genderFactor;
-	static double s_diagPartnersFactor;
-	static double s_isDiagnosedFactor;
-	static double s_beta;
-	static double s_tMax;
-	static double s_HSV2factor; 
+	static SimpactContext::Slot<EventDiagnosisSettings> s_settings;
 };
 
 #endif // EVENTDIAGNOSIS_H
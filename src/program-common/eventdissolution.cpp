@@ -42,7 +42,7 @@ void EventDissolution::writeLogs(const SimpactPopulation &pop, double tNow) cons
 	Person *pPerson2 = getPerson(1);
 
 	string evtName = (pPerson2->isWoman()) ? "formation" : "formationmsm";
-	writeEventLogStart(true, "dissolution", tNow, pPerson1, pPerson2);
+	writeEventLogStart(pop.getContext(), true, "dissolution", tNow, pPerson1, pPerson2);
 
 	// Relationship log will be written when handling the dissolution in person.cpp, that way
 	// it will also be handled when it's because someone dies
@@ -65,49 +65,69 @@ void EventDissolution::fire(Algorithm *pAlgorithm, State *pState, double t)
 		EventFormation *pFormationEvent = new EventFormation(pPerson1, pPerson2, t, t);
 		population.onNewEvent(pFormationEvent);
 	}
+
+	// Events that depend on the relationship (e.g. transmission, conception) are
+	// in the lists of both persons, so we only need to check one of them
+	population.removeUselessEvents(pPerson1);
 }
 
-double EventDissolution::calculateInternalTimeInterval(const State *pState, double t0, double dt)
+EvtHazard *EventDissolution::getHazard(const SimpactPopulation &population) const
 {
-	Person *pPerson2 = getPerson(1);
-	EvtHazard *pHazard = (pPerson2->isWoman()) ? s_pHazard : s_pHazardMSM; 
+	const EventDissolutionSettings &settings = population.getContext().get(s_settings);
+	EvtHazard *pHazard = (getPerson(1)->isWoman()) ? settings.m_pHazard : settings.m_pHazardMSM; 
+
 	assert(pHazard != 0);
+	return pHazard;
+}
 
+double EventDissolution::calculateInternalTimeInterval(const State *pState, double t0, double dt)
+{
 	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
-	return pHazard->calculateInternalTimeInterval(population, *this, t0, dt);
+	return getHazard(population)->calculateInternalTimeInterval(population, *this, t0, dt);
 }
 
 double EventDissolution::solveForRealTimeInterval(const State *pState, double Tdiff, double t0)
 {
-	Person *pPerson2 = getPerson(1);
-	EvtHazard *pHazard = (pPerson2->isWoman()) ? s_pHazard : s_pHazardMSM; 
-	assert(pHazard != 0);
-
 	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
-	return pHazard->solveForRealTimeInterval(population, *this, Tdiff, t0);
+	return getHazard(population)->solveForRealTimeInterval(population, *this, Tdiff, t0);
 }
 
-EvtHazard *EventDissolution::s_pHazard = 0;
-EvtHazard *EventDissolution::s_pHazardMSM = 0;
+EventDissolutionSettings::EventDissolutionSettings()
+{
+	m_pHazard = 0;
+	m_pHazardMSM = 0;
+}
+
+EventDissolutionSettings::~EventDissolutionSettings()
+{
+	delete m_pHazard;
+	delete m_pHazardMSM;
+}
+
+SimpactContext::Slot<EventDissolutionSettings> EventDissolution::s_settings;
 
 void EventDissolution::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
-	delete s_pHazard;
-	s_pHazard = EvtHazardDissolution::processConfig(config, "dissolution", false);
+	EventDissolutionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 
-	delete s_pHazardMSM;
-	s_pHazardMSM = EvtHazardDissolution::processConfig(config, "dissolutionmsm", true);
+	delete settings.m_pHazard;
+	settings.m_pHazard = EvtHazardDissolution::processConfig(config, "dissolution", false);
+
+	delete settings.m_pHazardMSM;
+	settings.m_pHazardMSM = EvtHazardDissolution::processConfig(config, "dissolutionmsm", true);
 }
 
 void EventDissolution::obtainConfig(ConfigWriter &config)
 {
-	if (!s_pHazard)
-		abortWithMessage("EventDissolution::obtainConfig: s_pHazard is null");
-	if (!s_pHazardMSM)
-		abortWithMessage("EventDissolution::obtainConfig: s_pHazardMSM is null");
+	const EventDissolutionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	if (!settings.m_pHazard)
+		abortWithMessage("EventDissolution::obtainConfig: m_pHazard is null");
+	if (!settings.m_pHazardMSM)
+		abortWithMessage("EventDissolution::obtainConfig: m_pHazardMSM is null");
 
-	s_pHazard->obtainConfig(config, "dissolution");
-	s_pHazardMSM->obtainConfig(config, "dissolutionmsm");
+	settings.m_pHazard->obtainConfig(config, "dissolution");
+	settings.m_pHazardMSM->obtainConfig(config, "dissolutionmsm");
 }
 
 ConfigFunctions dissolutionConfigFunctions(EventDissolution::processConfig, EventDissolution::obtainConfig, "EventDissolution");
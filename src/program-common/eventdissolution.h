@@ -7,6 +7,16 @@
 class ConfigSettings;
 class EvtHazard;
 
+class EventDissolutionSettings
+{
+public:
+	EventDissolutionSettings();
+	~EventDissolutionSettings();
+
+	EvtHazard *m_pHazard;
+	EvtHazard *m_pHazardMSM;
+};
+
 class EventDissolution : public SimpactEvent
 {
 public:
@@ -25,10 +35,11 @@ protected:
 	double calculateInternalTimeInterval(const State *pState, double t0, double dt);
 	double solveForRealTimeInterval(const State *pState, double Tdiff, double t0);
 
+	EvtHazard *getHazard(const SimpactPopulation &population) const;
+
 	double m_formationTime;
 
-	static EvtHazard *s_pHazard;
-	static EvtHazard *s_pHazardMSM;
+	static SimpactContext::Slot<EventDissolutionSettings> s_settings;
 };
 
 #endif // EVENTDISSOLUTION_H
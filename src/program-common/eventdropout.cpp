@@ -29,7 +29,7 @@ string EventDropout::getDescription(double tNow) const
 void EventDropout::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(true, "dropout", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), true, "dropout", tNow, pPerson, 0);
 }
 
 void EventDropout::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -52,14 +52,15 @@ double EventDropout::getNewInternalTimeDifference(GslRandomNumberGenerator *pRnd
 {
 	// TODO: this is just a temporaty solution, until a real hazard has been defined
 	
+	const EventDropoutSettings &settings = SIMPACTPOPULATION(pState).getContext().get(s_settings);
 	int count = 0;
 	int maxCount = 1024;
 	double dt = -1;
 
-	assert(s_pDropoutDistribution);
+	assert(settings.m_pDropoutDistribution);
 
 	while (dt < 0 && count++ < maxCount)
-		dt = s_pDropoutDistribution->pickNumber();
+		dt = settings.m_pDropoutDistribution->pickNumber();
 
 	if (dt < 0)
 		abortWithMessage("EventDropout: couldn't find a positive time interval for next event");
@@ -79,17 +80,26 @@ double EventDropout::solveForRealTimeInterval(const State *pState, double Tdiff,
 	return Tdiff;
 }
 
-ProbabilityDistribution *EventDropout::s_pDropoutDistribution = 0;
+EventDropoutSettings::~EventDropoutSettings()
+{
+	delete m_pDropoutDistribution;
+}
+
+SimpactContext::Slot<EventDropoutSettings> EventDropout::s_settings;
 
 void EventDropout::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
-	delete s_pDropoutDistribution;
-	s_pDropoutDistribution = getDistributionFromConfig(config, pRndGen, "dropout.interval");
+	EventDropoutSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	delete settings.m_pDropoutDistribution;
+	settings.m_pDropoutDistribution = getDistributionFromConfig(config, pRndGen, "dropout.interval");
 }
 
 void EventDropout::obtainConfig(ConfigWriter &config)
 {
-	addDistributionToConfig(s_pDropoutDistribution, config, "dropout.interval");
+	const EventDropoutSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	addDistributionToConfig(settings.m_pDropoutDistribution, config, "dropout.interval");
 }
 
 ConfigFunctions dropoutConfigFunctions(EventDropout::processConfig, EventDropout::obtainConfig, "EventDropout");
@@ -8,6 +8,15 @@ class ConfigSettings;
 class ConfigWriter;
 class ProbabilityDistribution;
 
+class EventDropoutSettings
+{
+public:
+	EventDropoutSettings() : m_pDropoutDistribution(0)										{ }
+	~EventDropoutSettings();
+
+	ProbabilityDistribution *m_pDropoutDistribution;
+};
+
 class EventDropout : public SimpactEvent
 {
 public:
@@ -27,7 +36,7 @@ private:
 
 	double m_treatmentStartTime;
 
-	static ProbabilityDistribution *s_pDropoutDistribution;
+	static SimpactContext::Slot<EventDropoutSettings> s_settings;
 };
 
 #endif // EVENTDROPOUT_H
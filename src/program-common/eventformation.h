@@ -3,10 +3,24 @@
 #define EVENTFORMATION_H
 
 #include "simpactevent.h"
+#include <algorithm>
 
 class ConfigSettings;
 class EvtHazard;
 
+class EventFormationSettings
+{
+public:
+	EventFormationSettings();
+	~EventFormationSettings();
+
+	EvtHazard *m_pHazard;
+	EvtHazard *m_pHazardMSM;
+	bool m_batchSolve;
+	bool m_thinning;
+	int m_hazardGeneration;
+};
+
 class EventFormation : public SimpactEvent
 {
 public:
@@ -22,21 +36,66 @@ public:
 
 	double getLastDissolutionTime() const								{ return m_lastDissolutionTime; }
 
+	// The part of the hazard's a0 parameter that only depends on the eagerness of both
+	// persons and on the distance between them. It is calculated when the event is
+	// created, and only again if someone relocated or if the hazard was reconfigured.
+	double getPairTerm() const;
+
+	int getSyncDependencies() const;
+
+	// Returns true if the last event time calculation used an upper bound for the hazard,
+	// in which case the event time is only a candidate time
+	bool usesThinning() const											{ return !(m_thinningBound < 0); }
+	bool acceptCandidateTime(GslRandomNumberGenerator *pRndGen, const State *pState, double t) override;
+
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 protected:
 	static EvtHazard *getHazard(ConfigSettings &config, const std::string &prefix, bool msm);
+	const EventFormationSettings &getSettings() const								{ return getPerson(0)->getContext().get(s_settings); }
+	EvtHazard *getHazard() const;
 
 	double calculateInternalTimeInterval(const State *pState, double t0, double dt);
 	double solveForRealTimeInterval(const State *pState, double Tdiff, double t0);
+	EventBatchSolver *getBatchSolver(const State *pState);
 	bool isUseless(const PopulationStateInterface &population) override;
+	void calculatePairTerm() const;
+	double getPairLocationTime() const;
 
 	const double m_lastDissolutionTime;
 	const double m_formationScheduleTime;
+	double m_thinningBound; // negative if thinning isn't used
+
+	mutable double m_pairTerm;
+	mutable double m_pairTermLocationTime;
+	mutable int m_pairTermGeneration;
 
-	static EvtHazard *m_pHazard;
-	static EvtHazard *m_pHazardMSM;
+	static SimpactContext::Slot<EventFormationSettings> s_settings;
 };
 
+inline EvtHazard *EventFormation::getHazard() const
+{
+	const EventFormationSettings &settings = getSettings();
+	EvtHazard *pHazard = (getPerson(1)->isWoman()) ? settings.m_pHazard : settings.m_pHazardMSM; 
+
+	assert(pHazard != 0);
+	return pHazard;
+}
+
+inline double EventFormation::getPairLocationTime() const
+{
+	return std::max(getPerson(0)->getLocationTime(), getPerson(1)->getLocationTime());
+}
+
+// If the locations don't matter, the formation events are not discarded when
+// someone relocates (see isUseless), so we need to check this here as well
+inline double EventFormation::getPairTerm() const
+{
+	if (m_pairTermGeneration != getSettings().m_hazardGeneration || m_pairTermLocationTime != getPairLocationTime())
+		calculatePairTerm();
+
+	return m_pairTerm;
+}
+
 #endif // EVENTFORMATION_H
 
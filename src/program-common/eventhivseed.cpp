@@ -21,7 +21,7 @@ EventHIVSeed::~EventHIVSeed()
 
 double EventHIVSeed::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	return EventSeedBase::getNewInternalTimeDifference(s_settings, pRndGen, pState);
+	return EventSeedBase::getNewInternalTimeDifference(SIMPACTPOPULATION(pState).getContext().get(s_settings), pRndGen, pState);
 }
 
 string EventHIVSeed::getDescription(double tNow) const
@@ -31,24 +31,24 @@ string EventHIVSeed::getDescription(double tNow) const
 
 void EventHIVSeed::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "HIV seeding", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "HIV seeding", tNow, 0, 0);
 }
 
 void EventHIVSeed::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
-	EventSeedBase::fire(s_settings, t, pState, EventHIVTransmission::infectPerson);
+	EventSeedBase::fire(SIMPACTPOPULATION(pState).getContext().get(s_settings), t, pState, EventHIVTransmission::infectPerson);
 }
 
-SeedEventSettings EventHIVSeed::s_settings;
+SimpactContext::Slot<SeedEventSettings> EventHIVSeed::s_settings;
 
 void EventHIVSeed::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
-	EventSeedBase::processConfig(s_settings, config, pRndGen, "hivseed");
+	EventSeedBase::processConfig(SimpactContext::getConfigContext().get(s_settings), config, pRndGen, "hivseed");
 }
 
 void EventHIVSeed::obtainConfig(ConfigWriter &config)
 {
-	EventSeedBase::obtainConfig(s_settings, config, "hivseed");
+	EventSeedBase::obtainConfig(SimpactContext::getConfigContext().get(s_settings), config, "hivseed");
 }
 
 ConfigFunctions hivseedingConfigFunctions(EventHIVSeed::processConfig, EventHIVSeed::obtainConfig, "EventHIVSeed");
@@ -23,6 +23,8 @@ EventHIVTransmission::EventHIVTransmission(Person *pPerson1, Person *pPerson2) :
 
 	// Person one must not be in the _final_ AIDS stage yet
 	assert(pPerson1->hiv().getInfectionStage() != Person_HIV::AIDSFinal);
+
+	m_cachedHazard = -1;
 }
 
 EventHIVTransmission::~EventHIVTransmission()
@@ -38,10 +40,10 @@ void EventHIVTransmission::writeLogs(const SimpactPopulation &pop, double tNow)
 {
 	Person *pPerson1 = getPerson(0);
 	Person *pPerson2 = getPerson(1);
-	writeEventLogStart(false, "transmission", tNow, pPerson1, pPerson2);
+	writeEventLogStart(pop.getContext(), false, "transmission", tNow, pPerson1, pPerson2);
 
 	double VspOrigin = pPerson1->hiv().getSetPointViralLoad();
-	LogEvent.print(",originSPVL,%10.10f", VspOrigin);
+	LogSystem::get(pop.getContext()).logEvents.print(",originSPVL,%10.10f", VspOrigin);
 }
 
 // The dissolution event that makes this event useless involves the exact same people,
@@ -114,12 +116,10 @@ void EventHIVTransmission::infectPerson(SimpactPopulation &population, Person *p
 	// Check relationships pTarget is in, and if the partner is not yet infected, schedule
 	// a transmission event.
 	int numRelations = pTarget->getNumberOfRelationships();
-	pTarget->startRelationshipIteration();
 	
 	for (int i = 0 ; i < numRelations ; i++)
 	{
-		double formationTime = -1;
-		Person *pPartner = pTarget->getNextRelationshipPartner(formationTime);
+		Person *pPartner = pTarget->getRelationshipPartner(i);
 
 		if (!pPartner->hiv().isInfected())
 		{
@@ -127,11 +127,6 @@ void EventHIVTransmission::infectPerson(SimpactPopulation &population, Person *p
 			population.onNewEvent(pEvtTrans);
 		}
 	}
-
-#ifndef NDEBUG
-	double tDummy;
-	assert(pTarget->getNextRelationshipPartner(tDummy) == 0);
-#endif // NDEBUG
 }
 
 void EventHIVTransmission::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -148,19 +143,6 @@ void EventHIVTransmission::fire(Algorithm *pAlgorithm, State *pState, double t)
 	infectPerson(population, pPerson1, pPerson2, t);
 }
 
-double EventHIVTransmission::s_a = 0;
-double EventHIVTransmission::s_b = 0;
-double EventHIVTransmission::s_c = 0;
-double EventHIVTransmission::s_d1 = 0;
-double EventHIVTransmission::s_d2 = 0;
-double EventHIVTransmission::s_e1 = 0; 
-double EventHIVTransmission::s_e2 = 0; 
-double EventHIVTransmission::s_f1 = 0;
-double EventHIVTransmission::s_f2 = 0;
-double EventHIVTransmission::s_g1 = 0;
-double EventHIVTransmission::s_g2 = 0;
-double EventHIVTransmission::s_tMaxAgeRefDiff = -1;
-
 double EventHIVTransmission::calculateInternalTimeInterval(const State *pState, double t0, double dt)
 {
 	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
@@ -188,12 +170,64 @@ int EventHIVTransmission::getH(const Person *pPerson)
 	return H;
 } 
 
+int EventHIVTransmission::getSyncDependencies() const
+{
+	const Person *pPerson2 = getPerson(1);
+	const EventHIVTransmissionSettings &settings = getSettings(pPerson2->getContext());
+
+	return (settings.m_f1 != 0 && pPerson2->isWoman())?SyncReferenceYear:0;
+}
+
+void EventHIVTransmission::getHazardStamp(const SimpactPopulation &population, HazardStamp &stamp)
+{
+	Person *pPerson1 = getPerson(0);
+	Person *pPerson2 = getPerson(1);
+	const EventHIVTransmissionSettings &settings = getSettings(population.getContext());
+
+	stamp.m_paramGeneration = settings.m_generation;
+	stamp.m_viralLoadParamGeneration = Person_HIV::getParamGeneration(population.getContext());
+	stamp.m_debutParamGeneration = EventDebut::getParamGeneration(population.getContext());
+	stamp.m_stage = (int)pPerson1->hiv().getInfectionStage();
+	stamp.m_Vsp = pPerson1->hiv().getSetPointViralLoad();
+	stamp.m_Pi = pPerson1->getNumberOfRelationships();
+	stamp.m_Pj = pPerson2->getNumberOfRelationships();
+	stamp.m_H1 = getH(pPerson1);
+	stamp.m_H2 = getH(pPerson2);
+	stamp.m_ageRefYear = (settings.m_f1 != 0 && pPerson2->isWoman())?population.getReferenceYear():-1;
+}
+
 double EventHIVTransmission::calculateHazardFactor(const SimpactPopulation &population, double t0)
+{
+	HazardStamp stamp;
+
+	getHazardStamp(population, stamp);
+	if (stamp.m_ageRefYear >= 0)
+		checkAgeRefYear(stamp.m_ageRefYear, t0, getSettings(population.getContext()).m_tMaxAgeRefDiff);
+
+	if (m_cachedHazard >= 0 && stamp == m_hazardStamp)
+		return m_cachedHazard;
+
+	m_hazardStamp = stamp;
+	m_cachedHazard = calculateHazardFactorNoCache(population, t0);
+	return m_cachedHazard;
+}
+
+// Make sure we're up-to-date to use our approximation
+void EventHIVTransmission::checkAgeRefYear(double ageRefYear, double t0, double tMaxAgeRefDiff)
+{
+	if (t0 - ageRefYear < -1e-8)
+		abortWithMessage("EventHIVTransmission: t0 is smaller than ageRefYear");
+	if (t0 - ageRefYear > tMaxAgeRefDiff+1e-8)
+		abortWithMessage("EventHIVTransmission: t0 - ageRefYear exceeds maximum specified difference");
+}
+
+double EventHIVTransmission::calculateHazardFactorNoCache(const SimpactPopulation &population, double t0)
 {
 	// Person1 is the infected person and his/her viral load (set-point or acute) determines
 	// the hazard
 	Person *pPerson1 = getPerson(0);
 	Person *pPerson2 = getPerson(1);
+	const EventHIVTransmissionSettings &settings = getSettings(population.getContext());
 
 	double Pi = pPerson1->getNumberOfRelationships();
 	double Pj = pPerson2->getNumberOfRelationships();
@@ -201,67 +235,93 @@ double EventHIVTransmission::calculateHazardFactor(const SimpactPopulation &popu
 	double V = pPerson1->hiv().getViralLoad();
 	assert(V > 0);
 	
-	assert(s_a != 0);
-	assert(s_b != 0);
-	assert(s_c != 0);
+	assert(settings.m_a != 0);
+	assert(settings.m_b != 0);
+	assert(settings.m_c != 0);
 
-	double logh = s_a + s_b * std::pow(V,-s_c) + s_d1*Pi + s_d2*Pj + s_e1*getH(pPerson1) + s_e2*getH(pPerson2) + s_g1*pPerson2->hiv().getHazardB0Parameter() + s_g2*pPerson2->hiv().getHazardB1Parameter();
+	double logh = settings.m_a + settings.m_b * std::pow(V,-settings.m_c) + settings.m_d1*Pi + settings.m_d2*Pj + settings.m_e1*getH(pPerson1) + settings.m_e2*getH(pPerson2) + settings.m_g1*pPerson2->hiv().getHazardB0Parameter() + settings.m_g2*pPerson2->hiv().getHazardB1Parameter();
 
-	if (s_f1 != 0 && pPerson2->isWoman())
+	if (settings.m_f1 != 0 && pPerson2->isWoman())
 	{
 		double ageRefYear = population.getReferenceYear();
 
-		// Make sure we're up-to-date to use our approximation
-		if (t0 - ageRefYear < -1e-8)
-			abortWithMessage("EventHIVTransmission: t0 is smaller than ageRefYear");
-		if (t0 - ageRefYear > s_tMaxAgeRefDiff+1e-8)
-			abortWithMessage("EventHIVTransmission: t0 - ageRefYear exceeds maximum specified difference");
-
 		// Here we use the reference year as an approximation
-		double ageDiff = pPerson2->getAgeAt(ageRefYear) - EventDebut::getDebutAge();
+		double ageDiff = pPerson2->getAgeAt(ageRefYear) - EventDebut::getDebutAge(population.getContext());
 		
-		logh += s_f1*std::exp(s_f2*ageDiff);
+		logh += settings.m_f1*std::exp(settings.m_f2*ageDiff);
 	}
 
 	return std::exp(logh);
 }
 
+EventHIVTransmissionSettings::EventHIVTransmissionSettings()
+{
+	m_a = 0;
+	m_b = 0;
+	m_c = 0;
+	m_d1 = 0;
+	m_d2 = 0;
+	m_e1 = 0;
+	m_e2 = 0;
+	m_f1 = 0;
+	m_f2 = 0;
+	m_g1 = 0;
+	m_g2 = 0;
+	m_tMaxAgeRefDiff = -1;
+	m_generation = 0;
+}
+
+SimpactContext::Slot<EventHIVTransmissionSettings> EventHIVTransmission::s_settings;
+
+// Key handles, so that the strings are only hashed once, even if an intervention
+// causes these settings to be read again
+static const ConfigKey s_keyA("hivtransmission.param.a"), s_keyB("hivtransmission.param.b"),
+                       s_keyC("hivtransmission.param.c"), s_keyD1("hivtransmission.param.d1"),
+                       s_keyD2("hivtransmission.param.d2"), s_keyE1("hivtransmission.param.e1"),
+                       s_keyE2("hivtransmission.param.e2"), s_keyF1("hivtransmission.param.f1"),
+                       s_keyF2("hivtransmission.param.f2"), s_keyG1("hivtransmission.param.g1"),
+                       s_keyG2("hivtransmission.param.g2"), s_keyMaxAgeRefDiff("hivtransmission.maxageref.diff");
+
 void EventHIVTransmission::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventHIVTransmissionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("hivtransmission.param.a", s_a)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.b", s_b)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.c", s_c)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.d1", s_d1)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.d2", s_d2)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.e1", s_e1)) || 
-	    !(r = config.getKeyValue("hivtransmission.param.e2", s_e2)) || 
-	    !(r = config.getKeyValue("hivtransmission.param.f1", s_f1)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.f2", s_f2)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.g1", s_g1)) ||
-	    !(r = config.getKeyValue("hivtransmission.param.g2", s_g2)) ||
-		!(r = config.getKeyValue("hivtransmission.maxageref.diff", s_tMaxAgeRefDiff)) )
+	if (!(r = config.getKeyValue(s_keyA, settings.m_a)) ||
+	    !(r = config.getKeyValue(s_keyB, settings.m_b)) ||
+	    !(r = config.getKeyValue(s_keyC, settings.m_c)) ||
+	    !(r = config.getKeyValue(s_keyD1, settings.m_d1)) ||
+	    !(r = config.getKeyValue(s_keyD2, settings.m_d2)) ||
+	    !(r = config.getKeyValue(s_keyE1, settings.m_e1)) || 
+	    !(r = config.getKeyValue(s_keyE2, settings.m_e2)) || 
+	    !(r = config.getKeyValue(s_keyF1, settings.m_f1)) ||
+	    !(r = config.getKeyValue(s_keyF2, settings.m_f2)) ||
+	    !(r = config.getKeyValue(s_keyG1, settings.m_g1)) ||
+	    !(r = config.getKeyValue(s_keyG2, settings.m_g2)) ||
+		!(r = config.getKeyValue(s_keyMaxAgeRefDiff, settings.m_tMaxAgeRefDiff)) )
 		
 		abortWithMessage(r.getErrorString());
+
+	settings.m_generation++;
 }
 
 void EventHIVTransmission::obtainConfig(ConfigWriter &config)
 {
+	const EventHIVTransmissionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("hivtransmission.param.a", s_a)) ||
-	    !(r = config.addKey("hivtransmission.param.b", s_b)) ||
-	    !(r = config.addKey("hivtransmission.param.c", s_c)) ||
-	    !(r = config.addKey("hivtransmission.param.d1", s_d1)) ||
-	    !(r = config.addKey("hivtransmission.param.d2", s_d2)) ||
-		!(r = config.addKey("hivtransmission.param.e1", s_e1)) || 
-	    !(r = config.addKey("hivtransmission.param.e2", s_e2)) || 
-		!(r = config.addKey("hivtransmission.param.f1", s_f1)) ||
-		!(r = config.addKey("hivtransmission.param.f2", s_f2)) ||
-		!(r = config.addKey("hivtransmission.param.g1", s_g1)) ||
-		!(r = config.addKey("hivtransmission.param.g2", s_g2)) ||
-		!(r = config.addKey("hivtransmission.maxageref.diff", s_tMaxAgeRefDiff))
+	if (!(r = config.addKey("hivtransmission.param.a", settings.m_a)) ||
+	    !(r = config.addKey("hivtransmission.param.b", settings.m_b)) ||
+	    !(r = config.addKey("hivtransmission.param.c", settings.m_c)) ||
+	    !(r = config.addKey("hivtransmission.param.d1", settings.m_d1)) ||
+	    !(r = config.addKey("hivtransmission.param.d2", settings.m_d2)) ||
+		!(r = config.addKey("hivtransmission.param.e1", settings.m_e1)) || 
+	    !(r = config.addKey("hivtransmission.param.e2", settings.m_e2)) || 
+		!(r = config.addKey("hivtransmission.param.f1", settings.m_f1)) ||
+		!(r = config.addKey("hivtransmission.param.f2", settings.m_f2)) ||
+		!(r = config.addKey("hivtransmission.param.g1", settings.m_g1)) ||
+		!(r = config.addKey("hivtransmission.param.g2", settings.m_g2)) ||
+		!(r = config.addKey("hivtransmission.maxageref.diff", settings.m_tMaxAgeRefDiff))
 		)
 		
 		abortWithMessage(r.getErrorString());
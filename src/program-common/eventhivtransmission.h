@@ -6,6 +6,17 @@
 
 class ConfigSettings;
 
+// The parameters of the HIV transmission hazard (the 'hivtransmission.' settings)
+class EventHIVTransmissionSettings
+{
+public:
+	EventHIVTransmissionSettings();
+
+	double m_a, m_b, m_c, m_d1, m_d2, m_e1, m_e2, m_f1, m_f2, m_g1, m_g2;
+	double m_tMaxAgeRefDiff;
+	int m_generation; // is increased when the parameters change (e.g. by an intervention)
+};
+
 class EventHIVTransmission : public SimpactEvent
 {
 public:
@@ -18,31 +29,47 @@ public:
 
 	void fire(Algorithm *pAlgorithm, State *pState, double t);
 
+	// The reference year is only used in the hazard if a woman can get infected
+	int getSyncDependencies() const;
+
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
-	static double getParamB()																		{ return s_b; }
-	static double getParamC()																		{ return s_c; }
 
 	static void infectPerson(SimpactPopulation &population, Person *pOrigin, Person *pTarget, double t);
+
+	// The viral load of a person also depends on the 'b' and 'c' parameters
+	static const EventHIVTransmissionSettings &getSettings(const SimpactContext &context)	{ return context.get(s_settings); }
 protected:
 	double calculateInternalTimeInterval(const State *pState, double t0, double dt);
 	double solveForRealTimeInterval(const State *pState, double Tdiff, double t0);
 	bool isUseless(const PopulationStateInterface &population) override;
 	double calculateHazardFactor(const SimpactPopulation &population, double t0);
+	double calculateHazardFactorNoCache(const SimpactPopulation &population, double t0);
+	static void checkAgeRefYear(double ageRefYear, double t0, double tMaxAgeRefDiff);
+
+	// The values the hazard depends on, so we can check if the hazard itself
+	// can have changed without having to recalculate it
+	class HazardStamp
+	{
+	public:
+		HazardStamp()																	{ m_paramGeneration = -1; m_viralLoadParamGeneration = -1; m_debutParamGeneration = -1; m_stage = -1; m_Pi = -1; m_Pj = -1; m_H1 = -1; m_H2 = -1; m_Vsp = -1; m_ageRefYear = -1; }
+		bool operator==(const HazardStamp &s) const										{ return m_paramGeneration == s.m_paramGeneration && m_viralLoadParamGeneration == s.m_viralLoadParamGeneration && m_debutParamGeneration == s.m_debutParamGeneration && m_stage == s.m_stage && m_Pi == s.m_Pi && m_Pj == s.m_Pj && m_H1 == s.m_H1 && m_H2 == s.m_H2 && m_Vsp == s.m_Vsp && m_ageRefYear == s.m_ageRefYear; }
+
+		// Besides the transmission parameters themselves, the hazard uses the viral load
+		// settings of Person_HIV and the debut age
+		int m_paramGeneration, m_viralLoadParamGeneration, m_debutParamGeneration;
+		int m_stage, m_Pi, m_Pj, m_H1, m_H2;
+		double m_Vsp, m_ageRefYear;
+	};
+
+	void getHazardStamp(const SimpactPopulation &population, HazardStamp &stamp);
+
+	HazardStamp m_hazardStamp;
+	double m_cachedHazard;
 
-	static double s_a;
-	static double s_b;
-	static double s_c;
-	static double s_d1;
-	static double s_d2;
-	static double s_e1;
-	static double s_e2;
-	static double s_f1;
-	static double s_f2;
-	static double s_g1;
-	static double s_g2;
-	static double s_tMaxAgeRefDiff;
 	static int getH(const Person *pPerson);
+
+	static SimpactContext::Slot<EventHIVTransmissionSettings> s_settings;
 };
 
 #endif // EVENTHIVTRANSMISSION_H
@@ -19,7 +19,7 @@ EventHSV2Seed::~EventHSV2Seed()
 
 double EventHSV2Seed::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	return EventSeedBase::getNewInternalTimeDifference(s_settings, pRndGen, pState);
+	return EventSeedBase::getNewInternalTimeDifference(SIMPACTPOPULATION(pState).getContext().get(s_settings), pRndGen, pState);
 }
 
 string EventHSV2Seed::getDescription(double tNow) const
@@ -29,24 +29,24 @@ string EventHSV2Seed::getDescription(double tNow) const
 
 void EventHSV2Seed::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "HSV2 seeding", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "HSV2 seeding", tNow, 0, 0);
 }
 
 void EventHSV2Seed::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
-	EventSeedBase::fire(s_settings, t, pState, EventHSV2Transmission::infectPerson);
+	EventSeedBase::fire(SIMPACTPOPULATION(pState).getContext().get(s_settings), t, pState, EventHSV2Transmission::infectPerson);
 }
 
-SeedEventSettings EventHSV2Seed::s_settings;
+SimpactContext::Slot<SeedEventSettings> EventHSV2Seed::s_settings;
 
 void EventHSV2Seed::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
-	EventSeedBase::processConfig(s_settings, config, pRndGen, "hsv2seed");
+	EventSeedBase::processConfig(SimpactContext::getConfigContext().get(s_settings), config, pRndGen, "hsv2seed");
 }
 
 void EventHSV2Seed::obtainConfig(ConfigWriter &config)
 {
-	EventSeedBase::obtainConfig(s_settings, config, "hsv2seed");
+	EventSeedBase::obtainConfig(SimpactContext::getConfigContext().get(s_settings), config, "hsv2seed");
 }
 
 ConfigFunctions hsv2SeedingConfigFunctions(EventHSV2Seed::processConfig, EventHSV2Seed::obtainConfig, "EventHSV2Seed");
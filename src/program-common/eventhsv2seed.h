@@ -19,11 +19,11 @@ public:
 	
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
-	static double getSeedTime()									{ return s_settings.m_seedTime; }
+	static double getSeedTime(const SimpactContext &context)		{ return context.get(s_settings).m_seedTime; }
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
-	static SeedEventSettings s_settings;
+	static SimpactContext::Slot<SeedEventSettings> s_settings;
 };
 
 #endif // EVENTHSV2SEED_H
@@ -30,7 +30,7 @@ void EventHSV2Transmission::writeLogs(const SimpactPopulation &pop, double tNow)
 {
 	Person *pPerson1 = getPerson(0);
 	Person *pPerson2 = getPerson(1);
-	writeEventLogStart(true, "HSV2 transmission", tNow, pPerson1, pPerson2);
+	writeEventLogStart(pop.getContext(), true, "HSV2 transmission", tNow, pPerson1, pPerson2);
 }
 
 // The dissolution event that makes this event useless involves the exact same people,
@@ -76,12 +76,10 @@ void EventHSV2Transmission::infectPerson(SimpactPopulation &population, Person *
 	// Check relationships pTarget is in, and if the partner is not yet infected, schedule
 	// a transmission event.
 	int numRelations = pTarget->getNumberOfRelationships();
-	pTarget->startRelationshipIteration();
 	
 	for (int i = 0 ; i < numRelations ; i++)
 	{
-		double formationTime = -1;
-		Person *pPartner = pTarget->getNextRelationshipPartner(formationTime);
+		Person *pPartner = pTarget->getRelationshipPartner(i);
 
 		if (!pPartner->hsv2().isInfected())
 		{
@@ -89,11 +87,6 @@ void EventHSV2Transmission::infectPerson(SimpactPopulation &population, Person *
 			population.onNewEvent(pEvtTrans);
 		}
 	}
-
-#ifndef NDEBUG
-	double tDummy;
-	assert(pTarget->getNextRelationshipPartner(tDummy) == 0);
-#endif // NDEBUG
 }
 
 void EventHSV2Transmission::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -134,37 +127,34 @@ double EventHSV2Transmission::solveForRealTimeInterval(const State *pState, doub
 	return h.solveForRealTimeInterval(t0, Tdiff);
 }
 
-double EventHSV2Transmission::s_tMax = 200;
-double EventHSV2Transmission::s_c = 0; 
-double EventHSV2Transmission::s_d = 0; 
-double EventHSV2Transmission::s_e1 = 0;
-double EventHSV2Transmission::s_e2 = 0;
-double EventHSV2Transmission::HazardFunctionHSV2Transmission::s_b = 0;
+SimpactContext::Slot<EventHSV2TransmissionSettings> EventHSV2Transmission::s_settings;
 
 void EventHSV2Transmission::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventHSV2TransmissionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-    	if (!(r = config.getKeyValue("hsv2transmission.hazard.b", HazardFunctionHSV2Transmission::s_b)) ||
-        	!(r = config.getKeyValue("hsv2transmission.hazard.c", s_c)) ||
-        	!(r = config.getKeyValue("hsv2transmission.hazard.d", s_d)) ||
-		!(r = config.getKeyValue("hsv2transmission.hazard.e1", s_e1)) ||
-		!(r = config.getKeyValue("hsv2transmission.hazard.e2", s_e2)) ||
-        	!(r = config.getKeyValue("hsv2transmission.hazard.t_max", s_tMax))
+    	if (!(r = config.getKeyValue("hsv2transmission.hazard.b", settings.m_b)) ||
+        	!(r = config.getKeyValue("hsv2transmission.hazard.c", settings.m_c)) ||
+        	!(r = config.getKeyValue("hsv2transmission.hazard.d", settings.m_d)) ||
+		!(r = config.getKeyValue("hsv2transmission.hazard.e1", settings.m_e1)) ||
+		!(r = config.getKeyValue("hsv2transmission.hazard.e2", settings.m_e2)) ||
+        	!(r = config.getKeyValue("hsv2transmission.hazard.t_max", settings.m_tMax))
         )
         abortWithMessage(r.getErrorString());
 }
 
 void EventHSV2Transmission::obtainConfig(ConfigWriter &config)
 {
+	const EventHSV2TransmissionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("hsv2transmission.hazard.b", HazardFunctionHSV2Transmission::s_b)) ||
-		!(r = config.addKey("hsv2transmission.hazard.c", s_c))||
-		!(r = config.addKey("hsv2transmission.hazard.d", s_d))||
-		!(r = config.addKey("hsv2transmission.hazard.e1", s_e1))||
-		!(r = config.addKey("hsv2transmission.hazard.e2", s_e2))||
-		!(r = config.addKey("hsv2transmission.hazard.t_max", s_tMax))
+	if (!(r = config.addKey("hsv2transmission.hazard.b", settings.m_b)) ||
+		!(r = config.addKey("hsv2transmission.hazard.c", settings.m_c))||
+		!(r = config.addKey("hsv2transmission.hazard.d", settings.m_d))||
+		!(r = config.addKey("hsv2transmission.hazard.e1", settings.m_e1))||
+		!(r = config.addKey("hsv2transmission.hazard.e2", settings.m_e2))||
+		!(r = config.addKey("hsv2transmission.hazard.t_max", settings.m_tMax))
 		)
 		abortWithMessage(r.getErrorString());
 }
@@ -181,8 +171,10 @@ double EventHSV2Transmission::getTMax(const Person *pPerson1, const Person *pPer
     if (tb2 < tMax)
         tMax = tb2;
 
-    assert(s_tMax > 0);
-    tMax += s_tMax;
+    const EventHSV2TransmissionSettings &settings = pPerson1->getContext().get(s_settings);
+
+    assert(settings.m_tMax > 0);
+    tMax += settings.m_tMax;
     return tMax;
 }
 
@@ -208,7 +200,7 @@ int EventHSV2Transmission::getH(const Person *pPerson1)
 
 EventHSV2Transmission::HazardFunctionHSV2Transmission::HazardFunctionHSV2Transmission(const Person *pPerson1, 
                                                                                       const Person *pPerson2)
-    : HazardFunctionExp(getA(pPerson1, pPerson2), s_b)
+    : HazardFunctionExp(getA(pPerson1, pPerson2), getB(pPerson1))
 {
 }
 
@@ -220,7 +212,15 @@ double EventHSV2Transmission::HazardFunctionHSV2Transmission::getA(const Person
 {
     assert(pOrigin);
     assert(pTarget);
-    return pOrigin->hsv2().getHazardAParameter() - s_b*pOrigin->hsv2().getInfectionTime() + s_c*EventHSV2Transmission::getM(pOrigin) + s_d*EventHSV2Transmission::getH(pOrigin) + s_e1*pTarget->hiv().getHazardB0Parameter() + s_e2*pTarget->hsv2().getHazardB2Parameter(); 
+
+    const EventHSV2TransmissionSettings &settings = pOrigin->getContext().get(s_settings);
+    return pOrigin->hsv2().getHazardAParameter() - settings.m_b*pOrigin->hsv2().getInfectionTime() + settings.m_c*EventHSV2Transmission::getM(pOrigin) + settings.m_d*EventHSV2Transmission::getH(pOrigin) + settings.m_e1*pTarget->hiv().getHazardB0Parameter() + settings.m_e2*pTarget->hsv2().getHazardB2Parameter(); 
+}
+
+double EventHSV2Transmission::HazardFunctionHSV2Transmission::getB(const Person *pOrigin)
+{
+    assert(pOrigin);
+    return pOrigin->getContext().get(s_settings).m_b;
 }
 
 ConfigFunctions hsv2TransmissionConfigFunctions(EventHSV2Transmission::processConfig, EventHSV2Transmission::obtainConfig, 
@@ -7,6 +7,19 @@
 
 class ConfigSettings;
 
+class EventHSV2TransmissionSettings
+{
+public:
+	EventHSV2TransmissionSettings() : m_b(0), m_tMax(200), m_c(0), m_d(0), m_e1(0), m_e2(0)	{ }
+
+	double m_b;
+	double m_tMax;
+	double m_c; 
+	double m_d; 
+	double m_e1;
+	double m_e2;
+};
+
 class EventHSV2Transmission : public SimpactEvent
 {
 public:
@@ -36,17 +49,14 @@ protected:
         ~HazardFunctionHSV2Transmission();
 
         static double getA(const Person *pPerson1, const Person *pPerson2);
-        static double s_b;
+        static double getB(const Person *pPerson1);
     };
 
 	static double getTMax(const Person *pOrigin, const Person *pTarget);
 	static int getM(const Person *pPerson1);
 	static int getH(const Person *pPerson1);
-	static double s_tMax;
-	static double s_c; 
-	static double s_d; 
-	static double s_e1;
-	static double s_e2;
+
+	static SimpactContext::Slot<EventHSV2TransmissionSettings> s_settings;
 };
 
 #endif // EVENTHSV2TRANSMISSION_H
@@ -5,14 +5,82 @@
 #include "jsonconfig.h"
 #include "configfunctions.h"
 #include "configsettingslog.h"
+#include "eventaidsstage.h"
+#include "eventbirth.h"
+#include "eventcheckstopalgorithm.h"
+#include "eventchronicstage.h"
+#include "eventconception.h"
+#include "eventdiagnosis.h"
+#include "eventdissolution.h"
+#include "eventdropout.h"
+#include "eventformation.h"
+#include "eventhivseed.h"
+#include "eventhsv2seed.h"
+#include "eventhsv2transmission.h"
+#include "eventmortality.h"
+#include "eventperiodiclogging.h"
+#include "eventrelocation.h"
+#include "eventsyncpopstats.h"
+#include "eventsyncrefyear.h"
 #include <iostream>
 
 using namespace std;
 
 void processNonInterventionEventConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 
-EventIntervention::EventIntervention()
+// For these configuration functions, the settings that are read only influence the
+// hazard or fire time of the event type itself. If only such functions need to be
+// executed again, it suffices to recalculate the fire times of these event types.
+static const struct { const char *pName; const std::type_info &eventType; } s_configEventTypes[] = 
 {
+	{ "EventAIDSStage", typeid(EventAIDSStage) },
+	{ "EventBirth", typeid(EventBirth) },
+	{ "EventCheckStopAlgorithm", typeid(EventCheckStopAlgorithm) },
+	{ "EventChronicStage", typeid(EventChronicStage) },
+	{ "EventConception", typeid(EventConception) },
+	{ "EventDiagnosis", typeid(EventDiagnosis) },
+	{ "EventDissolution", typeid(EventDissolution) },
+	{ "EventDropout", typeid(EventDropout) },
+	{ "EventFormation", typeid(EventFormation) },
+	{ "EventHIVSeed", typeid(EventHIVSeed) },
+	{ "EventHSV2Seed", typeid(EventHSV2Seed) },
+	{ "EventHSV2Transmission", typeid(EventHSV2Transmission) },
+	{ "EventMortality", typeid(EventMortality) },
+	{ "EventPeriodicLogging", typeid(EventPeriodicLogging) },
+	{ "EventRelocation", typeid(EventRelocation) },
+	{ "EventSyncPopulationStatistics", typeid(EventSyncPopulationStatistics) },
+	{ "EventSyncReferenceYear", typeid(EventSyncReferenceYear) }
+};
+
+EventIntervention::EventIntervention(SimpactContext &context)
+{
+	assert(hasNextIntervention(context));
+
+	// The configuration functions were last executed using m_currentSettings, so
+	// we can already check which of these will need to be executed again
+	const EventInterventionSettings &settings = context.get(s_settings);
+	vector<string> excludes { "initonce", "__first__" };
+	ConfigFunctions::getChangedConfigurations(settings.m_readKeys, settings.m_currentSettings, *(settings.m_interventionSettings.begin()),
+			                                  excludes, m_changedConfigNames);
+
+	m_allEventsAffected = false;
+	for (size_t i = 0 ; !m_allEventsAffected && i < m_changedConfigNames.size() ; i++)
+	{
+		const string &name = m_changedConfigNames[i];
+		bool found = false;
+
+		for (size_t j = 0 ; !found && j < sizeof(s_configEventTypes)/sizeof(s_configEventTypes[0]) ; j++)
+		{
+			if (name == s_configEventTypes[j].pName)
+			{
+				m_affectedEventTypes.push_back(type_index(s_configEventTypes[j].eventType));
+				found = true;
+			}
+		}
+
+		if (!found)
+			m_allEventsAffected = true;
+	}
 }
 
 EventIntervention::~EventIntervention()
@@ -23,7 +91,7 @@ double EventIntervention::getNewInternalTimeDifference(GslRandomNumberGenerator
 {
 	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
 
-	double evtTime = getNextInterventionTime();
+	double evtTime = getNextInterventionTime(population.getContext());
 	double dt = evtTime - population.getTime();
 
 	if (evtTime < 0 || dt < 0)
@@ -39,39 +107,61 @@ string EventIntervention::getDescription(double tNow) const
 
 void EventIntervention::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "intervention", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "intervention", tNow, 0, 0);
 }
 
 void EventIntervention::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	SimpactContext &context = population.getContext();
 	double interventionTime;
 	ConfigSettings interventionConfig;
 
-	popNextInterventionInfo(interventionTime, interventionConfig);
+	popNextInterventionInfo(context, interventionTime, interventionConfig);
 	assert(interventionTime == t); // make sure we're at the correct time
 
 	GslRandomNumberGenerator *pRndGen = population.getRandomNumberGenerator();
 	
-	// Re-read the configurations, excluding the ones in the "initonce" category
+	// Re-read the configurations for which a setting changed, excluding the ones in
+	// the "initonce" category. The settings are stored in the context of this population.
 	vector<string> excludes { "initonce", "__first__" };
-	ConfigFunctions::processConfigurations(interventionConfig, pRndGen, excludes);
+	EventInterventionSettings &settings = context.get(s_settings);
+	SimpactContext::setConfigContext(&context);
+	ConfigFunctions::processConfigurations(interventionConfig, pRndGen, &settings.m_readKeys, excludes, m_changedConfigNames);
+	settings.m_currentSettings = interventionConfig;
 
-	ConfigSettingsLog::addConfigSettings(t, interventionConfig);
+	ConfigSettingsLog::get(context).addConfigSettings(t, interventionConfig);
 
-	if (EventIntervention::hasNextIntervention()) // check if we need to schedule a next intervention
+	if (EventIntervention::hasNextIntervention(context)) // check if we need to schedule a next intervention
 	{
-		EventIntervention *pEvt = new EventIntervention();
+		EventIntervention *pEvt = new EventIntervention(context);
 		population.onNewEvent(pEvt);
 	}
 }
 
+bool EventIntervention::isEventAffected(const PopulationEvent *pEvt) const
+{
+	if (m_allEventsAffected)
+		return true;
+
+	type_index t = type_index(typeid(*pEvt));
+
+	for (size_t i = 0 ; i < m_affectedEventTypes.size() ; i++)
+	{
+		if (m_affectedEventTypes[i] == t)
+			return true;
+	}
+	return false;
+}
+
 void EventIntervention::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventInterventionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
 	// This event can only be initialized once!
-	if (m_interventionsProcessed)
+	if (settings.m_interventionsProcessed)
 		abortWithMessage("Intervention event has already been initialized!");
-	m_interventionsProcessed = true;
+	settings.m_interventionsProcessed = true;
 
 	// check the config file
 	vector<string> yesNoOptions;
@@ -127,9 +217,11 @@ void EventIntervention::processConfig(ConfigSettings &config, GslRandomNumberGen
 		abortWithMessage("The number of fileIDs does not match the number of intervention times");
 
 	ConfigSettings baseSettings = config; // we'll let each intervention config start from the previous setting
+
+	settings.m_currentSettings = config;
  
-	assert(m_interventionSettings.size() == 0);
-	assert(m_interventionTimes.size() == 0);
+	assert(settings.m_interventionSettings.size() == 0);
+	assert(settings.m_interventionTimes.size() == 0);
 
 	// Ok, got everything we need. Load the config files.
 	for (size_t i = 0 ; i < fileIDParts.size() ; i++)
@@ -143,7 +235,7 @@ void EventIntervention::processConfig(ConfigSettings &config, GslRandomNumberGen
 		baseSettings.merge(interventionSettings);
 		baseSettings.clearUsageFlags();
 
-		m_interventionSettings.push_back(baseSettings);
+		settings.m_interventionSettings.push_back(baseSettings);
 	}
 
 	double prevTime = 0; // all intervention times must be positive and increasing
@@ -157,14 +249,15 @@ void EventIntervention::processConfig(ConfigSettings &config, GslRandomNumberGen
 		prevTime = t;
 	}
 
-	m_interventionTimes = interventionTimes;
+	settings.m_interventionTimes = interventionTimes;
 }
 
 void EventIntervention::obtainConfig(ConfigWriter &config)
 {
+	const EventInterventionSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (m_interventionTimes.size() == 0)
+	if (settings.m_interventionTimes.size() == 0)
 	{
 		if (!(r = config.addKey("intervention.enabled", "no")))
 			abortWithMessage(r.getErrorString());
@@ -178,11 +271,11 @@ void EventIntervention::obtainConfig(ConfigWriter &config)
 	    !(r = config.addKey("intervention.fileids", "IGNORE")) )
 		abortWithMessage(r.getErrorString());
 
-	list<double>::const_iterator it = m_interventionTimes.begin();
+	list<double>::const_iterator it = settings.m_interventionTimes.begin();
 	string timeStr = doubleToString(*it);
 
 	it++;
-	while (it != m_interventionTimes.end())
+	while (it != settings.m_interventionTimes.end())
 	{
 		timeStr += "," + doubleToString(*it);
 		it++;
@@ -192,35 +285,39 @@ void EventIntervention::obtainConfig(ConfigWriter &config)
 		abortWithMessage(r.getErrorString());
 }
 
-list<double> EventIntervention::m_interventionTimes;
-list<ConfigSettings> EventIntervention::m_interventionSettings;
-bool EventIntervention::m_interventionsProcessed = false;
+SimpactContext::Slot<EventInterventionSettings> EventIntervention::s_settings;
 
-bool EventIntervention::hasNextIntervention()
+bool EventIntervention::hasNextIntervention(const SimpactContext &context)
 {
-	assert(m_interventionTimes.size() == m_interventionSettings.size());
-	if (m_interventionTimes.size() > 0)
+	const EventInterventionSettings &settings = context.get(s_settings);
+
+	assert(settings.m_interventionTimes.size() == settings.m_interventionSettings.size());
+	if (settings.m_interventionTimes.size() > 0)
 		return true;
 	return false;
 }
 
-double EventIntervention::getNextInterventionTime()
+double EventIntervention::getNextInterventionTime(const SimpactContext &context)
 {
-	assert(m_interventionTimes.size() == m_interventionSettings.size());
-	assert(m_interventionTimes.size() > 0);
-	return *(m_interventionTimes.begin());
+	const EventInterventionSettings &settings = context.get(s_settings);
+
+	assert(settings.m_interventionTimes.size() == settings.m_interventionSettings.size());
+	assert(settings.m_interventionTimes.size() > 0);
+	return *(settings.m_interventionTimes.begin());
 }
 
-void EventIntervention::popNextInterventionInfo(double &t, ConfigSettings &config)
+void EventIntervention::popNextInterventionInfo(SimpactContext &context, double &t, ConfigSettings &config)
 {
-	assert(m_interventionTimes.size() == m_interventionSettings.size());
-	assert(m_interventionTimes.size() > 0);
+	EventInterventionSettings &settings = context.get(s_settings);
+
+	assert(settings.m_interventionTimes.size() == settings.m_interventionSettings.size());
+	assert(settings.m_interventionTimes.size() > 0);
 
-	t = *(m_interventionTimes.begin());
-	config = *(m_interventionSettings.begin());
+	t = *(settings.m_interventionTimes.begin());
+	config = *(settings.m_interventionSettings.begin());
 
-	m_interventionTimes.pop_front();
-	m_interventionSettings.pop_front();
+	settings.m_interventionTimes.pop_front();
+	settings.m_interventionSettings.pop_front();
 }
 
 ConfigFunctions interventionConfigFunctions(EventIntervention::processConfig, EventIntervention::obtainConfig,
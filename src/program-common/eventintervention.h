@@ -4,12 +4,30 @@
 
 #include "simpactevent.h"
 #include "configsettings.h"
+#include "configfunctions.h"
 #include <list>
+#include <vector>
+#include <typeindex>
+
+class EventInterventionSettings
+{
+public:
+	EventInterventionSettings() : m_interventionsProcessed(false)				{ }
+
+	std::list<double> m_interventionTimes;
+	std::list<ConfigSettings> m_interventionSettings;
+	ConfigSettings m_currentSettings;
+	bool m_interventionsProcessed;
+
+	// The keys that each configuration function read when it was last executed
+	// for this simulation
+	ConfigFunctions::ReadKeysMap m_readKeys;
+};
 
 class EventIntervention : public SimpactEvent
 {
 public:
-	EventIntervention();
+	EventIntervention(SimpactContext &context);
 	~EventIntervention();
 
 	std::string getDescription(double tNow) const;
@@ -17,22 +35,28 @@ public:
 
 	void fire(Algorithm *pAlgorithm, State *pState, double t);
 	
-	// We don't know which parameters are going to change in a very general
-	// intervention event, so everyone must be assumed to be (possibly) affected
-	bool isEveryoneAffected() const									{ return true; }
+	// Only the configuration functions that read one of the changed settings are
+	// executed again. If these only concern a specific kind of event, only the
+	// fire times of those events need to be recalculated, otherwise everyone must
+	// be assumed to be (possibly) affected.
+	bool isEveryoneAffected() const									{ return m_changedConfigNames.size() > 0; }
+	bool isEventAffected(const PopulationEvent *pEvt) const;
 
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
-	static bool hasNextIntervention();
+	static bool hasNextIntervention(const SimpactContext &context);
+	static ConfigFunctions::ReadKeysMap &getReadKeys(SimpactContext &context)	{ return context.get(s_settings).m_readKeys; }
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
-	static double getNextInterventionTime();
-	static void popNextInterventionInfo(double &t, ConfigSettings &config);
+	static double getNextInterventionTime(const SimpactContext &context);
+	static void popNextInterventionInfo(SimpactContext &context, double &t, ConfigSettings &config);
+
+	std::vector<std::string> m_changedConfigNames;
+	std::vector<std::type_index> m_affectedEventTypes;
+	bool m_allEventsAffected;
 
-	static std::list<double> m_interventionTimes;
-	static std::list<ConfigSettings> m_interventionSettings;
-	static bool m_interventionsProcessed;
+	static SimpactContext::Slot<EventInterventionSettings> s_settings;
 };
 
 #endif // EVENTINTERVENTION_H
@@ -0,0 +1,144 @@
+#include "eventmemoryreport.h"
+#include "simpactpopulation.h"
+#include "eventaidsmortality.h"
+#include "eventaidsstage.h"
+#include "eventbirth.h"
+#include "eventcheckstopalgorithm.h"
+#include "eventchronicstage.h"
+#include "eventconception.h"
+#include "eventdebut.h"
+#include "eventdiagnosis.h"
+#include "eventdissolution.h"
+#include "eventdropout.h"
+#include "eventformation.h"
+#include "eventhivseed.h"
+#include "eventhivtransmission.h"
+#include "eventhsv2seed.h"
+#include "eventhsv2transmission.h"
+#include "eventintervention.h"
+#include "eventmortality.h"
+#include "eventperiodiclogging.h"
+#include "eventrelocation.h"
+#include "eventsyncpopstats.h"
+#include "eventsyncrefyear.h"
+#include <assert.h>
+#include <typeinfo>
+#include <typeindex>
+#include <vector>
+#include <string>
+#include <map>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#include <stdlib.h>
+#endif // __GNUC__
+
+using namespace std;
+
+struct EventTypeInfo
+{
+	EventTypeInfo() : m_size(0), m_count(0)						{ }
+	EventTypeInfo(const string &name, size_t size) : m_name(name), m_size(size), m_count(0)	{ }
+
+	string m_name;
+	size_t m_size;
+	int64_t m_count;
+};
+
+template<class T>
+void addEventType(map<type_index, EventTypeInfo> &types, const string &name)
+{
+	types[type_index(typeid(T))] = EventTypeInfo(name, sizeof(T));
+}
+
+static string getTypeName(const type_index &t)
+{
+	string name = t.name();
+#ifdef __GNUC__
+	int status = 0;
+	char *pName = abi::__cxa_demangle(t.name(), 0, 0, &status);
+	if (pName)
+	{
+		if (status == 0)
+			name = pName;
+		free(pName);
+	}
+#endif // __GNUC__
+	return name;
+}
+
+void EventMemoryReport::write(SimpactPopulation &pop, ostream &out)
+{
+	// Note that EventMonitoring is not listed here, since the MaxART program uses
+	// its own event with the same name
+	map<type_index, EventTypeInfo> types;
+
+	addEventType<EventAIDSMortality>(types, "EventAIDSMortality");
+	addEventType<EventAIDSStage>(types, "EventAIDSStage");
+	addEventType<EventBirth>(types, "EventBirth");
+	addEventType<EventCheckStopAlgorithm>(types, "EventCheckStopAlgorithm");
+	addEventType<EventChronicStage>(types, "EventChronicStage");
+	addEventType<EventConception>(types, "EventConception");
+	addEventType<EventDebut>(types, "EventDebut");
+	addEventType<EventDiagnosis>(types, "EventDiagnosis");
+	addEventType<EventDissolution>(types, "EventDissolution");
+	addEventType<EventDropout>(types, "EventDropout");
+	addEventType<EventFormation>(types, "EventFormation");
+	addEventType<EventHIVSeed>(types, "EventHIVSeed");
+	addEventType<EventHIVTransmission>(types, "EventHIVTransmission");
+	addEventType<EventHSV2Seed>(types, "EventHSV2Seed");
+	addEventType<EventHSV2Transmission>(types, "EventHSV2Transmission");
+	addEventType<EventIntervention>(types, "EventIntervention");
+	addEventType<EventMortality>(types, "EventMortality");
+	addEventType<EventPeriodicLogging>(types, "EventPeriodicLogging");
+	addEventType<EventRelocation>(types, "EventRelocation");
+	addEventType<EventSyncPopulationStatistics>(types, "EventSyncPopulationStatistics");
+	addEventType<EventSyncReferenceYear>(types, "EventSyncReferenceYear");
+
+	vector<PopulationEvent *> events;
+	pop.getPendingEvents(events);
+
+	for (size_t i = 0 ; i < events.size() ; i++)
+	{
+		assert(events[i] != 0);
+
+		type_index t(typeid(*events[i]));
+		auto it = types.find(t);
+
+		if (it == types.end()) // an unknown type, no size available
+			it = types.insert(make_pair(t, EventTypeInfo(getTypeName(t), 0))).first;
+
+		it->second.m_count++;
+	}
+
+	// Sort by name for the output
+	map<string, EventTypeInfo> sortedTypes;
+	for (auto it = types.begin() ; it != types.end() ; it++)
+	{
+		if (it->second.m_count > 0)
+			sortedTypes[it->second.m_name] = it->second;
+	}
+
+	int64_t totalBytes = 0;
+
+	out << "# Number of pending events is " << events.size() << " (" << sizeof(PopulationEvent) 
+	    << " bytes per event for the common part)" << endl;
+
+	for (auto it = sortedTypes.begin() ; it != sortedTypes.end() ; it++)
+	{
+		const EventTypeInfo &info = it->second;
+
+		out << "#   " << info.m_name << ": " << info.m_count << " events";
+		if (info.m_size > 0)
+		{
+			int64_t bytes = info.m_count*(int64_t)info.m_size;
+
+			out << ", " << info.m_size << " bytes per event, " << bytes << " bytes in total";
+			totalBytes += bytes;
+		}
+		else
+			out << ", size unknown";
+		out << endl;
+	}
+
+	out << "# Total memory used by events of known types is " << totalBytes << " bytes" << endl;
+}
@@ -0,0 +1,19 @@
+#ifndef EVENTMEMORYREPORT_H
+
+#define EVENTMEMORYREPORT_H
+
+#include <iostream>
+
+class SimpactPopulation;
+
+// Writes an overview of the events that are currently present in the simulation,
+// per event type, together with the number of bytes that each such event occupies.
+// Event types that are not known here (e.g. the ones that are specific to a
+// particular simulation program) are listed by their type name, without a size.
+class EventMemoryReport
+{
+public:
+	static void write(SimpactPopulation &pop, std::ostream &out);
+};
+
+#endif // EVENTMEMORYREPORT_H
@@ -30,21 +30,23 @@ string EventMonitoring::getDescription(double tNow) const
 void EventMonitoring::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(false, "monitoring", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), false, "monitoring", tNow, pPerson, 0);
 
-	LogEvent.print(",CD4,%g", pPerson->hiv().getCD4Count(tNow));
+	LogSystem::get(pop.getContext()).logEvents.print(",CD4,%g", pPerson->hiv().getCD4Count(tNow));
 }
 
 bool EventMonitoring::isEligibleForTreatment(double t)
 {
 	Person *pPerson = getPerson(0);
-	assert(s_cd4Threshold >= 0);
+	const EventMonitoringSettings &settings = pPerson->getContext().get(s_settings);
+
+	assert(settings.m_cd4Threshold >= 0);
 
 	if (pPerson->hiv().getNumberTreatmentStarted() > 0) // if the person has already received treatment, (s)he's still eligible
 		return true;
 
 	// Check the threshold
-	if (pPerson->hiv().getCD4Count(t) < s_cd4Threshold)
+	if (pPerson->hiv().getCD4Count(t) < settings.m_cd4Threshold)
 		return true;
 
 	return false;
@@ -66,18 +68,19 @@ void EventMonitoring::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
 	GslRandomNumberGenerator *pRndGen = population.getRandomNumberGenerator();
+	const EventMonitoringSettings &settings = population.getContext().get(s_settings);
 	Person *pPerson = getPerson(0);
 
 	assert(pPerson->hiv().isInfected());
 	assert(!pPerson->hiv().hasLoweredViralLoad());
-	assert(s_treatmentVLLogFrac >= 0 && s_treatmentVLLogFrac <= 1.0);
+	assert(settings.m_treatmentVLLogFrac >= 0 && settings.m_treatmentVLLogFrac <= 1.0);
 
 	if (isEligibleForTreatment(t) && isWillingToStartTreatment(t, pRndGen))
 	{
-		SimpactEvent::writeEventLogStart(true, "(treatment)", t, pPerson, 0);
+		SimpactEvent::writeEventLogStart(population.getContext(), true, "(treatment)", t, pPerson, 0);
 
 		// Person is starting treatment, no further HIV test events will follow
-		pPerson->hiv().lowerViralLoad(s_treatmentVLLogFrac, t);
+		pPerson->hiv().lowerViralLoad(settings.m_treatmentVLLogFrac, t);
 
 		// Dropout event becomes possible
 		EventDropout *pEvtDropout = new EventDropout(pPerson, t);
@@ -101,28 +104,34 @@ double EventMonitoring::getNewInternalTimeDifference(GslRandomNumberGenerator *p
 		return hour * pRndGen->pickRandomDouble();
 	}
 
-	assert(s_pRecheckInterval);
-
 	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	const EventMonitoringSettings &settings = population.getContext().get(s_settings);
+
+	assert(settings.m_pRecheckInterval);
+
 	Person *pPerson = getPerson(0);
 	double currentTime = population.getTime();
 	double cd4 = pPerson->hiv().getCD4Count(currentTime);
-	double dt = s_pRecheckInterval->evaluate(cd4);
+	double dt = settings.m_pRecheckInterval->evaluate(cd4);
 
 	assert(dt >= 0);
 	return dt;
 }
 
-double EventMonitoring::s_treatmentVLLogFrac = -1;
-double EventMonitoring::s_cd4Threshold = -1;
-PieceWiseLinearFunction *EventMonitoring::s_pRecheckInterval = 0;
+EventMonitoringSettings::~EventMonitoringSettings()
+{
+	delete m_pRecheckInterval;
+}
+
+SimpactContext::Slot<EventMonitoringSettings> EventMonitoring::s_settings;
 
 void EventMonitoring::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventMonitoringSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("monitoring.cd4.threshold", s_cd4Threshold, 0)) ||
-	    !(r = config.getKeyValue("monitoring.fraction.log_viralload", s_treatmentVLLogFrac, 0, 1)))
+	if (!(r = config.getKeyValue("monitoring.cd4.threshold", settings.m_cd4Threshold, 0)) ||
+	    !(r = config.getKeyValue("monitoring.fraction.log_viralload", settings.m_treatmentVLLogFrac, 0, 1)))
 		abortWithMessage(r.getErrorString());
 
 	vector<double> intervalX, intervalY;
@@ -151,15 +160,17 @@ void EventMonitoring::processConfig(ConfigSettings &config, GslRandomNumberGener
 	for (size_t i = 0 ; i < intervalX.size() ; i++)
 		points.push_back(Point2D(intervalX[i], intervalY[i]));
 
-	delete s_pRecheckInterval;
-	s_pRecheckInterval = new PieceWiseLinearFunction(points, leftValue, rightValue);
+	delete settings.m_pRecheckInterval;
+	settings.m_pRecheckInterval = new PieceWiseLinearFunction(points, leftValue, rightValue);
 }
 
 void EventMonitoring::obtainConfig(ConfigWriter &config)
 {
-	assert(s_pRecheckInterval);
+	const EventMonitoringSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	assert(settings.m_pRecheckInterval);
 
-	const vector<Point2D> &points = s_pRecheckInterval->getPoints();
+	const vector<Point2D> &points = settings.m_pRecheckInterval->getPoints();
 	vector<double> intervalX, intervalY;
 
 	for (size_t i = 0 ; i < points.size() ; i++)
@@ -170,12 +181,12 @@ void EventMonitoring::obtainConfig(ConfigWriter &config)
 
 	bool_t r;
 
-	if (!(r = config.addKey("monitoring.cd4.threshold", s_cd4Threshold)) ||
-	    !(r = config.addKey("monitoring.fraction.log_viralload", s_treatmentVLLogFrac)) ||
+	if (!(r = config.addKey("monitoring.cd4.threshold", settings.m_cd4Threshold)) ||
+	    !(r = config.addKey("monitoring.fraction.log_viralload", settings.m_treatmentVLLogFrac)) ||
 	    !(r = config.addKey("monitoring.interval.piecewise.cd4s", intervalX)) ||
 	    !(r = config.addKey("monitoring.interval.piecewise.times", intervalY)) ||
-	    !(r = config.addKey("monitoring.interval.piecewise.left", s_pRecheckInterval->getLeftValue())) ||
-	    !(r = config.addKey("monitoring.interval.piecewise.right", s_pRecheckInterval->getRightValue())) )
+	    !(r = config.addKey("monitoring.interval.piecewise.left", settings.m_pRecheckInterval->getLeftValue())) ||
+	    !(r = config.addKey("monitoring.interval.piecewise.right", settings.m_pRecheckInterval->getRightValue())) )
 		abortWithMessage(r.getErrorString());
 }
 
@@ -8,6 +8,17 @@ class ConfigSettings;
 class ConfigWriter;
 class PieceWiseLinearFunction;
 
+class EventMonitoringSettings
+{
+public:
+	EventMonitoringSettings() : m_treatmentVLLogFrac(-1), m_cd4Threshold(-1), m_pRecheckInterval(0)	{ }
+	~EventMonitoringSettings();
+
+	double m_treatmentVLLogFrac;
+	double m_cd4Threshold;
+	PieceWiseLinearFunction *m_pRecheckInterval;
+};
+
 class EventMonitoring : public SimpactEvent
 {
 public:
@@ -27,9 +38,7 @@ private:
 
 	bool m_scheduleImmediately;
 
-	static double s_treatmentVLLogFrac;
-	static double s_cd4Threshold;
-	static PieceWiseLinearFunction *s_pRecheckInterval;
+	static SimpactContext::Slot<EventMonitoringSettings> s_settings;
 };
 
 #endif // EVENTMONITORING_H
@@ -15,13 +15,12 @@ EventMortality::~EventMortality()
 {
 }
 
-double EventMortality::m_shape = -1;
-double EventMortality::m_scale = -1;
-double EventMortality::m_genderDiff = -1;
+SimpactContext::Slot<EventMortalitySettings> EventMortality::s_settings;
 
 double EventMortality::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
 	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	const EventMortalitySettings &settings = population.getContext().get(s_settings);
 	Person *pPerson = getPerson(0);
 
 	assert(!pPerson->hasDied());
@@ -29,16 +28,16 @@ double EventMortality::getNewInternalTimeDifference(GslRandomNumberGenerator *pR
 
 	double dt = -1;
 
-	assert(m_shape > 0);
-	assert(m_scale > 0);
-	assert(m_genderDiff >= 0);
+	assert(settings.m_shape > 0);
+	assert(settings.m_scale > 0);
+	assert(settings.m_genderDiff >= 0);
 
 	double curTime = population.getTime();
 	double ageOffset = pPerson->getAgeAt(curTime); // current age
 
-	double scale = m_scale;
-	double shape = m_shape;
-	double genderDiff = m_genderDiff;
+	double scale = settings.m_scale;
+	double shape = settings.m_shape;
+	double genderDiff = settings.m_genderDiff;
 
 	genderDiff /= 2.0;
 	if (pPerson->getGender() == Person::Male)
@@ -62,26 +61,28 @@ string EventMortality::getDescription(double tNow) const
 void EventMortality::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson1 = getPerson(0);
-	writeEventLogStart(true, "normalmortality", tNow, pPerson1, 0);
+	writeEventLogStart(pop.getContext(), true, "normalmortality", tNow, pPerson1, 0);
 }
 
 void EventMortality::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventMortalitySettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("mortality.normal.weibull.shape", m_shape, 0)) ||
-	    !(r = config.getKeyValue("mortality.normal.weibull.scale", m_scale, 0)) ||
-	    !(r = config.getKeyValue("mortality.normal.weibull.genderdiff", m_genderDiff)))
+	if (!(r = config.getKeyValue("mortality.normal.weibull.shape", settings.m_shape, 0)) ||
+	    !(r = config.getKeyValue("mortality.normal.weibull.scale", settings.m_scale, 0)) ||
+	    !(r = config.getKeyValue("mortality.normal.weibull.genderdiff", settings.m_genderDiff)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventMortality::obtainConfig(ConfigWriter &config)
 {
+	const EventMortalitySettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("mortality.normal.weibull.shape", m_shape)) ||
-	    !(r = config.addKey("mortality.normal.weibull.scale", m_scale)) ||
-	    !(r = config.addKey("mortality.normal.weibull.genderdiff", m_genderDiff)))
+	if (!(r = config.addKey("mortality.normal.weibull.shape", settings.m_shape)) ||
+	    !(r = config.addKey("mortality.normal.weibull.scale", settings.m_scale)) ||
+	    !(r = config.addKey("mortality.normal.weibull.genderdiff", settings.m_genderDiff)))
 		abortWithMessage(r.getErrorString());
 }
 
@@ -6,6 +6,16 @@
 
 class ConfigSettings;
 
+class EventMortalitySettings
+{
+public:
+	EventMortalitySettings() : m_shape(-1), m_scale(-1), m_genderDiff(-1)					{ }
+
+	double m_shape;
+	double m_scale;
+	double m_genderDiff;
+};
+
 // Non-AIDS (normal) mortality
 class EventMortality : public EventMortalityBase
 {
@@ -21,9 +31,7 @@ public:
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
-	static double m_shape;
-	static double m_scale;
-	static double m_genderDiff;
+	static SimpactContext::Slot<EventMortalitySettings> s_settings;
 };
 
 #endif // EVENTMORTALITY_H
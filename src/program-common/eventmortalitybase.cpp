@@ -20,19 +20,12 @@ void EventMortalityBase::markOtherAffectedPeople(const PopulationStateInterface
 	assert(pPerson != 0);
 
 	int numRelationships = pPerson->getNumberOfRelationships();
-	pPerson->startRelationshipIteration();
 
 	for  (int i = 0 ; i < numRelationships ; i++)
 	{
-		double formationTime;
-		Person *pPartner = pPerson->getNextRelationshipPartner(formationTime);
+		Person *pPartner = pPerson->getRelationshipPartner(i);
 		population.markAffectedPerson(pPartner);
 	}
-
-#ifndef NDEBUG
-	double tDummy;
-	assert(pPerson->getNextRelationshipPartner(tDummy) == 0); // make sure the iteration is done
-#endif // NDEBUG
 }
 
 void EventMortalityBase::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -44,12 +37,10 @@ void EventMortalityBase::fire(Algorithm *pAlgorithm, State *pState, double t)
 	assert(pPerson != 0);
 
 	int numRelationships = pPerson->getNumberOfRelationships();
-	pPerson->startRelationshipIteration();
 
 	for  (int i = 0 ; i < numRelationships ; i++)
 	{
-		double formationTime;
-		Person *pPartner = pPerson->getNextRelationshipPartner(formationTime);
+		Person *pPartner = pPerson->getRelationshipPartner(i);
 
 		assert(pPartner != 0);
 		assert(!pPartner->hasDied());
@@ -65,14 +56,13 @@ void EventMortalityBase::fire(Algorithm *pAlgorithm, State *pState, double t)
 		//cout << t << "\tDeath based dissolution between " << pPerson->getName() << " and " << pPartner->getName() << " (formed " << t-formationTime << " ago)" << endl;
 	}
 
-#ifndef NDEBUG
-	double tDummy;
-	assert(pPerson->getNextRelationshipPartner(tDummy) == 0); // make sure the iteration is done
-#endif // NDEBUG
-
 	if (pPerson->hiv().isInfected() && pPerson->hiv().hasLoweredViralLoad())
 		pPerson->writeToTreatmentLog(t, true);
 
 	population.setPersonDied(pPerson);
+
+	// All events involving this person are useless now, remove them from the
+	// lists of the other persons as well
+	population.removeUselessEvents(pPerson);
 }
 
@@ -33,7 +33,7 @@ string EventPeriodicLogging::getDescription(double tNow) const
 
 void EventPeriodicLogging::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "periodiclogging", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "periodiclogging", tNow, 0, 0);
 }
 
 void EventPeriodicLogging::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -41,57 +41,55 @@ void EventPeriodicLogging::fire(Algorithm *pAlgorithm, State *pState, double t)
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
 
 	// Count number of people currently in treatment
-	Person **ppPeople = population.getAllPeople();
+	const PersonAttributeArrays &attributes = population.getAttributeArrays();
 	int numPeople = population.getNumberOfPeople();
 
+	assert(attributes.getNumberOfPeople() == numPeople);
+
 	int inTreatmentCount = 0;
 	for (int i = 0 ; i < numPeople ; i++)
 	{
-		Person *pPerson = ppPeople[i];
-		assert(pPerson);
-
-		if (pPerson->hiv().isInfected() && pPerson->hiv().hasLoweredViralLoad())
+		if (attributes.isInfected(i) && attributes.hasLoweredViralLoad(i))
 			inTreatmentCount++;
 	}
 
-	s_logFile.print("%10.10f,%d,%d", t, numPeople, inTreatmentCount);
+	EventPeriodicLoggingSettings &settings = population.getContext().get(s_settings);
+	settings.m_logFile.print("%10.10f,%d,%d", t, numPeople, inTreatmentCount);
 
 	// Schedule next logging event
 
-	if (s_loggingInterval > 0) // make sure it hasn't been disabled (by an intervention event for example)
+	if (settings.m_loggingInterval > 0) // make sure it hasn't been disabled (by an intervention event for example)
 	{
 		// We need to schedule the next one
-		EventPeriodicLogging *pEvt = new EventPeriodicLogging(t + s_loggingInterval);
+		EventPeriodicLogging *pEvt = new EventPeriodicLogging(t + settings.m_loggingInterval);
 		population.onNewEvent(pEvt);
 	}
 }
 
-double EventPeriodicLogging::s_loggingInterval = -1;
-double EventPeriodicLogging::s_firstEventTime = -1;
-string EventPeriodicLogging::s_logFileName;
-LogFile EventPeriodicLogging::s_logFile;
+SimpactContext::Slot<EventPeriodicLoggingSettings> EventPeriodicLogging::s_settings;
 
 void EventPeriodicLogging::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
-	string oldLogFileName = s_logFileName;
+	EventPeriodicLoggingSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+	string oldLogFileName = settings.m_logFileName;
 	bool_t r;
 
-	if (!(r = config.getKeyValue("periodiclogging.interval", s_loggingInterval)) ||
-		!(r = config.getKeyValue("periodiclogging.starttime", s_firstEventTime)) ||
-	    !(r = config.getKeyValue("periodiclogging.outfile.logperiodic", s_logFileName)) )
+	if (!(r = config.getKeyValue("periodiclogging.interval", settings.m_loggingInterval)) ||
+		!(r = config.getKeyValue("periodiclogging.starttime", settings.m_firstEventTime)) ||
+	    !(r = config.getKeyValue("periodiclogging.outfile.logperiodic", settings.m_logFileName)) )
 		abortWithMessage(r.getErrorString());
 
-	if (s_loggingInterval > 0)
+	if (settings.m_loggingInterval > 0)
 	{
-		if (oldLogFileName != s_logFileName) // other file was specified, or none at all
+		if (oldLogFileName != settings.m_logFileName) // other file was specified, or none at all
 		{
-			s_logFile.close();
-			if (s_logFileName.length() > 0) // try to open a file
+			settings.m_logFile.close();
+			if (settings.m_logFileName.length() > 0) // try to open a file
 			{
-				if (!( r = s_logFile.open(s_logFileName)))
+				if (!( r = settings.m_logFile.open(settings.m_logFileName)))
 					abortWithMessage(r.getErrorString());
 
-				s_logFile.print("Time,PopSize,InTreatment");
+				settings.m_logFile.print("Time,PopSize,InTreatment");
 			}
 		}
 	}
@@ -99,11 +97,12 @@ void EventPeriodicLogging::processConfig(ConfigSettings &config, GslRandomNumber
 
 void EventPeriodicLogging::obtainConfig(ConfigWriter &config)
 {
+	const EventPeriodicLoggingSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("periodiclogging.interval", s_loggingInterval)) ||
-		!(r = config.addKey("periodiclogging.starttime", s_firstEventTime)) ||
-	    !(r = config.addKey("periodiclogging.outfile.logperiodic", s_logFileName)) )
+	if (!(r = config.addKey("periodiclogging.interval", settings.m_loggingInterval)) ||
+		!(r = config.addKey("periodiclogging.starttime", settings.m_firstEventTime)) ||
+	    !(r = config.addKey("periodiclogging.outfile.logperiodic", settings.m_logFileName)) )
 	    	abortWithMessage(r.getErrorString());
 }
 
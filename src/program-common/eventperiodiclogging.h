@@ -7,6 +7,17 @@
 
 class ConfigSettings;
 
+class EventPeriodicLoggingSettings
+{
+public:
+	EventPeriodicLoggingSettings() : m_loggingInterval(-1), m_firstEventTime(-1)			{ }
+
+	LogFile m_logFile;
+	std::string m_logFileName;
+	double m_loggingInterval;
+	double m_firstEventTime;
+};
+
 // This is a global event, but nobody is affected (nothing changes),
 // just some stats are written
 class EventPeriodicLogging : public SimpactEvent
@@ -23,30 +34,28 @@ public:
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 
-	static bool isEnabled() 								{ return (s_loggingInterval > 0); }
-	static double getFirstEventTime();
+	static bool isEnabled(const SimpactContext &context) 					{ return (context.get(s_settings).m_loggingInterval > 0); }
+	static double getFirstEventTime(const SimpactContext &context);
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
 	double m_eventTime;
 
-	static LogFile s_logFile;
-	static std::string s_logFileName;
-	static double s_loggingInterval;
-	static double s_firstEventTime;
+	static SimpactContext::Slot<EventPeriodicLoggingSettings> s_settings;
 };
 
-inline double EventPeriodicLogging::getFirstEventTime()
+inline double EventPeriodicLogging::getFirstEventTime(const SimpactContext &context)
 {
-	if (!isEnabled())
+	if (!isEnabled(context))
 		return -1;
 
-	if (s_firstEventTime >= 0)
-		return s_firstEventTime;
+	const EventPeriodicLoggingSettings &settings = context.get(s_settings);
+	if (settings.m_firstEventTime >= 0)
+		return settings.m_firstEventTime;
 
 	// For backwards compatibility, if no positive first event time is mentioned, the first event
 	// will get scheduled after the first interval
-	return s_loggingInterval;
+	return settings.m_loggingInterval;
 }
 
 #endif // EVENTPERIODICLOGGING_H
@@ -24,14 +24,14 @@ string EventRelocation::getDescription(double tNow) const
 void EventRelocation::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(true, "relocation", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), true, "relocation", tNow, pPerson, 0);
 }
 
 void EventRelocation::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
 	Person *pPerson = getPerson(0);
-	ProbabilityDistribution2D *pLocDist = pPerson->getPopulationDistribution();
+	ProbabilityDistribution2D *pLocDist = Person::getPopulationDistribution(population.getContext());
 	
 	Point2D oldLocation = pPerson->getLocation();
 	population.removePersonFromCoarseMap(pPerson);
@@ -51,11 +51,14 @@ void EventRelocation::fire(Algorithm *pAlgorithm, State *pState, double t)
 		population.initializeFormationEvents(pPerson, false, true, t); // true: due to a relocation, does the eyecaps check if needed
 	}
 
-	if (EventRelocation::isEnabled())
+	if (EventRelocation::isEnabled(population.getContext()))
 	{
 		EventRelocation *pEvt = new EventRelocation(pPerson);
 		population.onNewEvent(pEvt);
 	}
+
+	// The formation events that were scheduled before the move are no longer used
+	population.removeUselessEvents(pPerson);
 }
 
 double EventRelocation::calculateInternalTimeInterval(const State *pState, double t0, double dt)
@@ -80,24 +83,21 @@ double EventRelocation::solveForRealTimeInterval(const State *pState, double Tdi
 	return h.solveForRealTimeInterval(t0, Tdiff);
 }
 
-bool EventRelocation::s_enabled = false;
-double EventRelocation::s_tMax = 200;
-
-double EventRelocation::HazardFunctionRelocation::s_a = 0;
-double EventRelocation::HazardFunctionRelocation::s_b = 0;
+SimpactContext::Slot<EventRelocationSettings> EventRelocation::s_settings;
 
 void EventRelocation::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventRelocationSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("relocation.enabled", s_enabled)))
+	if (!(r = config.getKeyValue("relocation.enabled", settings.m_enabled)))
 		abortWithMessage(r.getErrorString());
 
-	if (s_enabled)
+	if (settings.m_enabled)
 	{
-		if (!(r = config.getKeyValue("relocation.hazard.a", HazardFunctionRelocation::s_a)) ||
-			!(r = config.getKeyValue("relocation.hazard.b", HazardFunctionRelocation::s_b)) ||
-			!(r = config.getKeyValue("relocation.hazard.t_max", s_tMax))
+		if (!(r = config.getKeyValue("relocation.hazard.a", settings.m_a)) ||
+			!(r = config.getKeyValue("relocation.hazard.b", settings.m_b)) ||
+			!(r = config.getKeyValue("relocation.hazard.t_max", settings.m_tMax))
 			)
 			abortWithMessage(r.getErrorString());
 	}
@@ -105,16 +105,17 @@ void EventRelocation::processConfig(ConfigSettings &config, GslRandomNumberGener
 
 void EventRelocation::obtainConfig(ConfigWriter &config)
 {
+	const EventRelocationSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("relocation.enabled", s_enabled)))
+	if (!(r = config.addKey("relocation.enabled", settings.m_enabled)))
 		abortWithMessage(r.getErrorString());
 
-	if (s_enabled)
+	if (settings.m_enabled)
 	{
-		if (!(r = config.addKey("relocation.hazard.a", HazardFunctionRelocation::s_a)) ||
-			!(r = config.addKey("relocation.hazard.b", HazardFunctionRelocation::s_b)) ||
-			!(r = config.addKey("relocation.hazard.t_max", s_tMax)) 
+		if (!(r = config.addKey("relocation.hazard.a", settings.m_a)) ||
+			!(r = config.addKey("relocation.hazard.b", settings.m_b)) ||
+			!(r = config.addKey("relocation.hazard.t_max", settings.m_tMax)) 
 		    )
 			abortWithMessage(r.getErrorString());
 	}
@@ -127,13 +128,15 @@ double EventRelocation::getTMax(const Person *pPerson)
 	double tb = pPerson->getDateOfBirth();
 	double tMax = tb;
 
-	assert(s_tMax > 0);
-	tMax += s_tMax;
+	const EventRelocationSettings &settings = pPerson->getContext().get(s_settings);
+
+	assert(settings.m_tMax > 0);
+	tMax += settings.m_tMax;
 	return tMax;
 }
 
 EventRelocation::HazardFunctionRelocation::HazardFunctionRelocation(const Person *pPerson)
-	: HazardFunctionExp(getA(pPerson), s_b)
+	: HazardFunctionExp(getA(pPerson), getB(pPerson))
 {
 }
 
@@ -144,7 +147,15 @@ EventRelocation::HazardFunctionRelocation::~HazardFunctionRelocation()
 double EventRelocation::HazardFunctionRelocation::getA(const Person *pPerson)
 {
 	assert(pPerson);
-	return s_a - s_b*pPerson->getDateOfBirth();
+
+	const EventRelocationSettings &settings = pPerson->getContext().get(s_settings);
+	return settings.m_a - settings.m_b*pPerson->getDateOfBirth();
+}
+
+double EventRelocation::HazardFunctionRelocation::getB(const Person *pPerson)
+{
+	assert(pPerson);
+	return pPerson->getContext().get(s_settings).m_b;
 }
 
 ConfigFunctions relocationConfigFunctions(EventRelocation::processConfig, EventRelocation::obtainConfig, "EventRelocation");
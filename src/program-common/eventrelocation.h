@@ -7,6 +7,16 @@
 
 class ConfigSettings;
 
+class EventRelocationSettings
+{
+public:
+	EventRelocationSettings() : m_a(0), m_b(0), m_enabled(false), m_tMax(200)				{ }
+
+	double m_a, m_b;
+	bool m_enabled;
+	double m_tMax;
+};
+
 class EventRelocation : public SimpactEvent
 {
 public:
@@ -25,7 +35,7 @@ public:
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 
-	static bool isEnabled()															{ return s_enabled; }
+	static bool isEnabled(const SimpactContext &context)							{ return context.get(s_settings).m_enabled; }
 private:
 	double calculateInternalTimeInterval(const State *pState, double t0, double dt);
 	double solveForRealTimeInterval(const State *pState, double Tdiff, double t0);
@@ -38,11 +48,10 @@ private:
 		~HazardFunctionRelocation();
 
 		static double getA(const Person *pPerson);
-		static double s_a, s_b;
+		static double getB(const Person *pPerson);
 	};
 
-	static bool s_enabled;
-	static double s_tMax;
+	static SimpactContext::Slot<EventRelocationSettings> s_settings;
 };
 
 #endif // EVENTRELOCATION_H
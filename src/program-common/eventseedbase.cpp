@@ -37,6 +37,7 @@ void EventSeedBase::fire(SeedEventSettings &settings, double t, State *pState, T
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
 	GslRandomNumberGenerator *pRngGen = population.getRandomNumberGenerator();
 	Person **ppPeople = population.getAllPeople();
+	const PersonAttributeArrays &attributes = population.getAttributeArrays();
 	int numPeople = population.getNumberOfPeople();
 
 	// Build pool of people which can be seeded
@@ -49,15 +50,14 @@ void EventSeedBase::fire(SeedEventSettings &settings, double t, State *pState, T
 
 	for (int i = 0 ; i < numPeople ; i++)
 	{
-		Person *pPerson = ppPeople[i];
-		double age = pPerson->getAgeAt(t);
+		double age = t - attributes.getDateOfBirth(i);
 		
 		if (age >= settings.m_seedMinAge && age <= settings.m_seedMaxAge)
 		{
 			if ( settings.m_seedGender == SeedEventSettings::Any || 
-			     (settings.m_seedGender == SeedEventSettings::Male && pPerson->isMan()) || 
-				 (settings.m_seedGender == SeedEventSettings::Female && pPerson->isWoman()) )
-				possibleSeeders.push_back(pPerson);
+			     (settings.m_seedGender == SeedEventSettings::Male && attributes.isMan(i)) || 
+				 (settings.m_seedGender == SeedEventSettings::Female && attributes.isWoman(i)) )
+				possibleSeeders.push_back(ppPeople[i]);
 		}
 	}
 
@@ -19,7 +19,7 @@ string EventSyncPopulationStatistics::getDescription(double tNow) const
 
 void EventSyncPopulationStatistics::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "syncpopstats", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "syncpopstats", tNow, 0, 0);
 }
 
 void EventSyncPopulationStatistics::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -31,10 +31,10 @@ void EventSyncPopulationStatistics::fire(Algorithm *pAlgorithm, State *pState, d
 	double lastTime = 0;
 	int lastSize = population.getLastKnownPopulationSize(lastTime);
 
-	writeEventLogStart(false, "(populationsize)", t, 0, 0);
-	LogEvent.print(",size,%d", lastSize);
+	writeEventLogStart(population.getContext(), false, "(populationsize)", t, 0, 0);
+	LogSystem::get(population.getContext()).logEvents.print(",size,%d", lastSize);
 
-	if (isEnabled())
+	if (isEnabled(population.getContext()))
 	{
 		EventSyncPopulationStatistics *pEvt = new EventSyncPopulationStatistics();
 		population.onNewEvent(pEvt);
@@ -43,25 +43,29 @@ void EventSyncPopulationStatistics::fire(Algorithm *pAlgorithm, State *pState, d
 
 double EventSyncPopulationStatistics::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	assert(s_interval > 0);
-	return s_interval;
+	double dt = getInterval(SIMPACTPOPULATION(pState).getContext());
+
+	assert(dt > 0);
+	return dt;
 }
 
-double EventSyncPopulationStatistics::s_interval = -1.0;
+SimpactContext::Slot<EventSyncPopulationStatisticsSettings> EventSyncPopulationStatistics::s_settings;
 
 void EventSyncPopulationStatistics::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventSyncPopulationStatisticsSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("syncpopstats.interval", s_interval)))
+	if (!(r = config.getKeyValue("syncpopstats.interval", settings.m_interval)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventSyncPopulationStatistics::obtainConfig(ConfigWriter &config)
 {
+	const EventSyncPopulationStatisticsSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("syncpopstats.interval", s_interval)))
+	if (!(r = config.addKey("syncpopstats.interval", settings.m_interval)))
 		abortWithMessage(r.getErrorString());
 }
 
@@ -83,8 +87,8 @@ JSONConfig eventSyncPopStatsJSONConfig(R"JSON(
                 "shrinking populations, this is not correct however.",
                 "",
                 "By setting this interval to a positive number, the last known population",
-                "size will be recalculated periodically. Note that this will also cause all",
-                "event times in the simulation to be recalculated, so settings this to a low",
-                "value can certainly slow things down."
+                "size will be recalculated periodically. Note that this will also cause the",
+                "times of the events that use the population size to be recalculated, so",
+                "setting this to a low value can slow things down."
             ]
         })JSON");
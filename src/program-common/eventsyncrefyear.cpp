@@ -19,7 +19,7 @@ string EventSyncReferenceYear::getDescription(double tNow) const
 
 void EventSyncReferenceYear::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "syncrefyear", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "syncrefyear", tNow, 0, 0);
 }
 
 void EventSyncReferenceYear::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -28,7 +28,7 @@ void EventSyncReferenceYear::fire(Algorithm *pAlgorithm, State *pState, double t
 	SimpactPopulation &population = SIMPACTPOPULATION(pState);
 	population.setReferenceYear(t);
 
-	if (isEnabled())
+	if (isEnabled(population.getContext()))
 	{
 		EventSyncReferenceYear *pEvt = new EventSyncReferenceYear();
 		population.onNewEvent(pEvt);
@@ -37,25 +37,29 @@ void EventSyncReferenceYear::fire(Algorithm *pAlgorithm, State *pState, double t
 
 double EventSyncReferenceYear::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	assert(s_interval > 0);
-	return s_interval;
+	double dt = getInterval(SIMPACTPOPULATION(pState).getContext());
+
+	assert(dt > 0);
+	return dt;
 }
 
-double EventSyncReferenceYear::s_interval = -1.0;
+SimpactContext::Slot<EventSyncReferenceYearSettings> EventSyncReferenceYear::s_settings;
 
 void EventSyncReferenceYear::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventSyncReferenceYearSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("syncrefyear.interval", s_interval)))
+	if (!(r = config.getKeyValue("syncrefyear.interval", settings.m_interval)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventSyncReferenceYear::obtainConfig(ConfigWriter &config)
 {
+	const EventSyncReferenceYearSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("syncrefyear.interval", s_interval)))
+	if (!(r = config.addKey("syncrefyear.interval", settings.m_interval)))
 		abortWithMessage(r.getErrorString());
 }
 
@@ -73,8 +77,8 @@ JSONConfig eventSyncRefYearJSONConfig(R"JSON(
                 "In the hazards of some events, instead of using the actual simulation time",
                 "a reference time is used. This typically makes the integrals involved much",
                 "easier to calculate. This interval specifies how often this reference time",
-                "is saved for use in these hazards. Note that all other event times are",
-                "recalculated after firing this event, so very frequent updates of this",
-                "reference time can slow down the simulation considerably."
+                "is saved for use in these hazards. Note that the times of the events that",
+                "use this reference time are recalculated after firing this event, so very",
+                "frequent updates of this reference time can slow down the simulation."
             ]
         })JSON");
@@ -4,6 +4,14 @@
 
 #include "simpactevent.h"
 
+class EventSyncReferenceYearSettings
+{
+public:
+	EventSyncReferenceYearSettings() : m_interval(-1.0)										{ }
+
+	double m_interval;
+};
+
 class EventSyncReferenceYear : public SimpactEvent
 {
 public:
@@ -15,18 +23,19 @@ public:
 
 	void fire(Algorithm *pAlgorithm, State *pState, double t);
 
-	// Everything needs to be recalculated after this
+	// Only the events that depend on the reference year need to be recalculated after this
 	bool isEveryoneAffected() const														{ return true; }
+	bool isEventAffected(const PopulationEvent *pEvt) const								{ return dependsOnSyncValue(pEvt, SyncReferenceYear); }
 
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 
-	static bool isEnabled()																{ return s_interval > 0; }
-	static double getInterval()															{ return s_interval; }
+	static bool isEnabled(const SimpactContext &context)								{ return getInterval(context) > 0; }
+	static double getInterval(const SimpactContext &context)							{ return context.get(s_settings).m_interval; }
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
-	static double s_interval;
+	static SimpactContext::Slot<EventSyncReferenceYearSettings> s_settings;
 };
 
 #endif // EVENTSYNCREFERENCEYEAR_H
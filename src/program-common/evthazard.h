@@ -2,11 +2,14 @@
 
 #define EVTHAZARD_H
 
+#include "util.h"
 #include <string>
 
 class SimpactPopulation;
 class SimpactEvent;
 class ConfigWriter;
+class EventBatchSolver;
+class Person;
 
 // WARNING: the same instance can be called from multiple threads
 class EvtHazard
@@ -23,6 +26,26 @@ public:
 			                        const SimpactEvent &evt, double Tdiff, double t0) = 0;
 
 	virtual void obtainConfig(ConfigWriter &config, const std::string &prefix) = 0;
+
+	// Can be used to calculate the times of several events that use this hazard
+	// at once; returns null if this is not supported
+	virtual EventBatchSolver *getBatchSolver()															{ return 0; }
+
+	// To allow an event to use thinning, this should return true and store an upper
+	// bound for the hazard for times starting from t0 in hMax; evaluate is then used
+	// to calculate the hazard at the candidate time
+	virtual bool getUpperBound(const SimpactPopulation &population, const SimpactEvent &evt, 
+	                           double t0, double &hMax)																{ return false; }
+	virtual double evaluate(const SimpactPopulation &population, const SimpactEvent &evt, double t)					{ abortWithMessage("EvtHazard::evaluate: not implemented for " + m_name); return 0; }
+
+	// For the formation hazards: the part of the a0 parameter that only depends on the
+	// two persons (their eagerness and the distance between them). It is calculated
+	// and stored by the formation event (see EventFormation::getPairTerm).
+	virtual double calculatePairTerm(Person *pPerson1, Person *pPerson2)							{ abortWithMessage("EvtHazard::calculatePairTerm: not implemented for " + m_name); return 0; }
+
+	// The SimpactEvent::SyncValue flags for the periodically synchronized values that
+	// the hazard depends on (see SimpactEvent::getSyncDependencies)
+	virtual int getSyncDependencies() const															{ return 0; }
 private:
 	const std::string m_name;
 };
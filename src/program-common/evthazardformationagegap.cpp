@@ -69,7 +69,7 @@ double EvtHazardFormationAgeGap::calculateInternalTimeInterval(const SimpactPopu
 	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
 	double lastDissTime = eventFormation.getLastDissolutionTime();
 
-	double a0 = getA0(population, pPerson1, pPerson2);
+	double a0 = getA0(population, eventFormation);
 	double tr = getTr(population, pPerson1, pPerson2, t0, lastDissTime);
 
 	// Note: we need to use a0 here, not m_a0
@@ -90,7 +90,7 @@ double EvtHazardFormationAgeGap::solveForRealTimeInterval(const SimpactPopulatio
 	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
 	double lastDissTime = eventFormation.getLastDissolutionTime();
 
-	double a0 = getA0(population, pPerson1, pPerson2);
+	double a0 = getA0(population, eventFormation);
 	double tr = getTr(population, pPerson1, pPerson2, t0, lastDissTime);
 
 	// Note: we need to use a0 here, not m_a0
@@ -100,10 +100,64 @@ double EvtHazardFormationAgeGap::solveForRealTimeInterval(const SimpactPopulatio
 	return h.solveForRealTimeInterval(t0, Tdiff);
 }
 
-double EvtHazardFormationAgeGap::getA0(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2)
+bool EvtHazardFormationAgeGap::getUpperBound(const SimpactPopulation &population, const SimpactEvent &event, double t0, double &hMax)
+{
+	Person *pPerson1 = event.getPerson(0);
+	Person *pPerson2 = event.getPerson(1);
+
+	double tMax = getTMax(pPerson1, pPerson2);
+
+	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
+	double lastDissTime = eventFormation.getLastDissolutionTime();
+
+	double a0 = getA0(population, eventFormation);
+	double tr = getTr(population, pPerson1, pPerson2, t0, lastDissTime);
+
+	HazardFunctionFormationAgeGap h0(pPerson1, pPerson2, tr, a0, m_a1, m_a2, m_a3, m_a4, m_a5, m_a8, m_a9, m_a10, m_b, m_msm);
+
+	// After tMax the hazard stays constant
+	if (t0 >= tMax)
+		hMax = h0.evaluate(tMax);
+	else
+		hMax = h0.getMaximum(t0, tMax);
+
+	return true;
+}
+
+double EvtHazardFormationAgeGap::evaluate(const SimpactPopulation &population, const SimpactEvent &event, double t)
+{
+	Person *pPerson1 = event.getPerson(0);
+	Person *pPerson2 = event.getPerson(1);
+
+	double tMax = getTMax(pPerson1, pPerson2);
+
+	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
+	double lastDissTime = eventFormation.getLastDissolutionTime();
+
+	double a0 = getA0(population, eventFormation);
+	double tr = getTr(population, pPerson1, pPerson2, t, lastDissTime);
+
+	HazardFunctionFormationAgeGap h0(pPerson1, pPerson2, tr, a0, m_a1, m_a2, m_a3, m_a4, m_a5, m_a8, m_a9, m_a10, m_b, m_msm);
+	TimeLimitedHazardFunction h(h0, tMax);
+
+	return h.evaluate(t);
+}
+
+double EvtHazardFormationAgeGap::getA0(const SimpactPopulation &population, const EventFormation &eventFormation)
+{
+	// reduces to old code if eyeCapsFraction == 1
+	double a0_total = eventFormation.getPairTerm() - getLogPopulationTerm(population); // log(x/(n/2)) = log(x) - log(n/2) = a0_base - log(n/2)
+	
+	return a0_total;
+}
+
+int EvtHazardFormationAgeGap::getSyncDependencies() const
+{
+	return SimpactEvent::SyncPopulationSize;
+}
+
+double EvtHazardFormationAgeGap::calculatePairTerm(Person *pPerson1, Person *pPerson2)
 {
-	double lastPopSizeTime = 0;
-	double n = population.getLastKnownPopulationSize(lastPopSizeTime);
 	double a0i, a0j;
 	
 	if (m_msm)
@@ -119,11 +173,68 @@ double EvtHazardFormationAgeGap::getA0(const SimpactPopulation &population, Pers
 	double a0_base = m_a0 + (a0i + a0j)*m_a6 + std::abs(a0i-a0j)*m_a7;
 	a0_base += m_aDist * pPerson1->getDistanceTo(pPerson2);
 
+	return a0_base;
+}
+
+double EvtHazardFormationAgeGap::getLogPopulationTerm(const SimpactPopulation &population)
+{
+	double lastPopSizeTime = 0;
+	double n = population.getLastKnownPopulationSize(lastPopSizeTime);
 	double eyeCapsFraction = population.getEyeCapsFraction();
-	// reduces to old code if eyeCapsFraction == 1
-	double a0_total = a0_base - std::log((n/2.0)*eyeCapsFraction); // log(x/(n/2)) = log(x) - log(n/2) = a0_base - log(n/2)
-	
-	return a0_total;
+
+	return std::log((n/2.0)*eyeCapsFraction);
+}
+
+void EvtHazardFormationAgeGap::setBatchEntry(int i, const SimpactPopulation &population, EventBase *pEvt, double logPopTerm, double t0, double x)
+{
+	const EventFormation *pEvtFormation = static_cast<const EventFormation *>(pEvt);
+	Person *pPerson1 = pEvtFormation->getPerson(0);
+	Person *pPerson2 = pEvtFormation->getPerson(1);
+
+	double tMax = getTMax(pPerson1, pPerson2);
+	double a0 = pEvtFormation->getPairTerm() - logPopTerm;
+	double tr = getTr(population, pPerson1, pPerson2, t0, pEvtFormation->getLastDissolutionTime());
+	double A, B;
+
+	HazardFunctionFormationAgeGap::getExpParameters(pPerson1, pPerson2, tr, a0, m_a1, m_a2, m_a3, m_a4, m_a5, m_a9, m_b, m_msm, A, B);
+	m_batch.setEntry(i, A, B, tMax, t0, x);
+}
+
+void EvtHazardFormationAgeGap::solveForRealTimeIntervals(const State *pState, EventBase **ppEvents, int num, double t0)
+{
+	assert(m_a8 == 0 && m_a10 == 0);
+
+	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	const double logPopTerm = getLogPopulationTerm(population);
+
+	m_batch.resize(num);
+	for (int i = 0 ; i < num ; i++)
+		setBatchEntry(i, population, ppEvents[i], logPopTerm, t0, ppEvents[i]->getInternalTimeLeft());
+
+	m_batch.solveForRealTimeIntervals();
+
+	for (int i = 0 ; i < num ; i++)
+		ppEvents[i]->setRealTimeInterval(pState, t0, m_batch.getResult(i));
+}
+
+void EvtHazardFormationAgeGap::subtractInternalTimeIntervals(const State *pState, EventBase **ppEvents, int num, double t1)
+{
+	assert(m_a8 == 0 && m_a10 == 0);
+
+	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	const double logPopTerm = getLogPopulationTerm(population);
+
+	m_batch.resize(num);
+	for (int i = 0 ; i < num ; i++)
+	{
+		double t0 = ppEvents[i]->getLastCalculationTime();
+		setBatchEntry(i, population, ppEvents[i], logPopTerm, t0, t1 - t0);
+	}
+
+	m_batch.calculateInternalTimeIntervals();
+
+	for (int i = 0 ; i < num ; i++)
+		ppEvents[i]->subtractInternalTimeInterval(pState, t1, m_batch.getResult(i));
 }
 
 double EvtHazardFormationAgeGap::getTr(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2, double t0, double lastDissTime)
@@ -135,8 +246,8 @@ double EvtHazardFormationAgeGap::getTr(const SimpactPopulation &population, Pers
 	if (tr < 0) // did not have a relationship before, use 
 	{
 		// get time at which both persons became 15 years (or in general, the debut age) old
-		double t1 = tBi+EventDebut::getDebutAge();
-		double t2 = tBj+EventDebut::getDebutAge();
+		double t1 = tBi+EventDebut::getDebutAge(population.getContext());
+		double t2 = tBj+EventDebut::getDebutAge(population.getContext());
 
 		tr = std::max(t1,t2);
 
@@ -3,13 +3,20 @@
 #define EVTHAZARDFORMATIONAGEGAP_H
 
 #include "evthazard.h"
+#include "eventbatchsolver.h"
+#include "hazardfunctionexpbatch.h"
 
 class Person;
+class EventFormation;
 class ConfigSettings;
 
 // WARNING: the same instance can be called from multiple threads
+//          (but the batch solver functions are only used by the serial algorithm)
 
-class EvtHazardFormationAgeGap : public EvtHazard
+// The batch solver uses HazardFunctionExpBatch, so its time intervals differ from the
+// ones of the scalar calculation by a relative amount of at most about 1e-11
+
+class EvtHazardFormationAgeGap : public EvtHazard, public EventBatchSolver
 {
 public:
 	EvtHazardFormationAgeGap(const std::string &hazName, bool msm,
@@ -22,11 +29,22 @@ public:
 	                                     const SimpactEvent &event, double t0, double dt);
 	double solveForRealTimeInterval(const SimpactPopulation &population,
 			                const SimpactEvent &event, double Tdiff, double t0);
+	bool getUpperBound(const SimpactPopulation &population, const SimpactEvent &event, double t0, double &hMax);
+	double evaluate(const SimpactPopulation &population, const SimpactEvent &event, double t);
+	double calculatePairTerm(Person *pPerson1, Person *pPerson2);
+	int getSyncDependencies() const;
+
+	// Only possible if m_a8 and m_a10 are zero, then the hazard is a simple exponential one
+	EventBatchSolver *getBatchSolver()									{ return (m_a8 == 0 && m_a10 == 0)?this:0; }
+	void solveForRealTimeIntervals(const State *pState, EventBase **ppEvents, int num, double t0);
+	void subtractInternalTimeIntervals(const State *pState, EventBase **ppEvents, int num, double t1);
 
 	static EvtHazard *processConfig(ConfigSettings &config, const std::string &prefix, const std::string &hazName, bool msm);
 	void obtainConfig(ConfigWriter &writer, const std::string &prefix);
 private:
-	double getA0(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2);
+	double getA0(const SimpactPopulation &population, const EventFormation &eventFormation);
+	double getLogPopulationTerm(const SimpactPopulation &population);
+	void setBatchEntry(int i, const SimpactPopulation &population, EventBase *pEvt, double logPopTerm, double t0, double x);
 	double getTr(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2, double t0, double lastDissTime);
 	double getTMax(Person *pPerson1, Person *pPerson2);
 
@@ -46,6 +64,8 @@ private:
 	double m_tMax;		
 
 	bool m_msm;
+
+	HazardFunctionExpBatch m_batch;
 };
 
 #endif // EVTHAZARDFORMATIONAGEGAP_H
@@ -83,7 +83,7 @@ double EvtHazardFormationAgeGapRefYear::calculateInternalTimeInterval(const Simp
 	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
 	double lastDissTime = eventFormation.getLastDissolutionTime();
 
-	double a0 = getA0(population, pPerson1, pPerson2);
+	double a0 = getA0(population, eventFormation);
 	double tr = getTr(population, pPerson1, pPerson2, t0, lastDissTime);
 	double ageRefYear = population.getReferenceYear();
 
@@ -113,7 +113,7 @@ double EvtHazardFormationAgeGapRefYear::solveForRealTimeInterval(const SimpactPo
 	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
 	double lastDissTime = eventFormation.getLastDissolutionTime();
 
-	double a0 = getA0(population, pPerson1, pPerson2);
+	double a0 = getA0(population, eventFormation);
 	double tr = getTr(population, pPerson1, pPerson2, t0, lastDissTime);
 	double ageRefYear = population.getReferenceYear();
 
@@ -132,10 +132,13 @@ double EvtHazardFormationAgeGapRefYear::solveForRealTimeInterval(const SimpactPo
 	return h.solveForRealTimeInterval(t0, Tdiff);
 }
 
-double EvtHazardFormationAgeGapRefYear::getA0(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2)
+int EvtHazardFormationAgeGapRefYear::getSyncDependencies() const
+{
+	return SimpactEvent::SyncPopulationSize|SimpactEvent::SyncReferenceYear;
+}
+
+double EvtHazardFormationAgeGapRefYear::calculatePairTerm(Person *pPerson1, Person *pPerson2)
 {
-	double lastPopSizeTime = 0;
-	double n = population.getLastKnownPopulationSize(lastPopSizeTime);
 	double a0i, a0j;
 	
 	if (m_msm)
@@ -151,6 +154,15 @@ double EvtHazardFormationAgeGapRefYear::getA0(const SimpactPopulation &populatio
 	double a0_base = m_a0 + (a0i + a0j)*m_a6 + std::abs(a0i-a0j)*m_a7;
 	a0_base += m_aDist * pPerson1->getDistanceTo(pPerson2);
 
+	return a0_base;
+}
+
+double EvtHazardFormationAgeGapRefYear::getA0(const SimpactPopulation &population, const EventFormation &eventFormation)
+{
+	double lastPopSizeTime = 0;
+	double n = population.getLastKnownPopulationSize(lastPopSizeTime);
+	double a0_base = eventFormation.getPairTerm();
+
 	double eyeCapsFraction = population.getEyeCapsFraction();
 	// reduces to old code if eyeCapsFraction == 1
 	double a0_total = a0_base - std::log((n/2.0)*eyeCapsFraction); // log(x/(n/2)) = log(x) - log(n/2) = a0_base - log(n/2)
@@ -167,8 +179,8 @@ double EvtHazardFormationAgeGapRefYear::getTr(const SimpactPopulation &populatio
 	if (tr < 0) // did not have a relationship before, use 
 	{
 		// get time at which both persons became 15 years (or in general, the debut age) old
-		double t1 = tBi+EventDebut::getDebutAge();
-		double t2 = tBj+EventDebut::getDebutAge();
+		double t1 = tBi+EventDebut::getDebutAge(population.getContext());
+		double t2 = tBj+EventDebut::getDebutAge(population.getContext());
 
 		tr = std::max(t1,t2);
 
@@ -67,7 +67,7 @@ double EvtHazardFormationSimple::calculateInternalTimeInterval(const SimpactPopu
 	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
 	double lastDissTime = eventFormation.getLastDissolutionTime();
 
-	double a0 = getA0(population, pPerson1, pPerson2);
+	double a0 = getA0(population, eventFormation);
 	double tr = getTr(population, pPerson1, pPerson2, t0, lastDissTime);
 
 	// Note: we need to use a0 here, not m_a0
@@ -90,7 +90,7 @@ double EvtHazardFormationSimple::solveForRealTimeInterval(const SimpactPopulatio
 	const EventFormation &eventFormation = static_cast<const EventFormation &>(event);
 	double lastDissTime = eventFormation.getLastDissolutionTime();
 
-	double a0 = getA0(population, pPerson1, pPerson2);
+	double a0 = getA0(population, eventFormation);
 	double tr = getTr(population, pPerson1, pPerson2, t0, lastDissTime);
 
 	// Note: we need to use a0 here, not m_a0
@@ -101,15 +101,27 @@ double EvtHazardFormationSimple::solveForRealTimeInterval(const SimpactPopulatio
 	//return ExponentialHazardToRealTime(pPerson1, pPerson2, t0, Tdiff, tr, a0, m_a1, m_a2, m_a3, m_a4, m_a5, m_Dp, m_b, true, tMax);
 }
 
-double EvtHazardFormationSimple::getA0(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2)
+int EvtHazardFormationSimple::getSyncDependencies() const
+{
+	return SimpactEvent::SyncPopulationSize;
+}
+
+double EvtHazardFormationSimple::calculatePairTerm(Person *pPerson1, Person *pPerson2)
 {
-	double lastKnownPopSizeTime = 0;
-	double n = population.getLastKnownPopulationSize(lastKnownPopSizeTime);
 	double a0i = pPerson1->getFormationEagernessParameter();
 	double a0j = pPerson2->getFormationEagernessParameter();
 	double a0_base = m_a0 + (a0i + a0j)*m_a6 * std::abs(a0i-a0j)*m_a7;
 	a0_base += m_aDist * pPerson1->getDistanceTo(pPerson2);
 
+	return a0_base;
+}
+
+double EvtHazardFormationSimple::getA0(const SimpactPopulation &population, const EventFormation &eventFormation)
+{
+	double lastKnownPopSizeTime = 0;
+	double n = population.getLastKnownPopulationSize(lastKnownPopSizeTime);
+	double a0_base = eventFormation.getPairTerm();
+
 	double eyeCapsFraction = population.getEyeCapsFraction();
 	// reduces to old code if eyeCapsFraction == 1
 	double a0_total = a0_base - std::log((n/2.0)*eyeCapsFraction); // log(x/(n/2)) = log(x) - log(n/2) = a0_base - log(n/2)
@@ -126,8 +138,8 @@ double EvtHazardFormationSimple::getTr(const SimpactPopulation &population, Pers
 	if (tr < 0) // did not have a relationship before, use 
 	{
 		// get time at which both persons became 15 years (or in general, the debut age) old
-		double t1 = tBi+EventDebut::getDebutAge();
-		double t2 = tBj+EventDebut::getDebutAge();
+		double t1 = tBi+EventDebut::getDebutAge(population.getContext());
+		double t2 = tBj+EventDebut::getDebutAge(population.getContext());
 
 		tr = std::max(t1,t2);
 
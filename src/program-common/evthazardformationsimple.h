@@ -5,6 +5,7 @@
 #include "evthazard.h"
 
 class Person;
+class EventFormation;
 class ConfigSettings;
 
 // WARNING: the same instance can be called from multiple threads
@@ -20,11 +21,13 @@ public:
 	                                     const SimpactEvent &event, double t0, double dt);
 	double solveForRealTimeInterval(const SimpactPopulation &population,
 			                const SimpactEvent &event, double Tdiff, double t0);
+	double calculatePairTerm(Person *pPerson1, Person *pPerson2);
+	int getSyncDependencies() const;
 
 	static EvtHazard *processConfig(ConfigSettings &config, const std::string &prefix, const std::string &hazName, bool msm);
 	void obtainConfig(ConfigWriter &writer, const std::string &prefix);
 private:
-	double getA0(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2);
+	double getA0(const SimpactPopulation &population, const EventFormation &eventFormation);
 	double getTr(const SimpactPopulation &population, Person *pPerson1, Person *pPerson2, double t0, double lastDissTime);
 	double getTMax(Person *pPerson1, Person *pPerson2);
 
@@ -1,6 +1,7 @@
 #include "hazardfunctionformationagegap.h"
 #include "hazardfunctionformationsimple.h"
 #include <iostream>
+#include <algorithm>
 #include <assert.h>
 
 using namespace std;
@@ -47,6 +48,29 @@ double HazardFunctionFormationAgeGap::evaluate(double t)
 			+ m_b*(t-m_tr));
 }
 
+// The hazard is continuous and exponential between the tipping points,
+// so the maximum is either at one of the tipping points or at the borders
+double HazardFunctionFormationAgeGap::getMaximum(double t0, double t1)
+{
+	assert(t0 <= t1);
+
+	double hMax = std::max(evaluate(t0), evaluate(t1));
+
+	if (m_a8 == 0 && m_a10 == 0) // no tipping points
+		return hMax;
+
+	double tp1, tp2, B, C, D;
+
+	getTippingPoints(tp1, tp2, B, C, D);
+
+	if (tp1 > t0 && tp1 < t1)
+		hMax = std::max(hMax, evaluate(tp1));
+	if (tp2 > t0 && tp2 < t1)
+		hMax = std::max(hMax, evaluate(tp2));
+
+	return hMax;
+}
+
 double HazardFunctionFormationAgeGap::calculateInternalTimeInterval(double t0, double dt)
 {
 	if (m_a8 == 0 && m_a10 == 0)
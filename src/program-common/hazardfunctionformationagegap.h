@@ -18,6 +18,15 @@ public:
 	double evaluate(double t);
 	double calculateInternalTimeInterval(double t0, double dt);
 	double solveForRealTimeInterval(double t0, double Tdiff);
+
+	// Returns the maximum value of the hazard on the interval [t0, t1]
+	double getMaximum(double t0, double t1);
+
+	// In case a8 and a10 are both zero, the hazard is simply exp(A+B*t), this
+	// calculates A and B for the specified parameters
+	static void getExpParameters(const Person *pPerson1, const Person *pPerson2, double tr,
+	                             double a0, double a1, double a2, double a3, double a4,
+	                             double a5, double a9, double b, bool msm, double &A, double &B);
 private:
 	void getTippingPoints(double &t1, double &t2, double &B, double &C, double &D);
 	void getEFValues(double t, double B, double C, double D, double &E, double &F);
@@ -62,6 +71,26 @@ inline void HazardFunctionFormationAgeGap::getPreferredAgeDifferences(bool msm,
 	}
 }
 
+inline void HazardFunctionFormationAgeGap::getExpParameters(const Person *pPerson1, const Person *pPerson2, double tr,
+                                                            double a0, double a1, double a2, double a3, double a4,
+                                                            double a5, double a9, double b, bool msm, double &A, double &B)
+{
+	double Pi = pPerson1->getNumberOfRelationships();
+	double Pj = pPerson2->getNumberOfRelationships();
+	double tBi = pPerson1->getDateOfBirth();
+	double tBj = pPerson2->getDateOfBirth();
+
+	double Dpi, Dpj;
+	getPreferredAgeDifferences(msm, pPerson1, pPerson2, Dpi, Dpj);
+
+	// Same as the HazardFunctionFormationSimple version that's used in this case
+	a0 += a5*std::abs(tBj-tBi-Dpi);
+	a0 += a9*std::abs(tBj-tBi-Dpj);
+
+	A = a0 + a1*Pi + a2*Pj + a3*std::abs(Pi-Pj) - a4*(tBi + tBj)/2.0 - b*tr;
+	B = a4 + b;
+}
+
 inline void HazardFunctionFormationAgeGap::getTippingPoints(double &t1, double &t2, double &B, double &C, double &D)
 {
 	double Pi = m_pPerson1->getNumberOfRelationships();
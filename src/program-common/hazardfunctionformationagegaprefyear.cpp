@@ -51,7 +51,7 @@ HazardFunctionFormationAgeGapRefYear::HazardFunctionFormationAgeGapRefYear(const
 	double A = a0 + a3*(Pi-Pj) - a4*(tBi+tBj)/2.0 - b*tr;
 	double B = a4 + b;
 
-	double ageDebut = EventDebut::getDebutAge();
+	double ageDebut = EventDebut::getDebutAge(pPerson1->getContext());
 	double a5 = agfmConst + agfmExp * std::exp( agfmAge*(Ai-ageDebut) );
 	double a9 = agfwConst + agfwExp * std::exp( agfwAge*(Aj-ageDebut) );
 
@@ -6,8 +6,11 @@
 
 using namespace std;
 
+SimpactContext::Slot<LogSystem> LogSystem::s_logSystem;
+
 void LogSystem::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	LogSystem &logs = get(SimpactContext::getConfigContext());
 	string eventLogFile, personLogFile, relationLogFile, treatmentLogFile, settingsLogFile;
 	string locationLogFile, hivVLLogFile;
 	bool_t r;
@@ -24,76 +27,69 @@ void LogSystem::processConfig(ConfigSettings &config, GslRandomNumberGenerator *
 
 	if (eventLogFile.length() > 0)
 	{
-		if (!(r = logEvents.open(eventLogFile)))
+		if (!(r = logs.logEvents.open(eventLogFile)))
 			abortWithMessage("Unable to open event log file: " + r.getErrorString());
 	}
 
 	if (personLogFile.length() > 0)
 	{
-		if (!(r = logPersons.open(personLogFile)))
+		if (!(r = logs.logPersons.open(personLogFile)))
 			abortWithMessage("Unable to open person log file: " + r.getErrorString());
 	}
 
 	if (relationLogFile.length() > 0)
 	{
-		if (!(r = logRelations.open(relationLogFile)))
+		if (!(r = logs.logRelations.open(relationLogFile)))
 			abortWithMessage("Unable to open relationship log file: " + r.getErrorString());
 	}
 
 	if (treatmentLogFile.length() > 0)
 	{
-		if (!(r = logTreatment.open(treatmentLogFile)))
+		if (!(r = logs.logTreatment.open(treatmentLogFile)))
 			abortWithMessage("Unable to open treatment log file: " + r.getErrorString());
 	}
 
 	if (settingsLogFile.length() > 0)
 	{
-		if (!(r = logSettings.open(settingsLogFile)))
+		if (!(r = logs.logSettings.open(settingsLogFile)))
 			abortWithMessage("Unable to open settings log file: " + r.getErrorString());
 	}
 
 	if (locationLogFile.length() > 0)
 	{
-		if (!(r = logLocation.open(locationLogFile)))
+		if (!(r = logs.logLocation.open(locationLogFile)))
 			abortWithMessage("Unable to open location log file: " + r.getErrorString());
 	}
 
 	if (hivVLLogFile.length() > 0)
 	{
-		if (!(r = logViralLoadHIV.open(hivVLLogFile)))
+		if (!(r = logs.logViralLoadHIV.open(hivVLLogFile)))
 			abortWithMessage("Unable to open HIV viral load log file: " + r.getErrorString());
 	}
 
-	logPersons.print("\"ID\",\"Gender\",\"TOB\",\"TOD\",\"IDF\",\"IDM\",\"TODebut\",\"FormEag\",\"FormEagMSM\",\"InfectTime\",\"InfectOrigID\",\"InfectType\",\"log10SPVL\",\"TreatTime\",\"XCoord\",\"YCoord\",\"AIDSDeath\",\"HSV2InfectTime\",\"HSV2InfectOriginID\",\"CD4atInfection\",\"CD4atDeath\"");
-	logRelations.print("\"ID1\",\"ID2\",\"FormTime\",\"DisTime\",\"AgeGap\",\"MSM\"");
-	logTreatment.print("\"ID\",\"Gender\",\"TStart\",\"TEnd\",\"DiedNow\",\"CD4atARTstart\"");
-	logLocation.print("\"Time\",\"ID\",\"XCoord\",\"YCoord\"");
-	logViralLoadHIV.print("\"Time\",\"ID\",\"Desc\",\"Log10SPVL\",\"Log10VL\"");
+	logs.logPersons.print("\"ID\",\"Gender\",\"TOB\",\"TOD\",\"IDF\",\"IDM\",\"TODebut\",\"FormEag\",\"FormEagMSM\",\"InfectTime\",\"InfectOrigID\",\"InfectType\",\"log10SPVL\",\"TreatTime\",\"XCoord\",\"YCoord\",\"AIDSDeath\",\"HSV2InfectTime\",\"HSV2InfectOriginID\",\"CD4atInfection\",\"CD4atDeath\"");
+	logs.logRelations.print("\"ID1\",\"ID2\",\"FormTime\",\"DisTime\",\"AgeGap\",\"MSM\"");
+	logs.logTreatment.print("\"ID\",\"Gender\",\"TStart\",\"TEnd\",\"DiedNow\",\"CD4atARTstart\"");
+	logs.logLocation.print("\"Time\",\"ID\",\"XCoord\",\"YCoord\"");
+	logs.logViralLoadHIV.print("\"Time\",\"ID\",\"Desc\",\"Log10SPVL\",\"Log10VL\"");
 }
 
 void LogSystem::obtainConfig(ConfigWriter &config)
 {
+	const LogSystem &logs = get(SimpactContext::getConfigContext());
 	bool_t r;
 
-	if (!(r = config.addKey("logsystem.outfile.logevents", logEvents.getFileName())) ||
-	    !(r = config.addKey("logsystem.outfile.logrelations", logRelations.getFileName())) ||
-	    !(r = config.addKey("logsystem.outfile.logpersons", logPersons.getFileName())) ||
-	    !(r = config.addKey("logsystem.outfile.logtreatments", logTreatment.getFileName())) ||
-		!(r = config.addKey("logsystem.outfile.logsettings", logSettings.getFileName())) ||
-		!(r = config.addKey("logsystem.outfile.loglocation", logLocation.getFileName())) ||
-		!(r = config.addKey("logsystem.outfile.logviralloadhiv", logViralLoadHIV.getFileName()))
+	if (!(r = config.addKey("logsystem.outfile.logevents", logs.logEvents.getFileName())) ||
+	    !(r = config.addKey("logsystem.outfile.logrelations", logs.logRelations.getFileName())) ||
+	    !(r = config.addKey("logsystem.outfile.logpersons", logs.logPersons.getFileName())) ||
+	    !(r = config.addKey("logsystem.outfile.logtreatments", logs.logTreatment.getFileName())) ||
+		!(r = config.addKey("logsystem.outfile.logsettings", logs.logSettings.getFileName())) ||
+		!(r = config.addKey("logsystem.outfile.loglocation", logs.logLocation.getFileName())) ||
+		!(r = config.addKey("logsystem.outfile.logviralloadhiv", logs.logViralLoadHIV.getFileName()))
 	    )
 		abortWithMessage(r.getErrorString());
 }
 
-LogFile LogSystem::logEvents;
-LogFile LogSystem::logPersons;
-LogFile LogSystem::logRelations;
-LogFile LogSystem::logTreatment;
-LogFile LogSystem::logSettings;
-LogFile LogSystem::logLocation;
-LogFile LogSystem::logViralLoadHIV;
-
 ConfigFunctions logSystemConfigFunctions(LogSystem::processConfig, LogSystem::obtainConfig, "00_LogSystem", "__first__");
 
 JSONConfig logSystemJSONConfig(R"JSON(
@@ -3,6 +3,7 @@
 #define LOGSYSTEM_H
 
 #include "logfile.h"
+#include "simpactcontext.h"
 
 class ConfigSettings;
 class ConfigWriter;
@@ -13,15 +14,13 @@ class LogSystem
 public: 
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
-	static LogFile logEvents, logPersons, logRelations, logTreatment, logSettings, logLocation, logViralLoadHIV;
-};
 
-#define LogEvent LogSystem::logEvents
-#define LogPerson LogSystem::logPersons
-#define LogRelation LogSystem::logRelations
-#define LogTreatment LogSystem::logTreatment
-#define LogSettings LogSystem::logSettings
-#define LogLocation LogSystem::logLocation
-#define LogViralLoadHIV LogSystem::logViralLoadHIV
+	// The log files of the simulation that uses this context
+	static LogSystem &get(SimpactContext &context)									{ return context.get(s_logSystem); }
+
+	LogFile logEvents, logPersons, logRelations, logTreatment, logSettings, logLocation, logViralLoadHIV;
+private:
+	static SimpactContext::Slot<LogSystem> s_logSystem;
+};
 
 #endif // LOGSYSTEM_H
@@ -3,6 +3,7 @@
 #include "person.h"
 #include "person_relations.h"
 #include "simpactpopulation.h"
+#include "simpactcontext.h"
 #include "configsettings.h"
 #include "inverseerfi.h"
 #include "version.h"
@@ -12,13 +13,21 @@
 #include "populationutil.h"
 #include "logsystem.h"
 #include "configsettingslog.h"
+#include "util.h"
+#include "mutex.h"
+#include "eventmemoryreport.h"
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <cmath>
 #include <iostream>
+#include <fstream>
 #include <limits>
 #include <memory>
+#include <vector>
+#ifndef DISABLEOPENMP
+#include <omp.h>
+#endif // !DISABLEOPENMP
 
 using namespace std;
 
@@ -33,6 +42,8 @@ void usage(const string &progName)
 {
 	cerr << "Usage: " << progName << " configfile.txt parallel algo(opt/simple)" << endl << endl;;
 	cerr << "or" << endl;
+	cerr << "Usage: " << progName << " --ensemble runs.csv numthreads algo(opt/simple)" << endl << endl;;
+	cerr << "or" << endl;
 	cerr << "Usage: " << progName << " --showconfigoptions" << endl << endl;;
 	cerr << endl;
 	cerr << "Version:  " << SIMPACT_CYAN_VERSION << endl;
@@ -40,43 +51,30 @@ void usage(const string &progName)
 	exit(-1);
 }
 
-int real_main(int argc, char **argv)
+// Runs one simulation, writing the messages to 'out'
+int runSimulation(const string &confFileName, GslRandomNumberGenerator &rng, bool parallel, const string &algo, ostream &out)
 {
-	if (argc == 2)
-	{
-		string flag = argv[1];
-		if (flag == "--showconfigoptions")
-		{
-			cout << JSONConfig::getFullConfigurationString() << endl;
-			return 0;
-		}
-	}
-	if (argc != 4)
-		usage(argv[0]);
-
-	string confFileName(argv[1]);
-	int intParallel = atoi(argv[2]);
-	bool parallel = (intParallel == 1);
-	std::string algo(argv[3]);
 	ConfigSettings config;
+	SimpactContext context; // the configuration below is stored in here
 	bool_t r;
 
+	SimpactContext::setConfigContext(&context);
+
 	if (!(r = config.load(confFileName)))
 	{
-		cerr << "Error loading configuration file " << confFileName << endl;
-		cerr << "  " << r.getErrorString() << endl;
+		out << "Error loading configuration file " << confFileName << endl;
+		out << "  " << r.getErrorString() << endl;
 		return -1;
 	}
 
-	GslRandomNumberGenerator rng;
 	PopulationDistributionCSV ageDist(&rng);
 	SimpactPopulationConfig populationConfig; // use defaults
 	double tMax = -1;
 	int64_t maxEvents = -1;
 
-	if (!(r = configure(config, populationConfig, ageDist, &rng, tMax, maxEvents)))
+	if (!(r = configure(config, populationConfig, ageDist, &rng, tMax, maxEvents, out)))
 	{
-		cerr << r.getErrorString() << endl;
+		out << r.getErrorString() << endl;
 		return -1;
 	}
 
@@ -85,7 +83,7 @@ int real_main(int argc, char **argv)
 
 	if (!(r = PopulationUtil::selectAlgorithmAndState(algo, rng, parallel, &pAlgo, &pState)))
 	{
-		cerr << r.getErrorString() << endl;
+		out << r.getErrorString() << endl;
 		return -1;
 	}
 
@@ -95,7 +93,7 @@ int real_main(int argc, char **argv)
 	SimpactPopulation *pPop = createSimpactPopulation(*pAlgo, *pState);
 	if (!pPop)
 	{
-		cerr << "Unexpected error: unable to allocate a SimpactPopulation derived class" << endl;
+		out << "Unexpected error: unable to allocate a SimpactPopulation derived class" << endl;
 		return -1;
 	}
 
@@ -103,7 +101,7 @@ int real_main(int argc, char **argv)
 
 	if (!(r = pPop->init(populationConfig, ageDist)))
 	{
-		cerr << "Unable to initialize population: " << r.getErrorString() << endl;
+		out << "Unable to initialize population: " << r.getErrorString() << endl;
 		return -1;
 	}
 
@@ -114,14 +112,14 @@ int real_main(int argc, char **argv)
 	runHazardTests(*pPop);
 #endif
 
-	cerr << "# Simpact version is: " << SIMPACT_CYAN_VERSION << endl;
+	out << "# Simpact version is: " << SIMPACT_CYAN_VERSION << endl;
 
 	logInitialLocations(*pPop);
 
 	if (!(r = pPop->run(tMax, maxEvents)))
 	{
 		string reason = r.getErrorString();
-		cerr << "# Error running simulation: " << reason << endl;
+		out << "# Error running simulation: " << reason << endl;
 		if (reason.find("NaN") != string::npos)
 			abortWithMessage("NaN detected in internal event time calculation");
 
@@ -129,12 +127,16 @@ int real_main(int argc, char **argv)
 			abortWithMessage(reason);
 	}
 
-	cerr << "# Current simulation time is " << pPop->getTime() << endl;
+	out << "# Current simulation time is " << pPop->getTime() << endl;
 
 	int numEndPeople = pPop->getNumberOfPeople();
 
-	cerr << "# Number of events executed is " << maxEvents << endl;
-	cerr << "# Started with " << numInitPeople << " people, ending with " << numEndPeople << " (difference is " << numEndPeople-numInitPeople << ")" << endl;
+	out << "# Number of events executed is " << maxEvents << endl;
+	out << "# Started with " << numInitPeople << " people, ending with " << numEndPeople << " (difference is " << numEndPeople-numInitPeople << ")" << endl;
+
+	// Optionally report how much memory is used by the events that are still pending
+	if (getenv("SIMPACT_EVENT_MEMORY_REPORT") != 0)
+		EventMemoryReport::write(*pPop, out);
 
 	// Log ongoing relationships
 	logOnGoingRelationships(*pPop);
@@ -143,11 +145,142 @@ int real_main(int argc, char **argv)
 	logAllPersons(*pPop);
 
 	// Log config file
-	ConfigSettingsLog::writeConfigSettings(LogSettings);	
+	ConfigSettingsLog::get(context).writeConfigSettings(LogSystem::get(context).logSettings);	
 
 	return 0;
 }
 
+// Each line of the runs file contains a seed (negative to let the random number
+// generator choose one), the configuration file and the file to which the messages
+// of that simulation are written. These simulations are run in this process, using
+// numThreads threads (or one per processor core if this is not positive). Since
+// each simulation has its own SimpactContext, random number generator, population
+// and algorithm, they don't influence each other.
+int runEnsemble(const string &runsFileName, int numThreads, const string &algo)
+{
+	FILE *pFile = fopen(runsFileName.c_str(), "rt");
+	if (!pFile)
+	{
+		cerr << "Unable to open file " << runsFileName << endl;
+		return -1;
+	}
+
+	vector<int> seeds;
+	vector<string> confFileNames, outFileNames;
+	string line;
+
+	while (ReadInputLine(pFile, line))
+	{
+		line = trim(line);
+		if (line.length() == 0 || line[0] == '#')
+			continue;
+
+		vector<string> parts;
+		int seed = -1;
+
+		SplitLine(line, parts, ",", "\"", "", false);
+		if (parts.size() != 3 || !parseAsInt(trim(parts[0]), seed))
+		{
+			fclose(pFile);
+			cerr << "Expecting a seed, a configuration file and an output file on line '" << line << "' in " << runsFileName << endl;
+			return -1;
+		}
+
+		seeds.push_back(seed);
+		confFileNames.push_back(trim(parts[1]));
+		outFileNames.push_back(trim(parts[2]));
+	}
+	fclose(pFile);
+
+	const int numRuns = (int)seeds.size();
+	vector<int> status(numRuns, -1);
+	Mutex rngMutex; // the GslRandomNumberGenerator constructor sets up the global GSL defaults
+
+#ifndef DISABLEOPENMP
+	if (numThreads <= 0)
+		numThreads = omp_get_num_procs();
+
+	// The runs can take very different amounts of time, so they're handed out one by one
+	#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads)
+#endif // !DISABLEOPENMP
+	for (int i = 0 ; i < numRuns ; i++)
+	{
+		ofstream out(outFileNames[i].c_str());
+
+		if (!out.is_open())
+		{
+			cerr << "Unable to write to " << outFileNames[i] << endl;
+			continue;
+		}
+
+		// An exception can't leave this parallel loop. A fatal error, e.g. in the
+		// configuration, only stops this run
+		setThrowOnFatalError(true);
+		try
+		{
+			unique_ptr<GslRandomNumberGenerator> rng;
+			{
+				MutexLocker locker(rngMutex);
+				rng.reset((seeds[i] < 0)?new GslRandomNumberGenerator():new GslRandomNumberGenerator(seeds[i]));
+			}
+
+			out << "# Using seed " << rng->getSeed() << endl;
+			status[i] = runSimulation(confFileNames[i], *rng, false, algo, out);
+		}
+		catch(const bad_alloc &e)
+		{
+			out << "Out of memory!" << endl;
+		}
+		catch(const FatalErrorException &e)
+		{
+			out << "FATAL ERROR:" << endl;
+			out << e.what() << endl;
+		}
+		catch(const exception &e)
+		{
+			out << "Exception caught: " << e.what() << endl;
+		}
+		SimpactContext::setConfigContext(0); // the context of this run no longer exists
+		setThrowOnFatalError(false);
+
+		if (status[i] != 0)
+			cerr << "Error in run " << (i+1) << " (" << confFileNames[i] << "), see " << outFileNames[i] << endl;
+	}
+
+	for (int i = 0 ; i < numRuns ; i++)
+	{
+		if (status[i] != 0)
+			return -1;
+	}
+	return 0;
+}
+
+int real_main(int argc, char **argv)
+{
+	if (argc == 2)
+	{
+		string flag = argv[1];
+		if (flag == "--showconfigoptions")
+		{
+			cout << JSONConfig::getFullConfigurationString() << endl;
+			return 0;
+		}
+	}
+	if (argc == 5 && string(argv[1]) == "--ensemble")
+		return runEnsemble(argv[2], atoi(argv[3]), argv[4]);
+
+	if (argc != 4)
+		usage(argv[0]);
+
+	string confFileName(argv[1]);
+	int intParallel = atoi(argv[2]);
+	bool parallel = (intParallel == 1);
+	std::string algo(argv[3]);
+	GslRandomNumberGenerator rng;
+
+	return runSimulation(confFileName, rng, parallel, algo, cerr);
+}
+
 // Log current, non-dissolved relationships
 // TODO: we only iterate over the men, since relationships are logged in lists of both men and women
 // TODO: an extra check is done for MSM relations, so that they are not logged twice
@@ -164,10 +297,9 @@ void logOnGoingRelationships(SimpactPopulation &pop)
 		double formationTime = 0;
 		int numRelationships = pMan->getNumberOfRelationships();
 
-		pMan->startRelationshipIteration();
 		for (int j = 0 ; j < numRelationships ; j++)
 		{
-			pPartner = pMan->getNextRelationshipPartner(formationTime);
+			pPartner = pMan->getRelationshipPartner(j, formationTime);
 			assert(pPartner != 0);
 
 			bool writeToLog = false;
@@ -179,11 +311,6 @@ void logOnGoingRelationships(SimpactPopulation &pop)
 			if (writeToLog)
 				Person_Relations::writeToRelationLog(pMan, pPartner, formationTime, infinity); // infinity for not dissolved yet
 		}
-
-#ifndef NDEBUG
-		double tDummy;
-		assert(pMan->getNextRelationshipPartner(tDummy) == 0); // make sure the iteration is done
-#endif // NDEBUG
 	}
 }	
 
@@ -202,7 +329,11 @@ void logAllPersons(SimpactPopulation &pop)
 			pPerson->writeToTreatmentLog(infinity, false);
 	}
 
-	// deceased
+	// deceased, these have already been logged at the time of death if
+	// they're being released
+	if (pop.isReleasingDeceasedPeople())
+		return;
+
 	numPeople = pop.getNumberOfDeceasedPeople();
 	ppPersons = pop.getDeceasedPeople();
 	
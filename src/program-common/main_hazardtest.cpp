@@ -86,8 +86,8 @@ void runHazardTests(SimpactPopulation &pop)
 		//Woman **ppWomen = pop.getWomen();
 		//Man *pMan = ppMen[0];
 		//Woman *pWoman = ppWomen[0];
-		Man *pMan = new Man(60);
-		Woman *pWoman = new Woman(70);
+		Man *pMan = new Man(60, pop.getContext());
+		Woman *pWoman = new Woman(70, pop.getContext());
 
 		{
 			TestHazardFunction h0;
@@ -126,8 +126,8 @@ void runHazardTests(SimpactPopulation &pop)
 	}
 
 	{
-		Man *pMan = new Man(-30);
-		Woman *pWoman = new Woman(-20);
+		Man *pMan = new Man(-30, pop.getContext());
+		Woman *pWoman = new Woman(-20, pop.getContext());
 		pMan->hiv().setInfected(-10, 0, Person_HIV::Seed);
 		pWoman->hiv().setInfected(-15, 0, Person_HIV::Seed);
 
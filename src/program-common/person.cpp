@@ -14,16 +14,21 @@
 
 using namespace std;
 
-Person::Person(double dateOfBirth, Gender g) : PersonBase(g, dateOfBirth), m_relations(this), m_hiv(this),
-	                                           m_hsv2(this)
+Person::Person(double dateOfBirth, Gender g, SimpactContext &context) : PersonBase(g, dateOfBirth), m_context(context),
+	                                           m_relations(this, context), m_hiv(this, context), m_hsv2(this, context)
 {
 	assert(g == Male || g == Female);
 
-	assert(m_pPopDist);
+	ProbabilityDistribution2D *pPopDist = getPopulationDistribution(context);
+	assert(pPopDist);
 
-	Point2D loc = m_pPopDist->pickPoint();
+	m_pAttributeArrays = 0;
+	m_attributeIndex = -1;
+
+	Point2D loc = pPopDist->pickPoint();
 	assert(loc.x == loc.x && loc.y == loc.y); // check for NaN
 	setLocation(loc, 0);
+	m_coarseMapIndex = -1;
 
 	m_pPersonImpl = new PersonImpl(*this);
 }
@@ -33,23 +38,30 @@ Person::~Person()
 	delete m_pPersonImpl;
 }
 
-ProbabilityDistribution2D *Person::m_pPopDist = 0;
-double Person::m_popDistWidth = 0;
-double Person::m_popDistHeight = 0;
+PersonSettings::~PersonSettings()
+{
+	delete m_pPopDist;
+}
+
+SimpactContext::Slot<PersonSettings> Person::s_settings;
 
 void Person::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
 	assert(pRndGen != 0);
 
+	PersonSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
 	// Population distribution
-	delete m_pPopDist;
-	m_pPopDist = getDistribution2DFromConfig(config, pRndGen, "person.geo");
+	delete settings.m_pPopDist;
+	settings.m_pPopDist = getDistribution2DFromConfig(config, pRndGen, "person.geo");
 }
 
 void Person::obtainConfig(ConfigWriter &config)
 {
-	assert(m_pPopDist);
-	addDistribution2DToConfig(m_pPopDist, config, "person.geo");
+	const PersonSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	assert(settings.m_pPopDist);
+	addDistribution2DToConfig(settings.m_pPopDist, config, "person.geo");
 }
 
 void Person::writeToPersonLog()
@@ -62,10 +74,8 @@ void Person::writeToPersonLog()
 	double timeOfBirth = getDateOfBirth();
 	double timeOfDeath = (hasDied())?getTimeOfDeath():infinity;
 
-	Man *pFather = getFather();
-	Woman *pMother = getMother();
-	int fatherID = (pFather != 0) ? (int)pFather->getPersonID() : (-1); // TODO: cast should be ok
-	int motherID = (pMother != 0) ? (int)pMother->getPersonID() : (-1);
+	int fatherID = (int)getFatherID(); // TODO: cast should be ok
+	int motherID = (int)getMotherID();
 
 	// TODO: Currently not keeping track of children
 
@@ -74,8 +84,7 @@ void Person::writeToPersonLog()
 	double formationEagernessMSM = (isMan())?getFormationEagernessParameterMSM():NaN;
 	
 	double infectionTime = (m_hiv.isInfected())? m_hiv.getInfectionTime() : infinity;
-	Person *pOrigin = (m_hiv.isInfected())? m_hiv.getInfectionOrigin() : 0;
-	int origin = (pOrigin != 0) ? (int)pOrigin->getPersonID() : (-1); // TODO: cast should be ok
+	int origin = (m_hiv.isInfected())? (int)m_hiv.getInfectionOriginID() : (-1); // TODO: cast should be ok
 	
 	int infectionType = 0;
 	switch(m_hiv.getInfectionType())
@@ -108,13 +117,12 @@ void Person::writeToPersonLog()
 	}
 
 	double hsv2InfectionTime = (m_hsv2.isInfected())? m_hsv2.getInfectionTime() : infinity;
-	Person *pHSV2Origin = (m_hsv2.isInfected()) ? m_hsv2.getInfectionOrigin() : 0;
-	int hsv2origin = (pHSV2Origin != 0) ? (int)pHSV2Origin->getPersonID() : (-1); // TODO: cast should be ok
+	int hsv2origin = (m_hsv2.isInfected()) ? (int)m_hsv2.getInfectionOriginID() : (-1); // TODO: cast should be ok
 
 	double cd4AtInfection = (m_hiv.isInfected())?m_hiv.getCD4CountAtInfectionStart() : (-1);
 	double cd4AtDeath = (m_hiv.isInfected())?m_hiv.getCD4CountAtDeath() : (-1);
 
-	LogPerson.print("%d,%d,%10.10f,%10.10f,%d,%d,%10.10f,%10.10f,%10.10f,%10.10f,%d,%d,%10.10f,%10.10f,%10.10f,%10.10f,%d,%10.10f,%d,%10.10f,%10.10f",
+	LogSystem::get(m_context).logPersons.print("%d,%d,%10.10f,%10.10f,%d,%d,%10.10f,%10.10f,%10.10f,%10.10f,%d,%d,%10.10f,%10.10f,%10.10f,%10.10f,%d,%10.10f,%d,%10.10f,%10.10f",
 		        id, gender, timeOfBirth, timeOfDeath, fatherID, motherID, debutTime,
 		        formationEagerness,formationEagernessMSM,
 		        infectionTime, origin, infectionType, log10SPVLoriginal, treatmentTime,
@@ -124,7 +132,7 @@ void Person::writeToPersonLog()
 
 void Person::writeToLocationLog(double tNow)
 {
-	LogLocation.print("%10.10f,%d,%10.10f,%10.10f", tNow, (int)getPersonID(), m_location.x, m_location.y);
+	LogSystem::get(m_context).logLocation.print("%10.10f,%d,%10.10f,%10.10f", tNow, (int)getPersonID(), m_location.x, m_location.y);
 }
 
 void Person::writeToTreatmentLog(double dropoutTime, bool justDied)
@@ -138,11 +146,11 @@ void Person::writeToTreatmentLog(double dropoutTime, bool justDied)
 	assert(m_hiv.hasLoweredViralLoad());
 	assert(lastTreatmentStartTime >= 0);
 
-	LogTreatment.print("%d,%d,%10.10f,%10.10f,%d,%10.10f", id, gender, lastTreatmentStartTime, 
+	LogSystem::get(m_context).logTreatment.print("%d,%d,%10.10f,%10.10f,%d,%10.10f", id, gender, lastTreatmentStartTime, 
 	                                                       dropoutTime, justDiedInt, lastCD4);
 }
 
-Man::Man(double dateOfBirth) : Person(dateOfBirth, Male)
+Man::Man(double dateOfBirth, SimpactContext &context) : Person(dateOfBirth, Male, context)
 {
 }
 
@@ -150,7 +158,7 @@ Man::~Man()
 {
 }
 
-Woman::Woman(double dateOfBirth) : Person(dateOfBirth, Female)
+Woman::Woman(double dateOfBirth, SimpactContext &context) : Person(dateOfBirth, Female, context)
 {
 	m_pregnant = false;
 }
@@ -7,6 +7,8 @@
 #include "person_relations.h"
 #include "person_hiv.h"
 #include "person_hsv2.h"
+#include "personattributearrays.h"
+#include "simpactcontext.h"
 #include "probabilitydistribution2d.h"
 #include "util.h"
 #include <stdlib.h>
@@ -29,10 +31,19 @@ class VspModel;
 Man *MAN(Person *pPerson);
 Woman *WOMAN(Person *pPerson);
 
+class PersonSettings
+{
+public:
+	PersonSettings()																{ m_pPopDist = 0; }
+	~PersonSettings();
+
+	ProbabilityDistribution2D *m_pPopDist;
+};
+
 class Person : public PersonBase
 {
 public:
-	Person(double dateOfBirth, Gender g);
+	Person(double dateOfBirth, Gender g, SimpactContext &context);
 	~Person();
 
 	PersonImpl *getImplementationSpecificPart()										{ return m_pPersonImpl; }
@@ -41,33 +52,38 @@ public:
 	bool isWoman() const															{ return getGender() == Female; }
 
 	// Family stuff
-	void setFather(Man *pFather)													{ m_family.setFather(pFather); }
-	void setMother(Woman *pMother)													{ m_family.setMother(pMother); }
+	void setFather(Man *pFather);
+	void setMother(Woman *pMother);
 
 	Man *getFather() const															{ return m_family.getFather(); }
 	Woman *getMother() const														{ return m_family.getMother(); }
+	int64_t getFatherID() const														{ return m_family.getFatherID(); }
+	int64_t getMotherID() const														{ return m_family.getMotherID(); }
+	void clearFather()																{ m_family.clearFather(); }
+	void clearMother()																{ m_family.clearMother(); }
 
 	void addChild(Person *pPerson)													{ m_family.addChild(pPerson); }
+	void removeChild(Person *pPerson)												{ m_family.removeChild(pPerson); }
 	bool hasChild(Person *pPerson) const											{ return m_family.hasChild(pPerson); }
 	int getNumberOfChildren() const													{ return m_family.getNumberOfChildren(); }
 	Person *getChild(int idx);
 
 	// Relationship stuff
 	int getNumberOfRelationships() const											{ return m_relations.getNumberOfRelationships(); }
-	void startRelationshipIteration()												{ m_relations.startRelationshipIteration(); }
-	Person *getNextRelationshipPartner(double &formationTime)						{ return m_relations.getNextRelationshipPartner(formationTime); }
-	int getNumberOfDiagnosedPartners()												{ return m_relations.getNumberOfDiagnosedPartners(); }
+	Person *getRelationshipPartner(int idx) const									{ return m_relations.getRelationshipPartner(idx); }
+	Person *getRelationshipPartner(int idx, double &formationTime) const			{ return m_relations.getRelationshipPartner(idx, formationTime); }
+	int getNumberOfDiagnosedPartners() const										{ return m_relations.getNumberOfDiagnosedPartners(); }
 
 	bool hasRelationshipWith(Person *pPerson) const									{ return m_relations.hasRelationshipWith(pPerson); }
 
 	// WARNING: do not use these during relationship iteration
-	void addRelationship(Person *pPerson, double t)									{ m_relations.addRelationship(pPerson, t); }
-	void removeRelationship(Person *pPerson, double t, bool deathBased)				{ m_relations.removeRelationship(pPerson, t, deathBased); }
+	void addRelationship(Person *pPerson, double t)									{ m_relations.addRelationship(pPerson, t); updateAttributeArrays(); }
+	void removeRelationship(Person *pPerson, double t, bool deathBased)				{ m_relations.removeRelationship(pPerson, t, deathBased); updateAttributeArrays(); }
 	
 	// result is negative if no relations formed yet
 	double getLastRelationshipChangeTime() const									{ return m_relations.getLastRelationshipChangeTime(); }
 
-	void setSexuallyActive(double t)												{ m_relations.setSexuallyActive(t); }
+	void setSexuallyActive(double t)												{ m_relations.setSexuallyActive(t); updateAttributeArrays(); }
 	bool isSexuallyActive() const													{ return m_relations.isSexuallyActive(); }
 	double getDebutTime() const														{ return m_relations.getDebutTime(); }
 
@@ -102,12 +118,27 @@ public:
 	void writeToLocationLog(double tNow);
 
 	Point2D getLocation() const														{ return m_location; }
-	void setLocation(Point2D loc, double tNow)										{ m_location = loc; m_locationTime = tNow; }
+	void setLocation(Point2D loc, double tNow)										{ m_location = loc; m_locationTime = tNow; updateAttributeArrays(); }
 	double getLocationTime() const													{ return m_locationTime; }
 
 	double getDistanceTo(Person *pPerson);
-	static ProbabilityDistribution2D *getPopulationDistribution()					{ return m_pPopDist; }
+	static ProbabilityDistribution2D *getPopulationDistribution(const SimpactContext &context)	{ return context.get(s_settings).m_pPopDist; }
+
+	// For use by the CoarseMap: the position in the list of the cell the person is in
+	int getCoarseMapIndex() const													{ return m_coarseMapIndex; }
+	void setCoarseMapIndex(int idx)													{ m_coarseMapIndex = idx; }
+
+	// For use by the SimpactPopulation: the arrays in which some attributes of this
+	// person are copied, and the position in them (negative if deceased)
+	void setAttributeArrays(PersonAttributeArrays *pArrays, int idx)				{ m_pAttributeArrays = pArrays; m_attributeIndex = idx; updateAttributeArrays(); }
+	void updateAttributeArrays() const												{ if (m_pAttributeArrays) m_pAttributeArrays->update(m_attributeIndex, this); }
+
+	// The settings of the simulation this person belongs to
+	SimpactContext &getContext() const												{ return m_context; }
 private:
+	// Is initialized first, the parts below already use it in their constructors
+	SimpactContext &m_context;
+
 	Person_Family m_family;
 	Person_Relations m_relations;
 	Person_HIV m_hiv;
@@ -115,25 +146,27 @@ private:
 
 	Point2D m_location;
 	double m_locationTime;
+	int m_coarseMapIndex;
+
+	PersonAttributeArrays *m_pAttributeArrays;
+	int m_attributeIndex;
 
 	PersonImpl *m_pPersonImpl;
 
-	static ProbabilityDistribution2D *m_pPopDist;
-	static double m_popDistWidth;
-	static double m_popDistHeight;
+	static SimpactContext::Slot<PersonSettings> s_settings;
 };
 
 class Man : public Person
 {
 public:
-	Man(double dateOfBirth);
+	Man(double dateOfBirth, SimpactContext &context);
 	~Man();
 };
 
 class Woman : public Person
 {
 public:
-	Woman(double dateOfBirth);
+	Woman(double dateOfBirth, SimpactContext &context);
 	~Woman();
 
 	void setPregnant(bool f)							{ m_pregnant = f; }
@@ -158,6 +191,18 @@ inline Woman *WOMAN(Person *pPerson)
 	return static_cast<Woman*>(pPerson);
 }
 
+inline void Person::setFather(Man *pFather)
+{
+	assert(pFather != 0);
+	m_family.setFather(pFather, pFather->getPersonID());
+}
+
+inline void Person::setMother(Woman *pMother)
+{
+	assert(pMother != 0);
+	m_family.setMother(pMother, pMother->getPersonID());
+}
+
 inline Person *Person::getChild(int idx)
 {
 	Person *pChild = m_family.getChild(idx); 
@@ -3,6 +3,7 @@
 #define PERSON_FAMILY_H
 
 #include <assert.h>
+#include <stdint.h>
 #include <vector>
 
 class Person;
@@ -15,27 +16,36 @@ Woman *WOMAN(Person *pPerson);
 class Person_Family
 {
 public:
-	Person_Family()														{ m_pFather = 0; m_pMother = 0; }
+	Person_Family()														{ m_pFather = 0; m_pMother = 0; m_fatherID = -1; m_motherID = -1; }
 	~Person_Family()													{ }
 
-	void setFather(Man *pFather)										{ assert(m_pFather == 0); assert(pFather != 0); m_pFather = pFather; }
-	void setMother(Woman *pMother)										{ assert(m_pMother == 0); assert(pMother != 0);  m_pMother = pMother; }
+	void setFather(Man *pFather, int64_t fatherID)						{ assert(m_pFather == 0); assert(pFather != 0); m_pFather = pFather; m_fatherID = fatherID; }
+	void setMother(Woman *pMother, int64_t motherID)					{ assert(m_pMother == 0); assert(pMother != 0);  m_pMother = pMother; m_motherID = motherID; }
 
+	// When a deceased parent is released (see population.deceased.release), the
+	// pointer is cleared, but the ID is still available
 	Man *getFather() const												{ return m_pFather; }
 	Woman *getMother() const											{ return m_pMother; }
+	int64_t getFatherID() const											{ return m_fatherID; }
+	int64_t getMotherID() const											{ return m_motherID; }
+	void clearFather()													{ m_pFather = 0; }
+	void clearMother()													{ m_pMother = 0; }
 
 	// TODO: currently, the death of a parent or the death of a child does
 	// not have any influence on this list. I don't think modifying the list
-	// on a mortality event is useful, will only complicate things
+	// on a mortality event is useful, will only complicate things. Only when
+	// a deceased child is released, it is removed from the list.
 	// TODO: what might be useful is a member function to retrieve the number
 	// of living children?
 	void addChild(Person *pPerson);
+	void removeChild(Person *pPerson);
 	bool hasChild(Person *pPerson) const;
 	int getNumberOfChildren() const										{ return m_children.size(); }
 	Person *getChild(int idx);
 private:
 	Man *m_pFather;
 	Woman *m_pMother;
+	int64_t m_fatherID, m_motherID;
 	std::vector<Person *> m_children;
 };
 
@@ -47,6 +57,23 @@ inline void Person_Family::addChild(Person *pPerson)
 	m_children.push_back(pPerson);
 }
 
+inline void Person_Family::removeChild(Person *pPerson)
+{
+	assert(pPerson != 0);
+
+	for (size_t i = 0 ; i < m_children.size() ; i++)
+	{
+		if (m_children[i] == pPerson)
+		{
+			m_children[i] = m_children.back();
+			m_children.pop_back();
+			return;
+		}
+	}
+
+	assert(false); // not a child of this person
+}
+
 // TODO: this is currently not fast for large number of children
 //       can always use a 'set' if this becomes a bottleneck
 inline bool Person_Family::hasChild(Person *pPerson) const
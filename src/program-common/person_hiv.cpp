@@ -4,6 +4,7 @@
 #include "configsettings.h"
 #include "configwriter.h"
 #include "configdistributionhelper.h"
+#include "person.h"
 #include "eventhivtransmission.h"
 #include "configfunctions.h"
 #include "jsonconfig.h"
@@ -13,12 +14,14 @@
 
 using namespace std;
 
-Person_HIV::Person_HIV(Person *pSelf) : m_pSelf(pSelf)
+Person_HIV::Person_HIV(Person *pSelf, const SimpactContext &context) : m_pSelf(pSelf)
 {
 	assert(pSelf);
 
+	const PersonHIVSettings &settings = context.get(s_settings);
+
 	m_infectionTime = -1e200; // not set
-	m_pInfectionOrigin = 0;
+	m_infectionOriginID = -1;
 	m_infectionType = None;
 	m_infectionStage = NoInfection;
 	m_diagnoseCount = 0;
@@ -33,15 +36,15 @@ Person_HIV::Person_HIV(Person *pSelf) : m_pSelf(pSelf)
 	m_cd4AtDeath = -1;
 	m_lastCD4AtTreatmentStart = -1;
 
-	assert(m_pARTAcceptDistribution);
-	m_artAcceptanceThreshold = m_pARTAcceptDistribution->pickNumber();
+	assert(settings.m_pARTAcceptDistribution);
+	m_artAcceptanceThreshold = settings.m_pARTAcceptDistribution->pickNumber();
 
 	m_aidsDeath = false;
 
-	assert(m_pLogSurvTimeOffsetDistribution);
-	m_log10SurvTimeOffset = m_pLogSurvTimeOffsetDistribution->pickNumber();
-	m_hazardB0Param = m_pB0Dist->pickNumber();
-	m_hazardB1Param = m_pB1Dist->pickNumber();
+	assert(settings.m_pLogSurvTimeOffsetDistribution);
+	m_log10SurvTimeOffset = settings.m_pLogSurvTimeOffsetDistribution->pickNumber();
+	m_hazardB0Param = settings.m_pB0Dist->pickNumber();
+	m_hazardB1Param = settings.m_pB1Dist->pickNumber();
 }
 
 Person_HIV::~Person_HIV()
@@ -55,7 +58,7 @@ void Person_HIV::setInfected(double t, Person *pOrigin, InfectionType iType)
 	assert(!(pOrigin == 0 && iType != Seed));
 
 	m_infectionTime = t; 
-	m_pInfectionOrigin = pOrigin;
+	m_infectionOriginID = (pOrigin != 0)?pOrigin->getPersonID():(-1);
 	m_infectionType = iType;
 
 	// Always start in the acute stage
@@ -84,6 +87,7 @@ void Person_HIV::setInfected(double t, Person *pOrigin, InfectionType iType)
 		abortWithMessage("ERROR: got invalid value for the viral load");
 
 	m_VspLowered = false;
+	updateAttributeArrays();
 
 	// Calculate AIDS based time of death for this person
 	m_aidsTodUtil.changeTimeOfDeath(t, m_pSelf);
@@ -108,6 +112,7 @@ void Person_HIV::lowerViralLoad(double fractionOnLogscale, double treatmentTime)
 	m_VspLowered = true; 
 	m_Vsp = std::pow(m_Vsp, fractionOnLogscale); 
 	assert(m_Vsp > 0);
+	updateAttributeArrays();
 	
 	assert(treatmentTime >= 0); 
 	m_lastTreatmentStartTime = treatmentTime;
@@ -129,6 +134,7 @@ void Person_HIV::resetViralLoad(double dropoutTime)
 	m_VspLowered = false;
 	m_Vsp = m_VspOriginal;
 	m_lastTreatmentStartTime = -1; // Not currently in treatment
+	updateAttributeArrays();
 
 	// This has changed the time of death
 	m_aidsTodUtil.changeTimeOfDeath(dropoutTime, m_pSelf);
@@ -136,6 +142,32 @@ void Person_HIV::resetViralLoad(double dropoutTime)
 	writeToViralLoadLog(dropoutTime, "Dropped out of ART");
 }
 
+const PersonHIVSettings &Person_HIV::getSettings() const
+{
+	assert(m_pSelf);
+	return m_pSelf->getContext().get(s_settings);
+}
+
+double Person_HIV::getStageViralLoad() const
+{
+	const PersonHIVSettings &settings = getSettings();
+
+	if (m_infectionStage == Acute) 
+		return getViralLoadFromSetPointViralLoad(settings.m_acuteFromSetPointParamX); 
+	else if (m_infectionStage == AIDS)
+		return getViralLoadFromSetPointViralLoad(settings.m_aidsFromSetPointParamX);
+	else if (m_infectionStage == AIDSFinal)
+		return getViralLoadFromSetPointViralLoad(settings.m_finalAidsFromSetPointParamX);
+	
+	abortWithMessage("Unknown stage in Person::getViralLoad");
+	return -1;
+}
+
+void Person_HIV::updateAttributeArrays() const
+{
+	m_pSelf->updateAttributeArrays();
+}
+
 double Person_HIV::getCD4Count(double t) const
 {
 	// This uses a simple linear interpolation between the count at the start and at the end.
@@ -162,12 +194,16 @@ double Person_HIV::getViralLoadFromSetPointViralLoad(double x) const
 	assert(m_Vsp > 0);
 	assert(x > 0);
 
-	double b = EventHIVTransmission::getParamB();
-	double c = EventHIVTransmission::getParamC();
+	assert(m_pSelf);
+	const SimpactContext &context = m_pSelf->getContext();
+	const EventHIVTransmissionSettings &transmissionSettings = EventHIVTransmission::getSettings(context);
+	double b = transmissionSettings.m_b;
+	double c = transmissionSettings.m_c;
 	double part = std::log(x)/b + std::pow(m_Vsp,-c);
 
-	assert(m_maxViralLoad > 0);
-	double maxValue = std::pow(m_maxViralLoad, -c);
+	double maxViralLoad = context.get(s_settings).m_maxViralLoad;
+	assert(maxViralLoad > 0);
+	double maxValue = std::pow(maxViralLoad, -c);
 	assert(maxValue > 0);
 
 	if (c > 0)
@@ -188,28 +224,34 @@ double Person_HIV::getViralLoadFromSetPointViralLoad(double x) const
 
 void Person_HIV::initializeCD4Counts()
 {
+	const PersonHIVSettings &settings = getSettings();
+
 	assert(m_cd4AtStart < 0 && m_cd4AtDeath < 0);
-	assert(m_pCD4StartDistribution && m_pCD4EndDistribution);
+	assert(settings.m_pCD4StartDistribution && settings.m_pCD4EndDistribution);
 
-	m_cd4AtStart = m_pCD4StartDistribution->pickNumber();
-	m_cd4AtDeath = m_pCD4EndDistribution->pickNumber();
+	m_cd4AtStart = settings.m_pCD4StartDistribution->pickNumber();
+	m_cd4AtDeath = settings.m_pCD4EndDistribution->pickNumber();
 	
 	assert(m_cd4AtStart >= 0);
 	assert(m_cd4AtDeath >= 0);
 }
 
-double Person_HIV::pickSeedSetPointViralLoad()
+double Person_HIV::pickSeedSetPointViralLoad() const
 {
-	assert(m_pVspModel != 0);
-	return m_pVspModel->pickSetPointViralLoad();
+	VspModel *pVspModel = getSettings().m_pVspModel;
+
+	assert(pVspModel != 0);
+	return pVspModel->pickSetPointViralLoad();
 }
 
-double Person_HIV::pickInheritedSetPointViralLoad(const Person *pOrigin)
+double Person_HIV::pickInheritedSetPointViralLoad(const Person *pOrigin) const
 {
-	assert(m_pVspModel != 0);
+	VspModel *pVspModel = getSettings().m_pVspModel;
+
+	assert(pVspModel != 0);
 	double Vsp0 = pOrigin->hiv().getSetPointViralLoad();
 
-	return m_pVspModel->inheritSetPointViralLoad(Vsp0);
+	return pVspModel->inheritSetPointViralLoad(Vsp0);
 }
 
 void Person_HIV::writeToViralLoadLog(double tNow, const string &description) const
@@ -221,33 +263,46 @@ void Person_HIV::writeToViralLoadLog(double tNow, const string &description) con
 
 	assert(m_Vsp > 0);
 
-	LogViralLoadHIV.print("%10.10f,%d,%s,%10.10f,%10.10f", tNow, id, description.c_str(),
+	LogSystem::get(m_pSelf->getContext()).logViralLoadHIV.print("%10.10f,%d,%s,%10.10f,%10.10f", tNow, id, description.c_str(),
 	                      log10(m_Vsp), log10(currentVl));
 }
 
-double Person_HIV::m_hivSeedWeibullShape = -1;
-double Person_HIV::m_hivSeedWeibullScale = -1;
-double Person_HIV::m_VspHeritabilitySigmaFraction = -1;
-
-double Person_HIV::m_acuteFromSetPointParamX = -1;
-double Person_HIV::m_aidsFromSetPointParamX = -1;
-double Person_HIV::m_finalAidsFromSetPointParamX = -1;
+PersonHIVSettings::PersonHIVSettings()
+{
+	m_acuteFromSetPointParamX = -1;
+	m_aidsFromSetPointParamX = -1;
+	m_finalAidsFromSetPointParamX = -1;
+	m_maxViralLoad = -1; // this one is read from the config file
+	m_paramGeneration = 0;
 
-double Person_HIV::m_maxViralLoad = -1; // this one is read from the config file
+	m_pVspModel = 0;
+	m_pCD4StartDistribution = 0;
+	m_pCD4EndDistribution = 0;
+	m_pARTAcceptDistribution = 0;
+	m_pLogSurvTimeOffsetDistribution = 0;
+	m_pB0Dist = 0;
+	m_pB1Dist = 0;
+}
 
-VspModel *Person_HIV::m_pVspModel = 0;
-ProbabilityDistribution *Person_HIV::m_pCD4StartDistribution = 0;
-ProbabilityDistribution *Person_HIV::m_pCD4EndDistribution = 0;
-ProbabilityDistribution *Person_HIV::m_pARTAcceptDistribution = 0;
+PersonHIVSettings::~PersonHIVSettings()
+{
+	delete m_pVspModel;
+	delete m_pCD4StartDistribution;
+	delete m_pCD4EndDistribution;
+	delete m_pARTAcceptDistribution;
+	delete m_pLogSurvTimeOffsetDistribution;
+	delete m_pB0Dist;
+	delete m_pB1Dist;
+}
 
-ProbabilityDistribution *Person_HIV::m_pLogSurvTimeOffsetDistribution = 0;
-ProbabilityDistribution *Person_HIV::m_pB0Dist = 0;
-ProbabilityDistribution *Person_HIV::m_pB1Dist = 0;
+SimpactContext::Slot<PersonHIVSettings> Person_HIV::s_settings;
 
 void Person_HIV::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
 	assert(pRndGen != 0);
 
+	PersonHIVSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
 	vector<string> supportedModels;
 	string VspModelName;
 
@@ -257,14 +312,14 @@ void Person_HIV::processConfig(ConfigSettings &config, GslRandomNumberGenerator
 	bool_t r;
 
 	if (!(r = config.getKeyValue("person.vsp.model.type", VspModelName, supportedModels)) ||
-	    !(r = config.getKeyValue("person.vsp.toacute.x", m_acuteFromSetPointParamX, 0)) ||
-	    !(r = config.getKeyValue("person.vsp.toaids.x", m_aidsFromSetPointParamX, 0)) ||
-	    !(r = config.getKeyValue("person.vsp.tofinalaids.x", m_finalAidsFromSetPointParamX, m_aidsFromSetPointParamX)) ||
-	    !(r = config.getKeyValue("person.vsp.maxvalue", m_maxViralLoad, 0)) )
+	    !(r = config.getKeyValue("person.vsp.toacute.x", settings.m_acuteFromSetPointParamX, 0)) ||
+	    !(r = config.getKeyValue("person.vsp.toaids.x", settings.m_aidsFromSetPointParamX, 0)) ||
+	    !(r = config.getKeyValue("person.vsp.tofinalaids.x", settings.m_finalAidsFromSetPointParamX, settings.m_aidsFromSetPointParamX)) ||
+	    !(r = config.getKeyValue("person.vsp.maxvalue", settings.m_maxViralLoad, 0)) )
 		abortWithMessage(r.getErrorString());
 
-	delete m_pVspModel;
-	m_pVspModel = 0;
+	delete settings.m_pVspModel;
+	settings.m_pVspModel = 0;
 
 	if (VspModelName == "logweibullwithnoise")
 	{
@@ -290,7 +345,7 @@ void Person_HIV::processConfig(ConfigSettings &config, GslRandomNumberGenerator
 		else
 			abortWithMessage("Unexpected value: " + onNegative);
 
-		m_pVspModel = new VspModelLogWeibullWithRandomNoise(scale, shape, fracSigma, t, pRndGen);
+		settings.m_pVspModel = new VspModelLogWeibullWithRandomNoise(scale, shape, fracSigma, t, pRndGen);
 	}
 	else if (VspModelName == "logdist2d")
 	{
@@ -307,49 +362,52 @@ void Person_HIV::processConfig(ConfigSettings &config, GslRandomNumberGenerator
 
 		pDist2D = getDistribution2DFromConfig(config, pRndGen, "person.vsp.model.logdist2d");
 
-		m_pVspModel = new VspModelLogDist(pDist2D, pAltSeedDist, pRndGen);
+		settings.m_pVspModel = new VspModelLogDist(pDist2D, pAltSeedDist, pRndGen);
 	}
 	else
 		abortWithMessage("ERROR: unexpected Vsp model name " + VspModelName);
 
-	delete m_pCD4StartDistribution;
-	m_pCD4StartDistribution = getDistributionFromConfig(config, pRndGen, "person.cd4.start");
+	delete settings.m_pCD4StartDistribution;
+	settings.m_pCD4StartDistribution = getDistributionFromConfig(config, pRndGen, "person.cd4.start");
 
-	delete m_pCD4EndDistribution;
-	m_pCD4EndDistribution = getDistributionFromConfig(config, pRndGen, "person.cd4.end");
+	delete settings.m_pCD4EndDistribution;
+	settings.m_pCD4EndDistribution = getDistributionFromConfig(config, pRndGen, "person.cd4.end");
 
-	delete m_pARTAcceptDistribution;
-	m_pARTAcceptDistribution = getDistributionFromConfig(config, pRndGen, "person.art.accept.threshold");
+	delete settings.m_pARTAcceptDistribution;
+	settings.m_pARTAcceptDistribution = getDistributionFromConfig(config, pRndGen, "person.art.accept.threshold");
 
-	delete m_pLogSurvTimeOffsetDistribution;
-	m_pLogSurvTimeOffsetDistribution = getDistributionFromConfig(config, pRndGen, "person.survtime.logoffset");
+	delete settings.m_pLogSurvTimeOffsetDistribution;
+	settings.m_pLogSurvTimeOffsetDistribution = getDistributionFromConfig(config, pRndGen, "person.survtime.logoffset");
 
-	delete m_pB0Dist;
-	delete m_pB1Dist;
-	m_pB0Dist = getDistributionFromConfig(config, pRndGen, "person.hiv.b0");
-	m_pB1Dist = getDistributionFromConfig(config, pRndGen, "person.hiv.b1");
+	delete settings.m_pB0Dist;
+	delete settings.m_pB1Dist;
+	settings.m_pB0Dist = getDistributionFromConfig(config, pRndGen, "person.hiv.b0");
+	settings.m_pB1Dist = getDistributionFromConfig(config, pRndGen, "person.hiv.b1");
+
+	settings.m_paramGeneration++;
 }
 
 void Person_HIV::obtainConfig(ConfigWriter &config)
 {
+	const PersonHIVSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("person.vsp.toacute.x", m_acuteFromSetPointParamX)) ||
-	    !(r = config.addKey("person.vsp.toaids.x", m_aidsFromSetPointParamX)) ||
-	    !(r = config.addKey("person.vsp.tofinalaids.x", m_finalAidsFromSetPointParamX)) ||
-	    !(r = config.addKey("person.vsp.maxvalue", m_maxViralLoad)) )
+	if (!(r = config.addKey("person.vsp.toacute.x", settings.m_acuteFromSetPointParamX)) ||
+	    !(r = config.addKey("person.vsp.toaids.x", settings.m_aidsFromSetPointParamX)) ||
+	    !(r = config.addKey("person.vsp.tofinalaids.x", settings.m_finalAidsFromSetPointParamX)) ||
+	    !(r = config.addKey("person.vsp.maxvalue", settings.m_maxViralLoad)) )
 		abortWithMessage(r.getErrorString());
 
-	addDistributionToConfig(m_pCD4StartDistribution, config, "person.cd4.start");
-	addDistributionToConfig(m_pCD4EndDistribution, config, "person.cd4.end");
-	addDistributionToConfig(m_pARTAcceptDistribution, config, "person.art.accept.threshold");
-	addDistributionToConfig(m_pLogSurvTimeOffsetDistribution, config, "person.survtime.logoffset");
-	addDistributionToConfig(m_pB0Dist, config, "person.hiv.b0");
-	addDistributionToConfig(m_pB1Dist, config, "person.hiv.b1");
+	addDistributionToConfig(settings.m_pCD4StartDistribution, config, "person.cd4.start");
+	addDistributionToConfig(settings.m_pCD4EndDistribution, config, "person.cd4.end");
+	addDistributionToConfig(settings.m_pARTAcceptDistribution, config, "person.art.accept.threshold");
+	addDistributionToConfig(settings.m_pLogSurvTimeOffsetDistribution, config, "person.survtime.logoffset");
+	addDistributionToConfig(settings.m_pB0Dist, config, "person.hiv.b0");
+	addDistributionToConfig(settings.m_pB1Dist, config, "person.hiv.b1");
 
 	{
 		VspModelLogWeibullWithRandomNoise *pDist = 0;
-		if ((pDist = dynamic_cast<VspModelLogWeibullWithRandomNoise *>(m_pVspModel)) != 0)
+		if ((pDist = dynamic_cast<VspModelLogWeibullWithRandomNoise *>(settings.m_pVspModel)) != 0)
 		{
 			string badInher;
 
@@ -369,7 +427,7 @@ void Person_HIV::obtainConfig(ConfigWriter &config)
 	}
 	{
 		VspModelLogDist *pDist = 0;
-		if ((pDist = dynamic_cast<VspModelLogDist *>(m_pVspModel)) != 0)
+		if ((pDist = dynamic_cast<VspModelLogDist *>(settings.m_pVspModel)) != 0)
 		{
 			ProbabilityDistribution *pAltSeedDist = pDist->getAltSeedDist();
 			ProbabilityDistribution2D *pDist2D = pDist->getUnderlyingDistribution();
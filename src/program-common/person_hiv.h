@@ -3,6 +3,7 @@
 #define PERSON_HIV_H
 
 #include "aidstodutil.h"
+#include "simpactcontext.h"
 #include "util.h"
 
 class Person;
@@ -12,20 +13,43 @@ class ConfigSettings;
 class ConfigWriter;
 class GslRandomNumberGenerator;
 
+class PersonHIVSettings
+{
+public:
+	PersonHIVSettings();
+	~PersonHIVSettings();
+
+	double m_acuteFromSetPointParamX;
+	double m_aidsFromSetPointParamX;
+	double m_finalAidsFromSetPointParamX;
+	double m_maxViralLoad;
+	int m_paramGeneration;
+
+	VspModel *m_pVspModel;
+
+	ProbabilityDistribution *m_pCD4StartDistribution;
+	ProbabilityDistribution *m_pCD4EndDistribution;
+	ProbabilityDistribution *m_pARTAcceptDistribution;
+	ProbabilityDistribution *m_pLogSurvTimeOffsetDistribution;
+	ProbabilityDistribution *m_pB0Dist;
+	ProbabilityDistribution *m_pB1Dist;
+};
+
 class Person_HIV
 {
 public:
 	enum InfectionType { None, Partner, Mother, Seed };
 	enum InfectionStage { NoInfection, Acute, Chronic, AIDS, AIDSFinal };
 
-	Person_HIV(Person *pSelf);
+	Person_HIV(Person *pSelf, const SimpactContext &context);
 	~Person_HIV();
 
 	InfectionType getInfectionType() const											{ return m_infectionType; }
 	void setInfected(double t, Person *pOrigin, InfectionType iType);
 	bool isInfected() const															{ if (m_infectionStage == NoInfection) return false; return true; }
 	double getInfectionTime() const													{ assert(isInfected()); return m_infectionTime; }
-	Person *getInfectionOrigin() const												{ assert(isInfected()); return m_pInfectionOrigin; }
+	// Only the ID is stored, the person who caused the infection may no longer exist (-1 for none)
+	int64_t getInfectionOriginID() const											{ assert(isInfected()); return m_infectionOriginID; }
 	InfectionStage getInfectionStage() const										{ return m_infectionStage; }
 	void setInChronicStage(double tNow);
 	void setInAIDSStage(double tNow);
@@ -63,16 +87,23 @@ public:
 
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
+
+	// Is increased each time the settings are read (e.g. by an intervention), so that
+	// cached values that depend on the viral load can be recalculated
+	static int getParamGeneration(const SimpactContext &context)									{ return context.get(s_settings).m_paramGeneration; }
 private:
+	const PersonHIVSettings &getSettings() const;
+	double getStageViralLoad() const;
 	double getViralLoadFromSetPointViralLoad(double x) const;
+	void updateAttributeArrays() const;
 	void initializeCD4Counts();
-	static double pickSeedSetPointViralLoad();
-	static double pickInheritedSetPointViralLoad(const Person *pOrigin);
+	double pickSeedSetPointViralLoad() const;
+	double pickInheritedSetPointViralLoad(const Person *pOrigin) const;
 
 	const Person *m_pSelf;
 
 	double m_infectionTime;
-	Person *m_pInfectionOrigin;
+	int64_t m_infectionOriginID;
 	InfectionType m_infectionType;
 	InfectionStage m_infectionStage;
 	int m_diagnoseCount;
@@ -92,44 +123,25 @@ private:
 	double m_lastCD4AtTreatmentStart;
 	double m_artAcceptanceThreshold;
 
-	static double m_hivSeedWeibullShape;
-	static double m_hivSeedWeibullScale;
-	static double m_VspHeritabilitySigmaFraction;
-	static double m_acuteFromSetPointParamX;
-	static double m_aidsFromSetPointParamX;
-	static double m_finalAidsFromSetPointParamX;
-	static double m_maxViralLoad;
-
-	static VspModel *m_pVspModel;
-
-	static ProbabilityDistribution *m_pCD4StartDistribution;
-	static ProbabilityDistribution *m_pCD4EndDistribution;
-	static ProbabilityDistribution *m_pARTAcceptDistribution;
-	static ProbabilityDistribution *m_pLogSurvTimeOffsetDistribution;
-	static ProbabilityDistribution *m_pB0Dist;
-	static ProbabilityDistribution *m_pB1Dist;
+	static SimpactContext::Slot<PersonHIVSettings> s_settings;
 };
 
+// The viral load of the other stages depends on the settings in the context
+// of the person, see getStageViralLoad
 inline double Person_HIV::getViralLoad() const
 { 
 	assert(m_infectionStage != NoInfection); 
-	if (m_infectionStage == Acute) 
-		return getViralLoadFromSetPointViralLoad(m_acuteFromSetPointParamX); 
-	else if (m_infectionStage == Chronic)
+	if (m_infectionStage == Chronic)
 		return getSetPointViralLoad(); 
-	else if (m_infectionStage == AIDS)
-		return getViralLoadFromSetPointViralLoad(m_aidsFromSetPointParamX);
-	else if (m_infectionStage == AIDSFinal)
-		return getViralLoadFromSetPointViralLoad(m_finalAidsFromSetPointParamX);
-	
-	abortWithMessage("Unknown stage in Person::getViralLoad");
-	return -1;
+
+	return getStageViralLoad();
 }
 
 inline void Person_HIV::setInChronicStage(double tNow)
 { 
 	assert(m_infectionStage == Acute); 
 	m_infectionStage = Chronic; 
+	updateAttributeArrays();
 	writeToViralLoadLog(tNow, "Chronic stage"); 
 }
 
@@ -137,6 +149,7 @@ inline void Person_HIV::setInAIDSStage(double tNow)
 { 
 	assert(m_infectionStage == Chronic); 
 	m_infectionStage = AIDS; 
+	updateAttributeArrays();
 	writeToViralLoadLog(tNow, "AIDS stage"); 
 }
 
@@ -144,6 +157,7 @@ inline void Person_HIV::setInFinalAIDSStage(double tNow)
 { 
 	assert(m_infectionStage == AIDS); 
 	m_infectionStage = AIDSFinal; 
+	updateAttributeArrays();
 	writeToViralLoadLog(tNow, "Final AIDS stage");
 }
 
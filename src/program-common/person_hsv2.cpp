@@ -10,16 +10,18 @@
 
 using namespace std;
 
-Person_HSV2::Person_HSV2(Person *pSelf) : m_pSelf(pSelf)
+Person_HSV2::Person_HSV2(Person *pSelf, const SimpactContext &context) : m_pSelf(pSelf)
 {
 	assert(pSelf);
 
+	const PersonHSV2Settings &settings = context.get(s_settings);
+
 	m_infectionTime = -1e200; // not set
-	m_pInfectionOrigin = 0;
+	m_infectionOriginID = -1;
 	m_infectionType = None;
 
-	m_hazardAParam = m_pADist->pickNumber();
-	m_hazardB2Param = m_pB2Dist->pickNumber();
+	m_hazardAParam = settings.m_pADist->pickNumber();
+	m_hazardB2Param = settings.m_pB2Dist->pickNumber();
 }
 
 Person_HSV2::~Person_HSV2()
@@ -32,29 +34,44 @@ void Person_HSV2::setInfected(double t, Person *pOrigin, InfectionType iType)
 	assert(!(pOrigin == 0 && iType != Seed));
 
 	m_infectionTime = t; 
-	m_pInfectionOrigin = pOrigin;
+	m_infectionOriginID = (pOrigin != 0)?pOrigin->getPersonID():(-1);
 	m_infectionType = iType;
 
 	//cout << "Person_HSV2 seeding " << m_pSelf->getName() << endl;
 }
 
-ProbabilityDistribution *Person_HSV2::m_pADist = 0;
-ProbabilityDistribution *Person_HSV2::m_pB2Dist = 0;
+PersonHSV2Settings::PersonHSV2Settings()
+{
+	m_pADist = 0;
+	m_pB2Dist = 0;
+}
+
+PersonHSV2Settings::~PersonHSV2Settings()
+{
+	delete m_pADist;
+	delete m_pB2Dist;
+}
+
+SimpactContext::Slot<PersonHSV2Settings> Person_HSV2::s_settings;
 
 void Person_HSV2::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
 	assert(pRndGen != 0);
 
-	delete m_pADist;
-	delete m_pB2Dist;
-	m_pADist = getDistributionFromConfig(config, pRndGen, "person.hsv2.a");
-	m_pB2Dist = getDistributionFromConfig(config, pRndGen, "person.hsv2.b2");
+	PersonHSV2Settings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	delete settings.m_pADist;
+	delete settings.m_pB2Dist;
+	settings.m_pADist = getDistributionFromConfig(config, pRndGen, "person.hsv2.a");
+	settings.m_pB2Dist = getDistributionFromConfig(config, pRndGen, "person.hsv2.b2");
 }
 
 void Person_HSV2::obtainConfig(ConfigWriter &config)
 {
-	addDistributionToConfig(m_pADist, config, "person.hsv2.a");
-	addDistributionToConfig(m_pB2Dist, config, "person.hsv2.b2");
+	const PersonHSV2Settings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	addDistributionToConfig(settings.m_pADist, config, "person.hsv2.a");
+	addDistributionToConfig(settings.m_pB2Dist, config, "person.hsv2.b2");
 }
 
 ConfigFunctions personHSVConfigFunctions(Person_HSV2::processConfig, Person_HSV2::obtainConfig, "Person_HSV2");
@@ -2,6 +2,7 @@
 
 #define PERSON_HSV2_H
 
+#include "simpactcontext.h"
 #include "util.h"
 #include <assert.h>
 
@@ -11,12 +12,22 @@ class ConfigSettings;
 class ConfigWriter;
 class GslRandomNumberGenerator;
 
+class PersonHSV2Settings
+{
+public:
+	PersonHSV2Settings();
+	~PersonHSV2Settings();
+
+	ProbabilityDistribution *m_pADist;
+	ProbabilityDistribution *m_pB2Dist;
+};
+
 class Person_HSV2
 {
 public:
 	enum InfectionType { None, Partner, Seed };
 
-	Person_HSV2(Person *pSelf);
+	Person_HSV2(Person *pSelf, const SimpactContext &context);
 	~Person_HSV2();
 
 	InfectionType getInfectionType() const											{ return m_infectionType; }
@@ -24,7 +35,8 @@ public:
 
 	bool isInfected() const															{ if (m_infectionType == None) return false; return true; }
 	double getInfectionTime() const													{ assert(isInfected()); return m_infectionTime; }
-	Person *getInfectionOrigin() const												{ assert(isInfected()); return m_pInfectionOrigin; }
+	// Only the ID is stored, the person who caused the infection may no longer exist (-1 for none)
+	int64_t getInfectionOriginID() const											{ assert(isInfected()); return m_infectionOriginID; }
 
 	double getHazardAParameter() const												{ return m_hazardAParam; }
 	double getHazardB2Parameter() const												{ return m_hazardB2Param; }
@@ -35,13 +47,12 @@ private:
 	const Person *m_pSelf;
 
 	double m_infectionTime;
-	Person *m_pInfectionOrigin;
+	int64_t m_infectionOriginID;
 	InfectionType m_infectionType;
 	double m_hazardAParam;
 	double m_hazardB2Param;
 
-	static ProbabilityDistribution *m_pADist;
-	static ProbabilityDistribution *m_pB2Dist;
+	static SimpactContext::Slot<PersonHSV2Settings> s_settings;
 };
 
 #endif // PERSON_HSV2_H
@@ -11,7 +11,7 @@
 
 using namespace std;
 
-Person_Relations::Person_Relations(const Person *pSelf) : m_pSelf(pSelf)
+Person_Relations::Person_Relations(const Person *pSelf, const SimpactContext &context) : m_pSelf(pSelf)
 {
 	assert(pSelf);
 
@@ -19,24 +19,27 @@ Person_Relations::Person_Relations(const Person *pSelf) : m_pSelf(pSelf)
 	m_sexuallyActive = false;
 	m_debutTime = -1;
 
-	m_relationshipsIterator = m_relationshipsSet.begin();
-#ifndef NDEBUG
-	m_relIterationBusy = false;
-#endif // NDEBUG
+	m_pRelationships = m_inlineRelationships;
+	m_numRelationships = 0;
+	m_relationshipsCapacity = PERSON_RELATIONS_INLINECOUNT;
+
+	const PersonRelationsSettings &settings = context.get(s_settings);
 
 	if (pSelf->isMan())
-		pickEagernessAndGap(m_eagAgeMan);
+		pickEagernessAndGap(settings.m_eagAgeMan);
 	else if (pSelf->isWoman())
-		pickEagernessAndGap(m_eagAgeWoman);
+		pickEagernessAndGap(settings.m_eagAgeWoman);
 	else
 		abortWithMessage("Person_Relations::Person_Relations: unknown gender!");
 }
 
 Person_Relations::~Person_Relations()
 {
+	if (m_pRelationships != m_inlineRelationships)
+		delete [] m_pRelationships;
 }
 
-void Person_Relations::pickEagernessAndGap(const EagernessAndAgegap &e)
+void Person_Relations::pickEagernessAndGap(const PersonRelationsSettings::EagernessAndAgegap &e)
 {
 		if (e.m_independentEagerness)
 		{
@@ -61,91 +64,104 @@ void Person_Relations::pickEagernessAndGap(const EagernessAndAgegap &e)
 		m_preferredAgeDiffHomo = e.m_pGapHomo->pickNumber();
 }
 
-void Person_Relations::startRelationshipIteration()
-{
-	assert(!m_relIterationBusy);
-
-	m_relationshipsIterator = m_relationshipsSet.begin();
-#ifndef NDEBUG
-	if (m_relationshipsIterator != m_relationshipsSet.end())
-		m_relIterationBusy = true;
-#endif
-}
-
-Person *Person_Relations::getNextRelationshipPartner(double &formationTime)
-{
-	if (m_relationshipsIterator == m_relationshipsSet.end())
-	{
-#ifndef NDEBUG
-		m_relIterationBusy = false;
-#endif
-		return 0;
-	}
-
-	assert(m_relIterationBusy);
-
-	const Relationship &r = *m_relationshipsIterator;
-	
-	++m_relationshipsIterator;
-
-	formationTime = r.getFormationTime();
-	return r.getPartner();
-}
-
-int Person_Relations::getNumberOfDiagnosedPartners()
+int Person_Relations::getNumberOfDiagnosedPartners() const
 {
 	// IMPORTANT: for a simple method, we cannot cache the result, it will
 	//            not only change on relationship events, but also on transmission
 
 	int D = 0; // number of diagnosed partners
-	int numRelations = getNumberOfRelationships();
-	double tDummy = 0;
 
-	// TODO: is this a bottleneck? Should it be faster?
-	startRelationshipIteration();
-	for (int i = 0 ; i < numRelations ; i++)
+	for (int i = 0 ; i < m_numRelationships ; i++)
 	{
-		Person *pPartner = getNextRelationshipPartner(tDummy);
+		Person *pPartner = m_pRelationships[i].getPartner();
 		if (pPartner->hiv().isDiagnosed())
 			D++;
 	}
-	assert(getNextRelationshipPartner(tDummy) == 0);
 
 	return D;
 }
 
 void Person_Relations::addRelationship(Person *pPerson, double t)
 {
-	assert(!m_relIterationBusy);
 	assert(pPerson != 0);
 	assert(pPerson != m_pSelf);
 	assert(!m_pSelf->hasDied() && !pPerson->hasDied());
 	// Check that the relationship doesn't exist yet (debug mode only)
-	assert(m_relationshipsSet.find(Relationship(pPerson)) == m_relationshipsSet.end());
+	assert(findRelationship(pPerson) < 0);
 
-	Relationship r(pPerson, t);
+	if (m_numRelationships == m_relationshipsCapacity)
+	{
+		int newCapacity = m_relationshipsCapacity*2;
+		Relationship *pNewRelationships = new Relationship[newCapacity];
+
+		for (int i = 0 ; i < m_numRelationships ; i++)
+			pNewRelationships[i] = m_pRelationships[i];
 
-	m_relationshipsSet.insert(r);
-	m_relationshipsIterator = m_relationshipsSet.begin();
+		if (m_pRelationships != m_inlineRelationships)
+			delete [] m_pRelationships;
+
+		m_pRelationships = pNewRelationships;
+		m_relationshipsCapacity = newCapacity;
+	}
+
+	// Keep the list sorted by person ID, move the relationships with a
+	// partner that has a larger ID one position further
+	const int64_t id = pPerson->getPersonID();
+	int pos = m_numRelationships;
+
+	while (pos > 0 && m_pRelationships[pos-1].getPartner()->getPersonID() > id)
+	{
+		m_pRelationships[pos] = m_pRelationships[pos-1];
+		pos--;
+	}
+
+	m_pRelationships[pos] = Relationship(pPerson, t);
+	m_numRelationships++;
 
 	assert(t >= m_lastRelationChangeTime);
 	m_lastRelationChangeTime = t;
 }
 
+// Binary search on the partner's person ID, for when there are too many
+// relationships for a linear search
+int Person_Relations::findRelationshipSorted(const Person *pPerson) const
+{
+	assert(pPerson);
+
+	const int64_t id = pPerson->getPersonID();
+	int lo = 0;
+	int hi = m_numRelationships;
+
+	while (lo < hi)
+	{
+		int mid = (lo+hi)/2;
+		int64_t midId = m_pRelationships[mid].getPartner()->getPersonID();
+
+		if (midId < id)
+			lo = mid+1;
+		else
+			hi = mid;
+	}
+
+	if (lo < m_numRelationships && m_pRelationships[lo].getPartner() == pPerson)
+		return lo;
+	return -1;
+}
+
 void Person_Relations::removeRelationship(Person *pPerson, double t, bool deathBased)
 {
-	assert(!m_relIterationBusy);
 	assert(pPerson != 0);
 
-	set<Relationship>::iterator it = m_relationshipsSet.find(pPerson);
+	int idx = findRelationship(pPerson);
 
-	if (it == m_relationshipsSet.end())
+	if (idx < 0)
 		abortWithMessage(strprintf("Consistency error: a person was not found exactly once in the relationship list (this = %s, person = %s)", m_pSelf->getName().c_str(), pPerson->getName().c_str()));
 
-	Relationship relation = *it; // save the info for logging at the end of the function
+	Relationship relation = m_pRelationships[idx]; // save the info for logging at the end of the function
 
-	m_relationshipsSet.erase(it);
-	m_relationshipsIterator = m_relationshipsSet.begin();
+	for (int i = idx+1 ; i < m_numRelationships ; i++)
+		m_pRelationships[i-1] = m_pRelationships[i];
+	m_numRelationships--;
 
 	assert(t >= m_lastRelationChangeTime);
 	m_lastRelationChangeTime = t;
@@ -193,10 +209,10 @@ void Person_Relations::removeRelationship(Person *pPerson, double t, bool deathB
 		   
 	if (writeToLog)
 	{
-		SimpactEvent::writeEventLogStart(false, "(relationshipended)", t, pPerson1, pPerson2);
+		SimpactEvent::writeEventLogStart(m_pSelf->getContext(), false, "(relationshipended)", t, pPerson1, pPerson2);
 
 		double formationTime = relation.getFormationTime();
-		LogEvent.print(",formationtime,%10.10f,relationage,%10.10f", formationTime, t-formationTime);
+		LogSystem::get(m_pSelf->getContext()).logEvents.print(",formationtime,%10.10f,relationage,%10.10f", formationTime, t-formationTime);
 
 		writeToRelationLog(pPerson1, pPerson2, formationTime, t);
 	}
@@ -218,7 +234,7 @@ void Person_Relations::addPersonOfInterest(Person *pPerson)
 
 	// Because of the relocation, we also need to check that a relationship
 	// does not already exist with a new person of interest
-	if (m_relationshipsSet.find(Person_Relations::Relationship(pPerson)) != m_relationshipsSet.end())
+	if (findRelationship(pPerson) >= 0)
 		return;
 
 	m_personsOfInterest.push_back(pPerson);
@@ -252,7 +268,7 @@ void Person_Relations::writeToRelationLog(const Person *pMan, const Person *pWom
 
 	// Write to relationship log
 	// male id, female id, formation time, dissolution time, age gap (age man-age woman)
-	LogRelation.print("%d,%d,%10.10f,%10.10f,%10.10f,%d", 
+	LogSystem::get(pMan->getContext()).logRelations.print("%d,%d,%10.10f,%10.10f,%10.10f,%d", 
 			  (int)pMan->getPersonID(), (int)pWomanOrMan2->getPersonID(),
 			  formationTime, dissolutionTime, 
 			  pWomanOrMan2->getDateOfBirth()-pMan->getDateOfBirth(), (pMan->isMan() && pWomanOrMan2->isMan())?1:0);
@@ -262,18 +278,22 @@ void Person_Relations::processConfig(ConfigSettings &config, GslRandomNumberGene
 {
 	assert(pRndGen != 0);
 
-	m_eagAgeMan.processConfig(config, pRndGen, "person.eagerness.man", "person.agegap.man", "msm");
-	m_eagAgeWoman.processConfig(config, pRndGen, "person.eagerness.woman", "person.agegap.woman", "wsw");	
+	PersonRelationsSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	settings.m_eagAgeMan.processConfig(config, pRndGen, "person.eagerness.man", "person.agegap.man", "msm");
+	settings.m_eagAgeWoman.processConfig(config, pRndGen, "person.eagerness.woman", "person.agegap.woman", "wsw");	
 }
 
 
 void Person_Relations::obtainConfig(ConfigWriter &config)
 {
-	m_eagAgeMan.obtainConfig(config, "person.eagerness.man", "person.agegap.man", "msm");
-	m_eagAgeWoman.obtainConfig(config, "person.eagerness.woman", "person.agegap.woman", "wsw");
+	const PersonRelationsSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	settings.m_eagAgeMan.obtainConfig(config, "person.eagerness.man", "person.agegap.man", "msm");
+	settings.m_eagAgeWoman.obtainConfig(config, "person.eagerness.woman", "person.agegap.woman", "wsw");
 }
 
-Person_Relations::EagernessAndAgegap::EagernessAndAgegap()
+PersonRelationsSettings::EagernessAndAgegap::EagernessAndAgegap()
 {
 		m_independentEagerness = true;
 		m_pEagHetero = 0;
@@ -284,7 +304,7 @@ Person_Relations::EagernessAndAgegap::EagernessAndAgegap()
 		m_pGapHomo = 0;
 }
 
-Person_Relations::EagernessAndAgegap::~EagernessAndAgegap()
+PersonRelationsSettings::EagernessAndAgegap::~EagernessAndAgegap()
 {
 	delete m_pEagHetero;
 	delete m_pEagHomo;
@@ -293,7 +313,7 @@ Person_Relations::EagernessAndAgegap::~EagernessAndAgegap()
 	delete m_pGapHomo;
 }
 
-void Person_Relations::EagernessAndAgegap::processConfig(ConfigSettings &config, 
+void PersonRelationsSettings::EagernessAndAgegap::processConfig(ConfigSettings &config, 
                             GslRandomNumberGenerator *pRndGen, const string &prefixEag,
 							const string &prefixGap, const string &homSuff)
 {
@@ -332,8 +352,8 @@ void Person_Relations::EagernessAndAgegap::processConfig(ConfigSettings &config,
 	m_pGapHomo = getDistributionFromConfig(config, pRndGen, prefixGap + "." + homSuff);
 }
 
-void Person_Relations::EagernessAndAgegap::obtainConfig(ConfigWriter &config, const string &prefixEag, 
-                                                                 const string &prefixGap, const string &homSuff)
+void PersonRelationsSettings::EagernessAndAgegap::obtainConfig(ConfigWriter &config, const string &prefixEag, 
+                                                                 const string &prefixGap, const string &homSuff) const
 {
 	string eagType;
 	if (m_independentEagerness)
@@ -353,8 +373,7 @@ void Person_Relations::EagernessAndAgegap::obtainConfig(ConfigWriter &config, co
 	addDistributionToConfig(m_pGapHomo, config, prefixGap + "." + homSuff);
 }
 
-Person_Relations::EagernessAndAgegap Person_Relations::m_eagAgeMan;
-Person_Relations::EagernessAndAgegap Person_Relations::m_eagAgeWoman;
+SimpactContext::Slot<PersonRelationsSettings> Person_Relations::s_settings;
 
 ConfigFunctions personRelationsConfigFunctions(Person_Relations::processConfig, Person_Relations::obtainConfig, "Person_Relations");
 
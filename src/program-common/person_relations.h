@@ -3,9 +3,15 @@
 #define PERSON_RELATIONS_H
 
 #include "personbase.h"
+#include "simpactcontext.h"
 #include <assert.h>
 #include <vector>
-#include <set>
+
+// Number of relationships that can be stored without allocating memory
+#define PERSON_RELATIONS_INLINECOUNT 3
+// Up to this number of relationships, a search compares the partner pointers
+// one by one instead of doing a binary search on the partner's person ID
+#define PERSON_RELATIONS_LINEARSEARCHCOUNT 8
 
 class Person;
 class ConfigSettings;
@@ -14,17 +20,46 @@ class GslRandomNumberGenerator;
 class ProbabilityDistribution;
 class ProbabilityDistribution2D;
 
+class PersonRelationsSettings
+{
+public:
+	struct EagernessAndAgegap
+	{
+		EagernessAndAgegap();
+		~EagernessAndAgegap();
+
+		bool m_independentEagerness;
+		ProbabilityDistribution *m_pEagHetero;
+		ProbabilityDistribution *m_pEagHomo;
+		ProbabilityDistribution2D *m_pEagJoint;
+
+		ProbabilityDistribution *m_pGapHetero;
+		ProbabilityDistribution *m_pGapHomo;
+
+		void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen,
+		                            const std::string &prefixEag, const std::string &prefixGap,
+									const std::string &homSuff);
+		void obtainConfig(ConfigWriter &config, const std::string &prefixEag, 
+		                           const std::string &prefixGap, const std::string &homSuff) const;
+	};
+
+	EagernessAndAgegap m_eagAgeMan;
+	EagernessAndAgegap m_eagAgeWoman;
+};
+
 class Person_Relations
 {
 public:
-	Person_Relations(const Person *pSelf);
+	Person_Relations(const Person *pSelf, const SimpactContext &context);
 	~Person_Relations();
 
-	// This also resets the iterator for getNextRelationshipPartner
-	int getNumberOfRelationships() const														{ return m_relationshipsSet.size(); }
-	void startRelationshipIteration();
-	Person *getNextRelationshipPartner(double &formationTime);
-	int getNumberOfDiagnosedPartners();
+	// The relationships are sorted by the person ID of the partner, the index can range
+	// from 0 to getNumberOfRelationships()-1. Don't add or remove relationships of this
+	// person while looping over them.
+	int getNumberOfRelationships() const														{ return m_numRelationships; }
+	Person *getRelationshipPartner(int idx) const												{ assert(idx >= 0 && idx < m_numRelationships); return m_pRelationships[idx].getPartner(); }
+	Person *getRelationshipPartner(int idx, double &formationTime) const						{ assert(idx >= 0 && idx < m_numRelationships); formationTime = m_pRelationships[idx].getFormationTime(); return m_pRelationships[idx].getPartner(); }
+	int getNumberOfDiagnosedPartners() const;
 
 	bool hasRelationshipWith(Person *pPerson) const;
 
@@ -59,34 +94,31 @@ private:
 	class Relationship
 	{
 	public:
-		// A negative time is used when not relevant, e.g. when
-		// searching for a relationship with a person
+		Relationship()											{ m_pPerson = 0; m_formationTime = -1; }
 		Relationship(Person *pPerson, double formationTime)				{ assert(pPerson != 0); assert(formationTime > 0); m_pPerson = pPerson; m_formationTime = formationTime; }
-		Relationship(Person *pPerson)							{ assert(pPerson != 0); m_pPerson = pPerson; m_formationTime = -1; }
 
 		Person *getPartner() const							{ return m_pPerson; }
 		double getFormationTime() const							{ return m_formationTime; }
-
-		bool operator<(const Relationship &rel) const
-		{
-			PersonBase *p1 = reinterpret_cast<PersonBase *>(m_pPerson);
-			PersonBase *p2 = reinterpret_cast<PersonBase *>(rel.m_pPerson);
-			if (p1->getPersonID() < p2->getPersonID()) 
-				return true; 
-			return false; 
-		}
 	private:
 		Person *m_pPerson;
 		double m_formationTime;
 	};
 
-#ifndef NDEBUG
-	bool m_relIterationBusy;
-#endif
+	// Not allowed, the array pointer can refer to the inline storage
+	Person_Relations(const Person_Relations &src);
+	Person_Relations &operator=(const Person_Relations &src);
+
+	int findRelationship(const Person *pPerson) const;
+	int findRelationshipSorted(const Person *pPerson) const;
+
 	const Person *m_pSelf;
 
-	std::set<Relationship> m_relationshipsSet;
-	std::set<Relationship>::const_iterator m_relationshipsIterator;
+	// Sorted by person ID of the partner. Points to m_inlineRelationships as long
+	// as there's enough room there.
+	Relationship *m_pRelationships;
+	int m_numRelationships;
+	int m_relationshipsCapacity;
+	Relationship m_inlineRelationships[PERSON_RELATIONS_INLINECOUNT];
 	double m_lastRelationChangeTime;
 	bool m_sexuallyActive;
 	double m_debutTime;
@@ -99,35 +131,32 @@ private:
 
 	std::vector<Person *> m_personsOfInterest;
 
-	struct EagernessAndAgegap
-	{
-		EagernessAndAgegap();
-		~EagernessAndAgegap();
+	void pickEagernessAndGap(const PersonRelationsSettings::EagernessAndAgegap &e);
 
-		bool m_independentEagerness;
-		ProbabilityDistribution *m_pEagHetero;
-		ProbabilityDistribution *m_pEagHomo;
-		ProbabilityDistribution2D *m_pEagJoint;
-
-		ProbabilityDistribution *m_pGapHetero;
-		ProbabilityDistribution *m_pGapHomo;
+	static SimpactContext::Slot<PersonRelationsSettings> s_settings;
+};
 
-		void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen,
-		                            const std::string &prefixEag, const std::string &prefixGap,
-									const std::string &homSuff);
-		void obtainConfig(ConfigWriter &config, const std::string &prefixEag, 
-		                           const std::string &prefixGap, const std::string &homSuff);
-	};
+// Returns the index of the relationship with this person, or -1 if not found
+inline int Person_Relations::findRelationship(const Person *pPerson) const
+{
+	assert(pPerson);
 
-	void pickEagernessAndGap(const EagernessAndAgegap &e);
+	if (m_numRelationships <= PERSON_RELATIONS_LINEARSEARCHCOUNT)
+	{
+		for (int i = 0 ; i < m_numRelationships ; i++)
+		{
+			if (m_pRelationships[i].getPartner() == pPerson)
+				return i;
+		}
+		return -1;
+	}
 
-	static EagernessAndAgegap m_eagAgeMan;
-	static EagernessAndAgegap m_eagAgeWoman;
-};
+	return findRelationshipSorted(pPerson);
+}
 
 inline bool Person_Relations::hasRelationshipWith(Person *pPerson) const
 {
-	return m_relationshipsSet.find(Relationship(pPerson)) != m_relationshipsSet.end();
+	return findRelationship(pPerson) >= 0;
 }
 
 #endif // PERSON_RELATIONS_H
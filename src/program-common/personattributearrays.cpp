@@ -0,0 +1,52 @@
+#include "personattributearrays.h"
+#include "person.h"
+
+PersonAttributeArrays::PersonAttributeArrays()
+{
+}
+
+PersonAttributeArrays::~PersonAttributeArrays()
+{
+}
+
+void PersonAttributeArrays::resize(int numPeople)
+{
+	assert(numPeople >= 0);
+
+	m_dateOfBirth.resize(numPeople);
+	m_gender.resize(numPeople);
+	m_numRelationships.resize(numPeople);
+	m_sexuallyActive.resize(numPeople);
+	m_eagerness.resize(numPeople);
+	m_location.resize(numPeople);
+	m_infectionStage.resize(numPeople);
+	m_setPointViralLoad.resize(numPeople);
+	m_loweredViralLoad.resize(numPeople);
+}
+
+void PersonAttributeArrays::update(int idx, const Person *pPerson)
+{
+	checkIndex(idx);
+	assert(pPerson);
+
+	m_dateOfBirth[idx] = pPerson->getDateOfBirth();
+	m_gender[idx] = (unsigned char)pPerson->getGender();
+	m_numRelationships[idx] = pPerson->getNumberOfRelationships();
+	m_sexuallyActive[idx] = (pPerson->isSexuallyActive())?1:0;
+	m_eagerness[idx] = pPerson->getFormationEagernessParameter();
+	m_location[idx] = pPerson->getLocation();
+
+	const Person_HIV &hiv = pPerson->hiv();
+
+	m_infectionStage[idx] = (unsigned char)hiv.getInfectionStage();
+	if (hiv.isInfected())
+	{
+		m_setPointViralLoad[idx] = hiv.getSetPointViralLoad();
+		m_loweredViralLoad[idx] = (hiv.hasLoweredViralLoad())?1:0;
+	}
+	else
+	{
+		m_setPointViralLoad[idx] = 0;
+		m_loweredViralLoad[idx] = 0;
+	}
+}
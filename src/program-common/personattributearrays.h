@@ -0,0 +1,59 @@
+#ifndef PERSONATTRIBUTEARRAYS_H
+
+#define PERSONATTRIBUTEARRAYS_H
+
+#include "personbase.h"
+#include "person_hiv.h"
+#include "point2d.h"
+#include <assert.h>
+#include <vector>
+
+class Person;
+
+// Copies of frequently used person attributes, stored in separate arrays that have
+// the same layout as the array of living persons (SimpactPopulation::getAllPeople).
+// A loop over the population that only needs one or two of these values then doesn't
+// need to access each Person object. The SimpactPopulation keeps the layout in sync
+// with the one of the living persons, and a Person updates its entries itself when
+// one of the values changes.
+//
+// The set-point viral load is stored instead of the current viral load, since the
+// latter also depends on the infection stage and on configuration settings.
+class PersonAttributeArrays
+{
+public:
+	PersonAttributeArrays();
+	~PersonAttributeArrays();
+
+	void resize(int numPeople);
+	void update(int idx, const Person *pPerson);
+
+	int getNumberOfPeople() const									{ return (int)m_dateOfBirth.size(); }
+
+	double getDateOfBirth(int idx) const							{ checkIndex(idx); return m_dateOfBirth[idx]; }
+	bool isMan(int idx) const										{ checkIndex(idx); return m_gender[idx] == PersonBase::Male; }
+	bool isWoman(int idx) const										{ checkIndex(idx); return m_gender[idx] == PersonBase::Female; }
+	int getNumberOfRelationships(int idx) const						{ checkIndex(idx); return m_numRelationships[idx]; }
+	bool isSexuallyActive(int idx) const							{ checkIndex(idx); return m_sexuallyActive[idx] != 0; }
+	double getFormationEagernessParameter(int idx) const			{ checkIndex(idx); return m_eagerness[idx]; }
+	Point2D getLocation(int idx) const								{ checkIndex(idx); return m_location[idx]; }
+
+	Person_HIV::InfectionStage getInfectionStage(int idx) const		{ checkIndex(idx); return (Person_HIV::InfectionStage)m_infectionStage[idx]; }
+	bool isInfected(int idx) const									{ return getInfectionStage(idx) != Person_HIV::NoInfection; }
+	double getSetPointViralLoad(int idx) const						{ assert(isInfected(idx)); return m_setPointViralLoad[idx]; }
+	bool hasLoweredViralLoad(int idx) const							{ assert(isInfected(idx)); return m_loweredViralLoad[idx] != 0; }
+private:
+	void checkIndex(int idx) const									{ assert(idx >= 0 && idx < getNumberOfPeople()); }
+
+	std::vector<double> m_dateOfBirth;
+	std::vector<unsigned char> m_gender;
+	std::vector<int> m_numRelationships;
+	std::vector<unsigned char> m_sexuallyActive;
+	std::vector<double> m_eagerness;
+	std::vector<Point2D> m_location;
+	std::vector<unsigned char> m_infectionStage;
+	std::vector<double> m_setPointViralLoad;
+	std::vector<unsigned char> m_loweredViralLoad;
+};
+
+#endif // PERSONATTRIBUTEARRAYS_H
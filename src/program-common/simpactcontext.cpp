@@ -0,0 +1,46 @@
+#include "simpactcontext.h"
+
+using namespace std;
+
+SimpactContext::SimpactContext()
+{
+	const vector<SlotFunctions> &functions = getSlotFunctions();
+
+	m_settings.resize(functions.size());
+	for (size_t i = 0 ; i < functions.size() ; i++)
+		m_settings[i] = functions[i].createFunction();
+}
+
+SimpactContext::~SimpactContext()
+{
+	const vector<SlotFunctions> &functions = getSlotFunctions();
+
+	assert(functions.size() == m_settings.size());
+	for (size_t i = m_settings.size() ; i > 0 ; i--)
+		functions[i-1].destroyFunction(m_settings[i-1]);
+}
+
+SimpactContext &SimpactContext::getConfigContext()
+{
+	static SimpactContext defaultContext; // if none was set, e.g. to show the default config
+
+	return (s_pConfigContext)?*s_pConfigContext:defaultContext;
+}
+
+int SimpactContext::registerSlot(CreateFunction createFunction, DestroyFunction destroyFunction)
+{
+	vector<SlotFunctions> &functions = getSlotFunctions();
+
+	functions.push_back(SlotFunctions(createFunction, destroyFunction));
+	return (int)functions.size()-1;
+}
+
+// Using a function-local static, since the slots register themselves during the
+// static initialization, in no particular order
+vector<SimpactContext::SlotFunctions> &SimpactContext::getSlotFunctions()
+{
+	static vector<SlotFunctions> functions;
+	return functions;
+}
+
+thread_local SimpactContext *SimpactContext::s_pConfigContext = 0;
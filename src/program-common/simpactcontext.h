@@ -0,0 +1,84 @@
+#ifndef SIMPACTCONTEXT_H
+
+#define SIMPACTCONTEXT_H
+
+#include <assert.h>
+#include <vector>
+
+// Settings that belong to one simulation instead of to the whole program.
+//
+// The event and person classes don't store their model parameters, hazards and
+// distributions in static members, but in a settings class of their own (like
+// SeedEventSettings). Each SimpactContext has an instance of every such class,
+// so that several simulations can exist in the same process. A class registers
+// its settings by defining a static SimpactContext::Slot, which is only used
+// to look up the instance in a context:
+//
+//     SimpactContext::Slot<EventMortalitySettings> EventMortality::s_settings;
+//     ...
+//     const EventMortalitySettings &s = population.getContext().get(s_settings);
+//
+// The static processConfig and obtainConfig functions don't receive the context
+// as an argument, they work on the one that was set using setConfigContext, for
+// the calling thread. While the simulation is running, the context must be
+// obtained from the SimpactPopulation or from a Person instead, since hazards
+// can be calculated in other threads.
+class SimpactContext
+{
+public:
+	template<class T> class Slot;
+
+	SimpactContext();
+	~SimpactContext();
+
+	template<class T> T &get(const Slot<T> &slot)							{ return *static_cast<T *>(getSettings(slot.getIndex())); }
+	template<class T> const T &get(const Slot<T> &slot) const				{ return *static_cast<const T *>(getSettings(slot.getIndex())); }
+
+	static SimpactContext &getConfigContext();
+	static void setConfigContext(SimpactContext *pContext)					{ s_pConfigContext = pContext; }
+private:
+	SimpactContext(const SimpactContext &src);
+	SimpactContext &operator=(const SimpactContext &src);
+
+	typedef void *(*CreateFunction)();
+	typedef void (*DestroyFunction)(void *pSettings);
+
+	class SlotFunctions
+	{
+	public:
+		SlotFunctions(CreateFunction c, DestroyFunction d) : createFunction(c), destroyFunction(d) { }
+
+		CreateFunction createFunction;
+		DestroyFunction destroyFunction;
+	};
+
+	void *getSettings(int idx) const										{ assert(idx >= 0 && idx < (int)m_settings.size()); return m_settings[idx]; }
+
+	static int registerSlot(CreateFunction createFunction, DestroyFunction destroyFunction);
+	static std::vector<SlotFunctions> &getSlotFunctions();
+
+	std::vector<void *> m_settings;
+
+	static thread_local SimpactContext *s_pConfigContext;
+};
+
+// The slots are only meant to be defined as static members, so that they are all
+// registered before the first SimpactContext is created
+template<class T>
+class SimpactContext::Slot
+{
+public:
+	Slot() : m_index(SimpactContext::registerSlot(create, destroy))		{ }
+
+	int getIndex() const													{ return m_index; }
+private:
+	Slot(const Slot &src);
+	Slot &operator=(const Slot &src);
+
+	static void *create()													{ return new T(); }
+	static void destroy(void *pSettings)									{ delete static_cast<T *>(pSettings); }
+
+	const int m_index;
+};
+
+#endif // SIMPACTCONTEXT_H
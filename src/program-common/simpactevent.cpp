@@ -13,7 +13,7 @@ void getPersonProperties(double t, const Person *pPerson, std::string &name, int
 	name = pPerson->getName();
 }
 
-void SimpactEvent::writeEventLogStart(bool noExtraInfo, const std::string &eventName, double t, 
+void SimpactEvent::writeEventLogStart(SimpactContext &context, bool noExtraInfo, const std::string &eventName, double t, 
 		                      const Person *pPerson1, const Person *pPerson2)
 {
 	// time,eventname,name p1, id1, gender1, age1, name p2, id2, gender2, age2
@@ -36,9 +36,11 @@ void SimpactEvent::writeEventLogStart(bool noExtraInfo, const std::string &event
 		getPersonProperties(t, pPerson2, name2, id2, gender2, age2);
 	}
 
+	LogFile &logEvents = LogSystem::get(context).logEvents;
+
 	if (noExtraInfo)
-		LogEvent.print(format.c_str(), t, eventName.c_str(), name1.c_str(), id1, gender1, age1, name2.c_str(), id2, gender2, age2);
+		logEvents.print(format.c_str(), t, eventName.c_str(), name1.c_str(), id1, gender1, age1, name2.c_str(), id2, gender2, age2);
 	else
-		LogEvent.printNoNewLine(format.c_str(), t, eventName.c_str(), name1.c_str(), id1, gender1, age1, name2.c_str(), id2, gender2, age2);
+		logEvents.printNoNewLine(format.c_str(), t, eventName.c_str(), name1.c_str(), id1, gender1, age1, name2.c_str(), id2, gender2, age2);
 }
 
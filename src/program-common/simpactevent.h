@@ -20,10 +20,20 @@ public:
 
 	Person *getPerson(int idx) const							{ return static_cast<Person*>(PopulationEvent::getPerson(idx)); }
 
+	// Population wide values that are only updated periodically, by the
+	// EventSyncPopulationStatistics and EventSyncReferenceYear events
+	enum SyncValue { SyncPopulationSize = 1, SyncReferenceYear = 2 };
+
+	// Returns a combination of the SyncValue flags for the values that the hazard of
+	// this event depends on. When such a value is updated, only the fire times of the
+	// events that depend on it are recalculated.
+	virtual int getSyncDependencies() const							{ return 0; }
+	static bool dependsOnSyncValue(const PopulationEvent *pEvt, SyncValue value)		{ return (static_cast<const SimpactEvent *>(pEvt)->getSyncDependencies() & value) != 0; }
+
 	// This is called right before an event is fired (will fire at 'fireTime')
 	virtual void writeLogs(const SimpactPopulation &pop, double fireTime) const = 0;
 
-	static void writeEventLogStart(bool noExtraInfo, const std::string &eventName, double t, 
+	static void writeEventLogStart(SimpactContext &context, bool noExtraInfo, const std::string &eventName, double t, 
 			               const Person *pPerson1, const Person *pPerson2);
 };
 
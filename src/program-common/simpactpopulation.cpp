@@ -24,6 +24,8 @@
 #include "fixedvaluedistribution2d.h"
 #include "util.h"
 #include "jsonconfig.h"
+#include "parallel.h"
+#include <algorithm>
 
 using namespace std;
 
@@ -33,6 +35,7 @@ SimpactPopulationConfig::SimpactPopulationConfig()
 	m_initialWomen = 100;
 	m_eyeCapsFraction = 1;
 	m_msm = false;
+	m_releaseDeceased = false;
 }
 
 SimpactPopulationConfig::~SimpactPopulationConfig()
@@ -40,7 +43,7 @@ SimpactPopulationConfig::~SimpactPopulationConfig()
 }
 
 SimpactPopulation::SimpactPopulation(PopulationAlgorithmInterface &alg, PopulationStateInterface &state) 
-	: m_state(state), m_alg(alg)
+	: m_state(state), m_alg(alg), m_context(SimpactContext::getConfigContext())
 {
 	state.setExtraStateInfo(this);
 	alg.setAboutToFireAction(this);
@@ -51,6 +54,7 @@ SimpactPopulation::SimpactPopulation(PopulationAlgorithmInterface &alg, Populati
 	m_referenceYear = 0;
 	m_eyeCapsFraction = 1;
 	m_msm = false;
+	m_releaseDeceased = false;
 	m_pCoarseMap = 0;
 	
 
@@ -72,6 +76,8 @@ bool_t SimpactPopulation::init(const SimpactPopulationConfig &config, const Popu
 
 	m_eyeCapsFraction = eyeCapsFraction;
 	m_msm = config.getMSM();
+	m_releaseDeceased = config.getReleaseDeceased();
+	m_state.setReleaseDeceasedPeople(m_releaseDeceased);
 
 	bool_t r;
 	if (!(r = createInitialPopulation(config, popDist)))
@@ -88,14 +94,20 @@ bool_t SimpactPopulation::createInitialPopulation(const SimpactPopulationConfig
 {
 	assert(m_pCoarseMap == 0);
 
-	FixedValueDistribution2D *pDist2D = dynamic_cast<FixedValueDistribution2D *>(Person::getPopulationDistribution());
+	FixedValueDistribution2D *pDist2D = dynamic_cast<FixedValueDistribution2D *>(Person::getPopulationDistribution(m_context));
 	if (pDist2D == 0) // For the fixed value distribution, we'll use the old behaviour, but otherwise the course map is used
 	{
-		int subDivX = CoarseMap::getXSubdivision();
-		int subDivY = CoarseMap::getYSubdivision();
+		int subDivX = CoarseMap::getXSubdivision(m_context);
+		int subDivY = CoarseMap::getYSubdivision(m_context);
 		assert(subDivX > 1 && subDivY > 1);
 
 		m_pCoarseMap = new CoarseMap(subDivX, subDivY);
+
+		// If we know where people can be placed, we can avoid rearranging the map while
+		// the initial population is being added
+		double xMin, xMax, yMin, yMax;
+		if (Person::getPopulationDistribution(m_context)->getBoundingBox(xMin, xMax, yMin, yMax))
+			m_pCoarseMap->setExtent(xMin, xMax, yMin, yMax);
 	}
 
 	int numMen = config.getInitialMen();
@@ -110,9 +122,9 @@ bool_t SimpactPopulation::createInitialPopulation(const SimpactPopulationConfig
 	{
 		double age = popDist.pickAge(true);
 
-		Person *pPerson = new Man(-age);
+		Person *pPerson = new Man(-age, m_context);
 
-		if (age > EventDebut::getDebutAge())
+		if (age > EventDebut::getDebutAge(m_context))
 			pPerson->setSexuallyActive(0);
 
 		addNewPerson(pPerson);
@@ -122,8 +134,8 @@ bool_t SimpactPopulation::createInitialPopulation(const SimpactPopulationConfig
 	{
 		double age = popDist.pickAge(false);
 
-		Person *pPerson = new Woman(-age);
-		if (age > EventDebut::getDebutAge())
+		Person *pPerson = new Woman(-age, m_context);
+		if (age > EventDebut::getDebutAge(m_context))
 			pPerson->setSexuallyActive(0);
 
 		addNewPerson(pPerson);
@@ -157,13 +169,18 @@ bool_t SimpactPopulation::scheduleInitialEvents()
 	
 	// Relationship formation. For heterosexual relations, we'll only process 
 	// the women, the events for the men are scheduled automatically
-	for (int i = 0 ; i < numWomen ; i++)
+	if (m_eyeCapsFraction >= 1.0)
+		scheduleInitialFormationEvents();
+	else
 	{
-		Woman *pWoman = ppWomen[i];
-		assert(pWoman->getGender() == Person::Female);
+		for (int i = 0 ; i < numWomen ; i++)
+		{
+			Woman *pWoman = ppWomen[i];
+			assert(pWoman->getGender() == Person::Female);
 
-		if (pWoman->isSexuallyActive())
-			initializeFormationEvents(pWoman, true, false, 0);
+			if (pWoman->isSexuallyActive())
+				initializeFormationEvents(pWoman, true, false, 0);
+		}
 	}
 
 	// For MSM relations, TODO: check this!
@@ -192,53 +209,53 @@ bool_t SimpactPopulation::scheduleInitialEvents()
 		}
 	}
 
-	if (EventHIVSeed::getSeedTime() >= 0)
+	if (EventHIVSeed::getSeedTime(m_context) >= 0)
 	{
 		EventHIVSeed *pEvt = new EventHIVSeed(); // this is a global event
 		onNewEvent(pEvt);
 	}
 
-	if (EventHSV2Seed::getSeedTime() >= 0)
+	if (EventHSV2Seed::getSeedTime(m_context) >= 0)
 	{
 		EventHSV2Seed *pEvt = new EventHSV2Seed(); // this is a global event
 		onNewEvent(pEvt);
 	}
 
-	if (EventIntervention::hasNextIntervention()) // We need to schedule a first intervention event
+	if (EventIntervention::hasNextIntervention(m_context)) // We need to schedule a first intervention event
 	{
 		// Note: the fire time will be determined by the event itself, in the
 		//       getNewInternalTimeDifference function
-		EventIntervention *pEvt = new EventIntervention(); // global event
+		EventIntervention *pEvt = new EventIntervention(m_context); // global event
 		onNewEvent(pEvt);
 	}
 
-	if (EventPeriodicLogging::isEnabled())
+	if (EventPeriodicLogging::isEnabled(m_context))
 	{
-		double firstEventTime = EventPeriodicLogging::getFirstEventTime();
+		double firstEventTime = EventPeriodicLogging::getFirstEventTime(m_context);
 
 		EventPeriodicLogging *pEvt = new EventPeriodicLogging(firstEventTime); // global event
 		onNewEvent(pEvt);
 	}
 
-	if (EventSyncPopulationStatistics::isEnabled())
+	if (EventSyncPopulationStatistics::isEnabled(m_context))
 	{
 		EventSyncPopulationStatistics *pEvt = new EventSyncPopulationStatistics(); // global event, recalcs everything
 		onNewEvent(pEvt);
 	}
 
-	if (EventSyncReferenceYear::isEnabled())
+	if (EventSyncReferenceYear::isEnabled(m_context))
 	{
 		EventSyncReferenceYear *pEvt = new EventSyncReferenceYear();
 		onNewEvent(pEvt);
 	}
 
-	if (EventCheckStopAlgorithm::isEnabled())
+	if (EventCheckStopAlgorithm::isEnabled(m_context))
 	{
 		EventCheckStopAlgorithm *pEvt = new EventCheckStopAlgorithm();
 		onNewEvent(pEvt);
 	}
 
-	if (EventRelocation::isEnabled())
+	if (EventRelocation::isEnabled(m_context))
 	{
 		for (int i = 0 ; i < numPeople ; i++)
 		{
@@ -252,6 +269,72 @@ bool_t SimpactPopulation::scheduleInitialEvents()
 	return true;
 }
 
+// Without eyecaps, each sexually active woman gets a formation event with each sexually
+// active man, which is the same as what initializeFormationEvents would do for each
+// woman. To speed this up for a large population, the events are constructed in blocks,
+// in parallel if the algorithm runs in parallel. Each block is then passed to the
+// algorithm in the same order as before, so that the internal times are drawn from the
+// random number generator in the same way and the results don't depend on the number
+// of threads. The person reference counts are only updated there as well, serially.
+void SimpactPopulation::scheduleInitialFormationEvents()
+{
+	assert(m_eyeCapsFraction >= 1.0);
+
+	Man **ppMen = getMen();
+	Woman **ppWomen = getWomen();
+	int numMen = getNumberOfMen();
+	int numWomen = getNumberOfWomen();
+
+	vector<Man *> men;
+	vector<Woman *> women;
+
+	for (int i = 0 ; i < numMen ; i++)
+	{
+		if (m_attributeArrays.isSexuallyActive(i) && m_attributeArrays.getInfectionStage(i) != Person_HIV::AIDSFinal)
+			men.push_back(ppMen[i]);
+	}
+
+	for (int i = 0 ; i < numWomen ; i++)
+	{
+		if (ppWomen[i]->isSexuallyActive())
+			women.push_back(ppWomen[i]);
+	}
+
+	const int numPartners = (int)men.size();
+	if (numPartners == 0)
+		return;
+
+	// Each pair (woman, man) gets an index, the woman's position determines the
+	// order in which the events are passed to the algorithm
+	const int64_t numEvents = (int64_t)women.size()*(int64_t)numPartners;
+	const int64_t maxBlockEvents = 1<<16; // limits the size of the temporary list
+	vector<EventFormation *> events;
+
+	for (int64_t start = 0 ; start < numEvents ; start += maxBlockEvents)
+	{
+		const int64_t numBlockEvents = std::min(maxBlockEvents, numEvents - start);
+
+		events.resize(numBlockEvents);
+
+#ifndef DISABLEOPENMP
+#ifndef DISABLE_PARALLEL
+		#pragma omp parallel for if(m_alg.isParallel())
+#endif // DISABLE_PARALLEL
+#endif // !DISABLEOPENMP
+		for (int64_t i = 0 ; i < numBlockEvents ; i++)
+		{
+			int64_t idx = start + i;
+			Woman *pWoman = women[idx/numPartners];
+			Man *pMan = men[idx%numPartners];
+
+			events[i] = new EventFormation(pMan, pWoman, -1, 0);
+		}
+
+		for (size_t i = 0 ; i < events.size() ; i++)
+			onNewEvent(events[i]);
+	}
+}
+
 void SimpactPopulation::onAboutToFire(PopulationEvent *pEvt)
 {
 	SimpactEvent *pEvent = static_cast<SimpactEvent *>(pEvt);
@@ -265,6 +348,43 @@ void SimpactPopulation::onAboutToFire(PopulationEvent *pEvt)
 	pEvent->writeLogs(*this, t);
 }
 
+void SimpactPopulation::onPersonIndexChanged(PersonBase *pPersonBase, int idx)
+{
+	Person *pPerson = static_cast<Person *>(pPersonBase);
+
+	if (idx < 0) // deceased
+		pPerson->setAttributeArrays(0, -1);
+	else
+		pPerson->setAttributeArrays(&m_attributeArrays, idx);
+}
+
+// No event refers to this deceased person anymore, but other persons may still
+// have a pointer to him/her as a parent or as a child
+void SimpactPopulation::onReleaseDeceasedPerson(PersonBase *pPersonBase)
+{
+	Person *pPerson = static_cast<Person *>(pPersonBase);
+	assert(pPerson->hasDied());
+
+	Man *pFather = pPerson->getFather();
+	Woman *pMother = pPerson->getMother();
+
+	if (pFather)
+		pFather->removeChild(pPerson);
+	if (pMother)
+		pMother->removeChild(pPerson);
+
+	int numChildren = pPerson->getNumberOfChildren();
+	for (int i = 0 ; i < numChildren ; i++)
+	{
+		Person *pChild = pPerson->getChild(i);
+
+		if (pPerson->isMan())
+			pChild->clearFather();
+		else
+			pChild->clearMother();
+	}
+}
+
 void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initializationPhase, bool relocation, double tNow)
 {
 	assert(pPerson->isSexuallyActive());
@@ -287,13 +407,14 @@ void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initiali
 				{
 					Woman **ppWomen = getWomen();
 					int numWomen = getNumberOfWomen();
+					int firstWoman = getNumberOfMen(); // position in the attribute arrays
 
 					for (int i = 0 ; i < numWomen ; i++)
 					{
-						Woman *pWoman = ppWomen[i];
-						
-						if (pWoman->isSexuallyActive() && pWoman->hiv().getInfectionStage() != Person_HIV::AIDSFinal)
+						if (m_attributeArrays.isSexuallyActive(firstWoman+i) && m_attributeArrays.getInfectionStage(firstWoman+i) != Person_HIV::AIDSFinal)
 						{
+							Woman *pWoman = ppWomen[i];
+
 							EventFormation *pEvt = new EventFormation(pMan, pWoman, -1, tNow); 
 							onNewEvent(pEvt);
 						}
@@ -308,9 +429,12 @@ void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initiali
 
 					for (int i = 0 ; i < numMen ; i++)
 					{
+						if (!m_attributeArrays.isSexuallyActive(i) || m_attributeArrays.getInfectionStage(i) == Person_HIV::AIDSFinal)
+							continue;
+
 						Man *pMan2 = ppMen[i];
 
-						if (pMan != pMan2 && pMan2->isSexuallyActive() && pMan2->hiv().getInfectionStage() != Person_HIV::AIDSFinal)
+						if (pMan != pMan2)
 						{
 							if (initializationPhase && pMan->getPersonID() > pMan2->getPersonID())
 								continue;
@@ -336,10 +460,10 @@ void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initiali
 
 				for (int i = 0 ; i < numMen ; i++)
 				{
-					Man *pMan = ppMen[i];
-
-					if (pMan->isSexuallyActive() && pMan->hiv().getInfectionStage() != Person_HIV::AIDSFinal)
+					if (m_attributeArrays.isSexuallyActive(i) && m_attributeArrays.getInfectionStage(i) != Person_HIV::AIDSFinal)
 					{
+						Man *pMan = ppMen[i];
+
 						EventFormation *pEvt = new EventFormation(pMan, pWoman, -1, tNow);
 						onNewEvent(pEvt);
 					}
@@ -376,7 +500,7 @@ void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initiali
 
 			getInterestsForPerson(pMan, interests, interestsMSM);
 			
-			for (int i = 0 ; i < numInterests ; i++)
+			for (size_t i = 0 ; i < interests.size() ; i++)
 			{
 				Person *pWoman = interests[i];
 				assert(pWoman->isWoman());
@@ -385,7 +509,7 @@ void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initiali
 					pMan->addPersonOfInterest(pWoman);
 			}
 
-			for (int i = 0 ; i < numInterestsMSM ; i++) // MSM interests
+			for (size_t i = 0 ; i < interestsMSM.size() ; i++) // MSM interests
 			{
 				Person *pMan2 = interestsMSM[i];
 				assert(pMan2 && pMan2->isMan());
@@ -433,7 +557,7 @@ void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initiali
 
 			getInterestsForPerson(pWoman, interests, interestsMSM);
 			
-			for (int i = 0 ; i < numInterests ; i++)
+			for (size_t i = 0 ; i < interests.size() ; i++)
 			{
 				Person *pMan = interests[i];
 				assert(pMan->isMan());
@@ -454,6 +578,9 @@ void SimpactPopulation::initializeFormationEvents(Person *pPerson, bool initiali
 				onNewEvent(pEvt);
 			}
 		}
+
+		// Don't keep the pointers around, these persons may die and be released
+		pPerson->clearPersonsOfInterest();
 	}
 }
 
@@ -514,17 +641,16 @@ void SimpactPopulation::getInterestsForPerson(const Person *pPerson,
 	{
 		assert(m_pCoarseMap);
 
-		vector<CoarseMapCell *> cells;
+		// Only the cells that are needed are looked up, in order of increasing distance
+		CoarseMapDistanceIterator cells(*m_pCoarseMap, pPerson->getLocation());
 
-		m_pCoarseMap->getDistanceOrderedCells(cells, pPerson->getLocation());
-		
 #if 0
 		cout << "Location: " << pPerson->getLocation().x << " " << pPerson->getLocation().y << endl;
 		int totalPop = 0;
-		for (size_t i = 0 ; i < cells.size() ; i++)
+		for (int i = 0 ; cells.getCell(i) ; i++)
 		{
-			cout << "  " << cells[i]->m_center.x << " " << cells[i]->m_center.y << " " << cells[i]->m_personsInCell.size() << endl;
-			totalPop += cells[i]->m_personsInCell.size();
+			cout << "  " << cells.getCell(i)->m_center.x << " " << cells.getCell(i)->m_center.y << " " << cells.getCell(i)->getNumberOfPersons() << endl;
+			totalPop += cells.getCell(i)->getNumberOfPersons();
 		}
 		cout << "Total pop: " << totalPop << endl;
 
@@ -533,17 +659,43 @@ void SimpactPopulation::getInterestsForPerson(const Person *pPerson,
 #endif
 
 		Person::Gender personGender = pPerson->getGender();
+		Person::Gender otherGender = (personGender == Person::Male) ? Person::Female : Person::Male;
+
+		if (CoarseMap::useExactNearest(m_context))
+		{
+			// Use the persons that are really closest, for MSM this includes the person
+			// itself (as above, this will be filtered later)
+			vector<Person *> nearest;
+
+			// Fewer persons than requested can be returned, so the list of interests
+			// is shortened accordingly
+			m_pCoarseMap->getNearestPersons(pPerson->getLocation(), otherGender, interests.size(), nearest);
+			interests.resize(nearest.size());
+			for (size_t i = 0 ; i < nearest.size() ; i++)
+				interests[i] = nearest[i];
+
+			if (personGender == Person::Male)
+			{
+				m_pCoarseMap->getNearestPersons(pPerson->getLocation(), Person::Male, interestsMSM.size(), nearest);
+				interestsMSM.resize(nearest.size());
+				for (size_t i = 0 ; i < nearest.size() ; i++)
+					interestsMSM[i] = nearest[i];
+			}
+			return;
+		}
+
 		{
 			// First we consider heterosexual relationships
 
 			size_t intPos = 0;
-			size_t cellPos = 0;
-			while (intPos < interests.size() && cellPos < cells.size())
+			int cellPos = 0;
+			CoarseMapCell *pCell;
+			while (intPos < interests.size() && (pCell = cells.getCell(cellPos)) != 0)
 			{
-				CoarseMapCell *pCell = cells[cellPos];
 				cellPos++;
 
-				vector<Person *> &people = pCell->m_personsInCell;
+				// Only the people of the other gender are needed
+				const vector<Person *> &people = pCell->getPersons(otherGender);
 				int interestsLeft = interests.size() - intPos;
 
 				// For now we'll either add the entire cell or as many people as are still needed
@@ -553,11 +705,9 @@ void SimpactPopulation::getInterestsForPerson(const Person *pPerson,
 				{
 					Person *pPartner = people[i];
 
-					if (pPartner->getGender() != personGender)
-					{
-						interests[intPos] = pPartner;
-						intPos++;
-					}
+					assert(pPartner->getGender() != personGender);
+					interests[intPos] = pPartner;
+					intPos++;
 				}
 			}
 		}
@@ -567,13 +717,13 @@ void SimpactPopulation::getInterestsForPerson(const Person *pPerson,
 		if (personGender == Person::Male)
 		{
 			size_t intPos = 0;
-			size_t cellPos = 0;
-			while (intPos < interestsMSM.size() && cellPos < cells.size())
+			int cellPos = 0;
+			CoarseMapCell *pCell;
+			while (intPos < interestsMSM.size() && (pCell = cells.getCell(cellPos)) != 0)
 			{
-				CoarseMapCell *pCell = cells[cellPos];
 				cellPos++;
 
-				vector<Person *> &people = pCell->m_personsInCell;
+				const vector<Person *> &people = pCell->getPersons(Person::Male);
 				int interestsLeft = interestsMSM.size() - intPos;
 
 				// For now we'll either add the entire cell or as many people as are still needed
@@ -587,11 +737,8 @@ void SimpactPopulation::getInterestsForPerson(const Person *pPerson,
 					// In principle it's possible that we're interested in ourselves, but this will
 					// be filtered later on. At this point it's important that we set all entries
 					// of the interestsMSM vector
-					if (pPartner->getGender() == Person::Male)
-					{
-						interestsMSM[intPos] = pPartner;
-						intPos++;
-					}
+					interestsMSM[intPos] = pPartner;
+					intPos++;
 				}
 			}
 		}
@@ -647,5 +794,17 @@ JSONConfig populationJSONConfig(R"JSON(
                 "only used in the initial scheduling of formation events, but also ",
                 "when a debut event fires, to limit the newly scheduled formation events."
             ]  
+        },
+
+        "Population_3": { 
+            "depends": null,
+            "params": [ ["population.deceased.release", "no", [ "yes", "no" ] ] ],
+            "info": [ 
+                "If set to 'yes', the person log entry of someone who dies is written",
+                "immediately, and the memory for this person is released as soon as no",
+                "event can refer to him or her anymore. Useful for long simulations, in",
+                "which the deceased would otherwise outnumber the living people. Note",
+                "that the order of the entries in the person log will be different."
+            ]  
         })JSON");
 
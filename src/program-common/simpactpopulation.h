@@ -5,7 +5,9 @@
 #include "populationinterfaces.h"
 #include "person.h"
 #include "coarsemap.h"
+#include "simpactcontext.h"
 #include <assert.h>
+#include <vector>
 
 class PopulationDistribution;
 class Person;
@@ -22,15 +24,18 @@ public:
 	void setInitialWomen(int number)								{ m_initialWomen = number; }
 	void setEyeCapsFraction(double f)								{ m_eyeCapsFraction = f; }
 	void setMSM(bool f)												{ m_msm = f; }
+	void setReleaseDeceased(bool f)									{ m_releaseDeceased = f; }
 
 	int getInitialMen() const										{ return m_initialMen; }
 	int getInitialWomen() const										{ return m_initialWomen; }
 	double getEyeCapsFraction() const								{ return m_eyeCapsFraction; }
 	bool getMSM() const												{ return m_msm; }
+	bool getReleaseDeceased() const									{ return m_releaseDeceased; }
 private:
 	int m_initialMen, m_initialWomen;
 	double m_eyeCapsFraction;
 	bool m_msm;
+	bool m_releaseDeceased;
 };
 
 class SimpactPopulation : public PopulationStateExtra, public PopulationAlgorithmAboutToFireInterface
@@ -53,12 +58,22 @@ public:
 	int getNumberOfWomen() const				{ return m_state.getNumberOfWomen(); }
 	int getNumberOfDeceasedPeople() const		{ return m_state.getNumberOfDeceasedPeople(); }
 
+	// When population.deceased.release is set, the person log entry is written when
+	// someone dies, and the deceased Person is deleted once no event refers to it anymore.
+	// Those persons no longer appear in getDeceasedPeople.
+	bool isReleasingDeceasedPeople() const		{ return m_releaseDeceased; }
+
 	void addNewPerson(Person *pPerson);
 	void setPersonDied(Person *pPerson);
 	void markAffectedPerson(Person *pPerson) const	{ m_state.markAffectedPerson(pPerson); }
 
+	// Some person attributes, in arrays with the same layout as the one from getAllPeople
+	const PersonAttributeArrays &getAttributeArrays() const		{ return m_attributeArrays; }
+
 	double getTime() const						{ return m_state.getTime(); }
 	void onNewEvent(PopulationEvent *pEvt)		{ m_alg.onNewEvent(pEvt); }
+	void removeUselessEvents(Person *pPerson)	{ m_alg.removeUselessEvents(pPerson); }
+	void getPendingEvents(std::vector<PopulationEvent *> &events)	{ m_alg.getPendingEvents(events); }
 	GslRandomNumberGenerator *getRandomNumberGenerator() const { return m_alg.getRandomNumberGenerator(); }
 
 	int getLastKnownPopulationSize(double &popTime) const			{ popTime = m_lastKnownPopulationSizeTime; assert(popTime >= 0); assert(m_lastKnownPopulationSize >= 0); return m_lastKnownPopulationSize; }
@@ -69,6 +84,10 @@ public:
 
 	double getEyeCapsFraction() const								{ return m_eyeCapsFraction; }
 
+	// The settings of this simulation, this is the context that was set by
+	// SimpactContext::setConfigContext when the population was created
+	SimpactContext &getContext() const								{ return m_context; }
+
 	// Is called by debut event
 	virtual void initializeFormationEvents(Person *pPerson, bool initializationPhase, bool relocation, double tNow);
 	
@@ -80,12 +99,17 @@ protected:
 	virtual bool_t scheduleInitialEvents();
 	virtual void getInterestsForPerson(const Person *pPerson, std::vector<Person *> &interests, std::vector<Person *> &interestsMSM);
 private:
+	void scheduleInitialFormationEvents();
 	void onAboutToFire(PopulationEvent *pEvt);
+	void onPersonIndexChanged(PersonBase *pPerson, int idx);
+	void onNumberOfPeopleChanged(int numPeople)					{ m_attributeArrays.resize(numPeople); }
+	void onReleaseDeceasedPerson(PersonBase *pPerson);
 
 	//int m_initialPopulationSize;
 	double m_eyeCapsFraction;
 	double m_referenceYear;
 	bool m_msm;
+	bool m_releaseDeceased;
 
 	int m_lastKnownPopulationSize;
 	double m_lastKnownPopulationSizeTime;
@@ -94,8 +118,10 @@ private:
 	
 	PopulationStateInterface &m_state;
 	PopulationAlgorithmInterface &m_alg;
+	SimpactContext &m_context;
 
 	CoarseMap *m_pCoarseMap;
+	PersonAttributeArrays m_attributeArrays;
 };
 
 inline SimpactPopulation &SIMPACTPOPULATION(State *pState)
@@ -116,6 +142,7 @@ inline const SimpactPopulation &SIMPACTPOPULATION(const State *pState)
 
 inline void SimpactPopulation::addNewPerson(Person *pPerson)	
 { 
+	assert(&pPerson->getContext() == &m_context);
 	m_state.addNewPerson(pPerson); 
 
 	if (m_pCoarseMap)
@@ -128,6 +155,9 @@ inline void SimpactPopulation::setPersonDied(Person *pPerson)
 		m_pCoarseMap->removePerson(pPerson);
 
 	m_state.setPersonDied(pPerson); 
+
+	if (m_releaseDeceased)
+		pPerson->writeToPersonLog();
 }
 
 #endif // SIMPACTPOPULATION_H
@@ -32,7 +32,7 @@ string EventMonitoring::getDescription(double tNow) const
 void EventMonitoring::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
 	Person *pPerson = getPerson(0);
-	writeEventLogStart(false, "monitoring", tNow, pPerson, 0);
+	writeEventLogStart(pop.getContext(), false, "monitoring", tNow, pPerson, 0);
 
 	double threshold = -1;
 	const MaxARTPopulation &population = static_cast<const MaxARTPopulation &>(pop);
@@ -46,7 +46,7 @@ void EventMonitoring::writeLogs(const SimpactPopulation &pop, double tNow) const
 	else if (population.getStudyStage() == MaxARTPopulation::InStudy)
 		stageName = pFac->getStageName();
 
-	LogEvent.print(",CD4,%g,Facility,%s,Stage,%s,CD4Threshold,%g", 
+	LogSystem::get(pop.getContext()).logEvents.print(",CD4,%g,Facility,%s,Stage,%s,CD4Threshold,%g", 
 			        pPerson->hiv().getCD4Count(tNow), pFac->getName().c_str(), stageName.c_str(), threshold);
 }
 
@@ -80,7 +80,7 @@ const Facility *EventMonitoring::getCurrentFacility() const
 	Person *pPerson = getPerson(0);
 	Point2D personLocation = pPerson->getLocation();
 
-	Facilities *pFacilities = Facilities::getInstance();
+	Facilities *pFacilities = Facilities::getInstance(pPerson->getContext());
 	assert(pFacilities);
 
 	int num = pFacilities->getNumberOfFacilities();
@@ -109,26 +109,27 @@ const Facility *EventMonitoring::getCurrentFacility() const
 
 const Facility *EventMonitoring::getCurrentFacilityAndThreshold(const MaxARTPopulation &population, double &threshold) const
 {
+	const EventMonitoringSettings &settings = population.getContext().get(s_settings);
 	const Facility *pFac = getCurrentFacility();
 
 	threshold = -1;
 	switch(population.getStudyStage())
 	{
 	case MaxARTPopulation::PreStudy:
-		threshold = s_cd4ThresholdPreStudy;
+		threshold = settings.m_cd4ThresholdPreStudy;
 		break;
 	case MaxARTPopulation::InStudy:
 		if (pFac->getStage() == Facility::ControlStage)
-			threshold = s_cd4ThresholdInStudyControlStage;
+			threshold = settings.m_cd4ThresholdInStudyControlStage;
 		else if (pFac->getStage() == Facility::TransitionStage)
-			threshold = s_cd4ThresholdInStudyTransitionStage;
+			threshold = settings.m_cd4ThresholdInStudyTransitionStage;
 		else if (pFac->getStage() == Facility::InterventionStage)
-			threshold = s_cd4ThresholdInStudyInterventionStage;
+			threshold = settings.m_cd4ThresholdInStudyInterventionStage;
 		else
 			abortWithMessage("Internal error: unknown MaxART facility stage");
 		break;
 	case MaxARTPopulation::PostStudy:
-		threshold = s_cd4ThresholdPostStudy;
+		threshold = settings.m_cd4ThresholdPostStudy;
 		break;
 	default:
 		abortWithMessage("Internal error: unknown MaxART study stage");
@@ -154,18 +155,19 @@ void EventMonitoring::fire(Algorithm *pAlgorithm, State *pState, double t)
 {
 	MaxARTPopulation &population = MAXARTPOPULATION(pState);
 	GslRandomNumberGenerator *pRndGen = population.getRandomNumberGenerator();
+	const EventMonitoringSettings &settings = population.getContext().get(s_settings);
 	Person *pPerson = getPerson(0);
 
 	assert(pPerson->hiv().isInfected());
 	assert(!pPerson->hiv().hasLoweredViralLoad());
-	assert(s_treatmentVLLogFrac >= 0 && s_treatmentVLLogFrac <= 1.0);
+	assert(settings.m_treatmentVLLogFrac >= 0 && settings.m_treatmentVLLogFrac <= 1.0);
 
 	if (isEligibleForTreatment(t, population) && isWillingToStartTreatment(t, pRndGen))
 	{
-		SimpactEvent::writeEventLogStart(true, "(treatment)", t, pPerson, 0);
+		SimpactEvent::writeEventLogStart(population.getContext(), true, "(treatment)", t, pPerson, 0);
 
 		// Person is starting treatment, no further HIV test events will follow
-		pPerson->hiv().lowerViralLoad(s_treatmentVLLogFrac, t);
+		pPerson->hiv().lowerViralLoad(settings.m_treatmentVLLogFrac, t);
 
 		// Dropout event becomes possible
 		EventDropout *pEvtDropout = new EventDropout(pPerson, t);
@@ -189,36 +191,37 @@ double EventMonitoring::getNewInternalTimeDifference(GslRandomNumberGenerator *p
 		return hour * pRndGen->pickRandomDouble();
 	}
 
-	assert(s_pRecheckInterval);
-
 	const MaxARTPopulation &population = MAXARTPOPULATION(pState);
+	const EventMonitoringSettings &settings = population.getContext().get(s_settings);
 	Person *pPerson = getPerson(0);
+
+	assert(settings.m_pRecheckInterval);
 	double currentTime = population.getTime();
 	double cd4 = pPerson->hiv().getCD4Count(currentTime);
-	double dt = s_pRecheckInterval->evaluate(cd4);
+	double dt = settings.m_pRecheckInterval->evaluate(cd4);
 
 	assert(dt >= 0);
 	return dt;
 }
 
-double EventMonitoring::s_treatmentVLLogFrac = -1;
-double EventMonitoring::s_cd4ThresholdPreStudy = -1;
-double EventMonitoring::s_cd4ThresholdInStudyControlStage = -1;
-double EventMonitoring::s_cd4ThresholdInStudyTransitionStage = -1;
-double EventMonitoring::s_cd4ThresholdInStudyInterventionStage = -1;
-double EventMonitoring::s_cd4ThresholdPostStudy = -1;
-PieceWiseLinearFunction *EventMonitoring::s_pRecheckInterval = 0;
+EventMonitoringSettings::~EventMonitoringSettings()
+{
+	delete m_pRecheckInterval;
+}
+
+SimpactContext::Slot<EventMonitoringSettings> EventMonitoring::s_settings;
 
 void EventMonitoring::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventMonitoringSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("monitoring.cd4.threshold.prestudy", s_cd4ThresholdPreStudy, 0)) ||
-		!(r = config.getKeyValue("monitoring.cd4.threshold.poststudy", s_cd4ThresholdPostStudy, 0)) ||
-		!(r = config.getKeyValue("monitoring.cd4.threshold.instudy.controlstage", s_cd4ThresholdInStudyControlStage, 0)) ||
-		!(r = config.getKeyValue("monitoring.cd4.threshold.instudy.transitionstage", s_cd4ThresholdInStudyTransitionStage, 0)) ||
-		!(r = config.getKeyValue("monitoring.cd4.threshold.instudy.interventionstage", s_cd4ThresholdInStudyInterventionStage, 0)) ||
-	    !(r = config.getKeyValue("monitoring.fraction.log_viralload", s_treatmentVLLogFrac, 0, 1)))
+	if (!(r = config.getKeyValue("monitoring.cd4.threshold.prestudy", settings.m_cd4ThresholdPreStudy, 0)) ||
+		!(r = config.getKeyValue("monitoring.cd4.threshold.poststudy", settings.m_cd4ThresholdPostStudy, 0)) ||
+		!(r = config.getKeyValue("monitoring.cd4.threshold.instudy.controlstage", settings.m_cd4ThresholdInStudyControlStage, 0)) ||
+		!(r = config.getKeyValue("monitoring.cd4.threshold.instudy.transitionstage", settings.m_cd4ThresholdInStudyTransitionStage, 0)) ||
+		!(r = config.getKeyValue("monitoring.cd4.threshold.instudy.interventionstage", settings.m_cd4ThresholdInStudyInterventionStage, 0)) ||
+	    !(r = config.getKeyValue("monitoring.fraction.log_viralload", settings.m_treatmentVLLogFrac, 0, 1)))
 		abortWithMessage(r.getErrorString());
 
 	vector<double> intervalX, intervalY;
@@ -247,15 +250,17 @@ void EventMonitoring::processConfig(ConfigSettings &config, GslRandomNumberGener
 	for (size_t i = 0 ; i < intervalX.size() ; i++)
 		points.push_back(Point2D(intervalX[i], intervalY[i]));
 
-	delete s_pRecheckInterval;
-	s_pRecheckInterval = new PieceWiseLinearFunction(points, leftValue, rightValue);
+	delete settings.m_pRecheckInterval;
+	settings.m_pRecheckInterval = new PieceWiseLinearFunction(points, leftValue, rightValue);
 }
 
 void EventMonitoring::obtainConfig(ConfigWriter &config)
 {
-	assert(s_pRecheckInterval);
+	const EventMonitoringSettings &settings = SimpactContext::getConfigContext().get(s_settings);
+
+	assert(settings.m_pRecheckInterval);
 
-	const vector<Point2D> &points = s_pRecheckInterval->getPoints();
+	const vector<Point2D> &points = settings.m_pRecheckInterval->getPoints();
 	vector<double> intervalX, intervalY;
 
 	for (size_t i = 0 ; i < points.size() ; i++)
@@ -266,16 +271,16 @@ void EventMonitoring::obtainConfig(ConfigWriter &config)
 
 	bool_t r;
 	
-	if (!(r = config.addKey("monitoring.cd4.threshold.prestudy", s_cd4ThresholdPreStudy)) ||
-		!(r = config.addKey("monitoring.cd4.threshold.poststudy", s_cd4ThresholdPostStudy)) ||
-		!(r = config.addKey("monitoring.cd4.threshold.instudy.controlstage", s_cd4ThresholdInStudyControlStage)) ||
-		!(r = config.addKey("monitoring.cd4.threshold.instudy.transitionstage", s_cd4ThresholdInStudyTransitionStage)) ||
-		!(r = config.addKey("monitoring.cd4.threshold.instudy.interventionstage", s_cd4ThresholdInStudyInterventionStage)) ||
-	    !(r = config.addKey("monitoring.fraction.log_viralload", s_treatmentVLLogFrac)) ||
+	if (!(r = config.addKey("monitoring.cd4.threshold.prestudy", settings.m_cd4ThresholdPreStudy)) ||
+		!(r = config.addKey("monitoring.cd4.threshold.poststudy", settings.m_cd4ThresholdPostStudy)) ||
+		!(r = config.addKey("monitoring.cd4.threshold.instudy.controlstage", settings.m_cd4ThresholdInStudyControlStage)) ||
+		!(r = config.addKey("monitoring.cd4.threshold.instudy.transitionstage", settings.m_cd4ThresholdInStudyTransitionStage)) ||
+		!(r = config.addKey("monitoring.cd4.threshold.instudy.interventionstage", settings.m_cd4ThresholdInStudyInterventionStage)) ||
+	    !(r = config.addKey("monitoring.fraction.log_viralload", settings.m_treatmentVLLogFrac)) ||
 	    !(r = config.addKey("monitoring.interval.piecewise.cd4s", intervalX)) ||
 	    !(r = config.addKey("monitoring.interval.piecewise.times", intervalY)) ||
-	    !(r = config.addKey("monitoring.interval.piecewise.left", s_pRecheckInterval->getLeftValue())) ||
-	    !(r = config.addKey("monitoring.interval.piecewise.right", s_pRecheckInterval->getRightValue())) )
+	    !(r = config.addKey("monitoring.interval.piecewise.left", settings.m_pRecheckInterval->getLeftValue())) ||
+	    !(r = config.addKey("monitoring.interval.piecewise.right", settings.m_pRecheckInterval->getRightValue())) )
 		abortWithMessage(r.getErrorString());
 }
 
@@ -10,6 +10,23 @@ class PieceWiseLinearFunction;
 class Facility;
 class MaxARTPopulation;
 
+class EventMonitoringSettings
+{
+public:
+	EventMonitoringSettings() : m_treatmentVLLogFrac(-1), m_cd4ThresholdPreStudy(-1), m_cd4ThresholdInStudyControlStage(-1),
+	                            m_cd4ThresholdInStudyTransitionStage(-1), m_cd4ThresholdInStudyInterventionStage(-1),
+	                            m_cd4ThresholdPostStudy(-1), m_pRecheckInterval(0)								{ }
+	~EventMonitoringSettings();
+
+	double m_treatmentVLLogFrac;
+	double m_cd4ThresholdPreStudy;
+	double m_cd4ThresholdInStudyControlStage;
+	double m_cd4ThresholdInStudyTransitionStage;
+	double m_cd4ThresholdInStudyInterventionStage;
+	double m_cd4ThresholdPostStudy;
+	PieceWiseLinearFunction *m_pRecheckInterval;
+};
+
 class EventMonitoring : public SimpactEvent
 {
 public:
@@ -31,14 +48,7 @@ private:
 
 	bool m_scheduleImmediately;
 
-	static double s_treatmentVLLogFrac;
-	static double s_cd4Threshold;
-	static double s_cd4ThresholdPreStudy;
-	static double s_cd4ThresholdInStudyControlStage;
-	static double s_cd4ThresholdInStudyTransitionStage;
-	static double s_cd4ThresholdInStudyInterventionStage;
-	static double s_cd4ThresholdPostStudy;
-	static PieceWiseLinearFunction *s_pRecheckInterval;
+	static SimpactContext::Slot<EventMonitoringSettings> s_settings;
 };
 
 #endif // EVENTMONITORING_H
@@ -17,7 +17,8 @@ EventStudyEnd::~EventStudyEnd()
 
 double EventStudyEnd::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	double dt = EventStudyStep::getStepInterval();
+	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	double dt = EventStudyStep::getStepInterval(population.getContext());
 	assert(dt > 0);
 
 	return dt;
@@ -30,7 +31,7 @@ std::string EventStudyEnd::getDescription(double tNow) const
 
 void EventStudyEnd::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "studyend", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "studyend", tNow, 0, 0);
 }
 
 void EventStudyEnd::fire(Algorithm *pAlgorithm, State *pState, double t)
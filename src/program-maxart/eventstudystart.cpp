@@ -19,9 +19,10 @@ EventStudyStart::~EventStudyStart()
 double EventStudyStart::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
 	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
-	assert(s_startTime >= 0);
+	const EventStudyStartSettings &settings = population.getContext().get(s_settings);
+	assert(settings.m_startTime >= 0);
 
-	double dt = s_startTime - population.getTime();
+	double dt = settings.m_startTime - population.getTime();
 	assert(dt >= 0);
 
 	return dt;
@@ -34,7 +35,7 @@ std::string EventStudyStart::getDescription(double tNow) const
 
 void EventStudyStart::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "studystart", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "studystart", tNow, 0, 0);
 }
 
 void EventStudyStart::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -46,7 +47,7 @@ void EventStudyStart::fire(Algorithm *pAlgorithm, State *pState, double t)
 
 #ifndef NDEBUG
 	// Schedule the event to proceed to the first step
-	Facilities *pFacilities = Facilities::getInstance();
+	Facilities *pFacilities = Facilities::getInstance(population.getContext());
 	assert(pFacilities && pFacilities->getNumberOfRandomizationSteps() > 0);
 #endif // NDEBUG
 
@@ -56,21 +57,23 @@ void EventStudyStart::fire(Algorithm *pAlgorithm, State *pState, double t)
 	EventStudyStep::writeToLog(t, population, true);
 }
 
-double EventStudyStart::s_startTime = -1;
+SimpactContext::Slot<EventStudyStartSettings> EventStudyStart::s_settings;
 
 void EventStudyStart::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventStudyStartSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("maxart.starttime", s_startTime, 0)))
+	if (!(r = config.getKeyValue("maxart.starttime", settings.m_startTime, 0)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventStudyStart::obtainConfig(ConfigWriter &config)
 {
+	const EventStudyStartSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("maxart.starttime", s_startTime)))
+	if (!(r = config.addKey("maxart.starttime", settings.m_startTime)))
 		abortWithMessage(r.getErrorString());
 }
 
@@ -6,6 +6,14 @@
 
 class ConfigSettings;
 
+class EventStudyStartSettings
+{
+public:
+	EventStudyStartSettings() : m_startTime(-1)												{ }
+
+	double m_startTime;
+};
+
 class EventStudyStart : public SimpactEvent
 {
 public:
@@ -20,11 +28,11 @@ public:
 	static void processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainConfig(ConfigWriter &config);
 
-	static bool isMaxARTStudyEnabled()														{ return (s_startTime >= 0); }
+	static bool isMaxARTStudyEnabled(const SimpactContext &context)						{ return (context.get(s_settings).m_startTime >= 0); }
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
-	static double s_startTime;
+	static SimpactContext::Slot<EventStudyStartSettings> s_settings;
 };
 
 #endif // EVENTSTUDYSTART_H
@@ -21,8 +21,11 @@ EventStudyStep::~EventStudyStep()
 
 double EventStudyStep::getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState)
 {
-	assert(s_stepInterval >= 0);
-	return s_stepInterval;
+	const SimpactPopulation &population = SIMPACTPOPULATION(pState);
+	double dt = getStepInterval(population.getContext());
+
+	assert(dt >= 0);
+	return dt;
 }
 
 std::string EventStudyStep::getDescription(double tNow) const
@@ -32,7 +35,7 @@ std::string EventStudyStep::getDescription(double tNow) const
 
 void EventStudyStep::writeLogs(const SimpactPopulation &pop, double tNow) const
 {
-	writeEventLogStart(true, "studystep", tNow, 0, 0);
+	writeEventLogStart(pop.getContext(), true, "studystep", tNow, 0, 0);
 }
 
 void EventStudyStep::fire(Algorithm *pAlgorithm, State *pState, double t)
@@ -40,7 +43,7 @@ void EventStudyStep::fire(Algorithm *pAlgorithm, State *pState, double t)
 	MaxARTPopulation &population = MAXARTPOPULATION(pState);
 	assert(population.getStudyStage() == MaxARTPopulation::InStudy);
 
-	Facilities *pFacilities = Facilities::getInstance();
+	Facilities *pFacilities = Facilities::getInstance(population.getContext());
 	assert(pFacilities);
 
 	int numRandSteps = pFacilities->getNumberOfRandomizationSteps();
@@ -95,38 +98,41 @@ void EventStudyStep::fire(Algorithm *pAlgorithm, State *pState, double t)
 
 void EventStudyStep::writeToLog(double t, const MaxARTPopulation &population, bool start)
 {
-	if (!s_stepLog.isOpen())
+	EventStudyStepSettings &settings = population.getContext().get(s_settings);
+	LogFile &stepLog = settings.m_stepLog;
+
+	if (!stepLog.isOpen())
 		return;
 
-	Facilities *pFacilities = Facilities::getInstance();
+	Facilities *pFacilities = Facilities::getInstance(population.getContext());
 	const int num = pFacilities->getNumberOfFacilities();
 	if (start) // write the CSV headers
 	{
-		if (s_facilityLogNames.size() > 0)
+		if (settings.m_facilityLogNames.size() > 0)
 			abortWithMessage("ERROR: double study start?");
 
-		s_stepLog.printNoNewLine("\"time\"");
+		stepLog.printNoNewLine("\"time\"");
 
 		for (int i = 0 ; i < num ; i++)
 		{
 			const Facility *pFacility = pFacilities->getFacility(i);
 			string name = pFacility->getName();
-			s_stepLog.printNoNewLine(",\"%s\"", name.c_str());
+			stepLog.printNoNewLine(",\"%s\"", name.c_str());
 
-			s_facilityLogNames.push_back(name);
+			settings.m_facilityLogNames.push_back(name);
 		}
-		s_stepLog.print("");
+		stepLog.print("");
 	}
 
-	if (num != (int)s_facilityLogNames.size())
+	if (num != (int)settings.m_facilityLogNames.size())
 		abortWithMessage("ERROR: number of facility names has changed");
 
-	s_stepLog.printNoNewLine("%g", t);
+	stepLog.printNoNewLine("%g", t);
 	for (int i = 0 ; i < num ; i++)
 	{
 			const Facility *pFacility = pFacilities->getFacility(i);
 			
-			if (pFacility->getName() != s_facilityLogNames[i])
+			if (pFacility->getName() != settings.m_facilityLogNames[i])
 				abortWithMessage("ERROR: a facility name has changed");
 
 			string stageName;
@@ -155,33 +161,34 @@ void EventStudyStep::writeToLog(double t, const MaxARTPopulation &population, bo
 			else
 				stageName = "?";
 
-			s_stepLog.printNoNewLine(",\"%s\"", stageName.c_str());
+			stepLog.printNoNewLine(",\"%s\"", stageName.c_str());
 	}
-	s_stepLog.print("");
+	stepLog.print("");
 }
 
-double EventStudyStep::s_stepInterval = -1;
-LogFile EventStudyStep::s_stepLog;
-vector<string> EventStudyStep::s_facilityLogNames;
+SimpactContext::Slot<EventStudyStepSettings> EventStudyStep::s_settings;
 
 void EventStudyStep::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventStudyStepSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.getKeyValue("maxart.stepinterval", s_stepInterval, 0)))
+	if (!(r = config.getKeyValue("maxart.stepinterval", settings.m_stepInterval, 0)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventStudyStep::obtainConfig(ConfigWriter &config)
 {
+	const EventStudyStepSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("maxart.stepinterval", s_stepInterval)))
+	if (!(r = config.addKey("maxart.stepinterval", settings.m_stepInterval)))
 		abortWithMessage(r.getErrorString());
 }
 
 void EventStudyStep::processLogConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	EventStudyStepSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 	string stepLog;
 
@@ -190,16 +197,17 @@ void EventStudyStep::processLogConfig(ConfigSettings &config, GslRandomNumberGen
 
 	if (stepLog.length() > 0)
 	{
-		if (!(r = s_stepLog.open(stepLog)))
+		if (!(r = settings.m_stepLog.open(stepLog)))
 			abortWithMessage(r.getErrorString());
 	}
 }
 
 void EventStudyStep::obtainLogConfig(ConfigWriter &config)
 {
+	const EventStudyStepSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("maxart.outfile.logsteps", s_stepLog.getFileName())))
+	if (!(r = config.addKey("maxart.outfile.logsteps", settings.m_stepLog.getFileName())))
 		abortWithMessage(r.getErrorString());
 }
 
@@ -8,6 +8,16 @@
 class ConfigSettings;
 class MaxARTPopulation;
 
+class EventStudyStepSettings
+{
+public:
+	EventStudyStepSettings() : m_stepInterval(-1)											{ }
+
+	double m_stepInterval;
+	LogFile m_stepLog;
+	std::vector<std::string> m_facilityLogNames; // For checking
+};
+
 class EventStudyStep : public SimpactEvent
 {
 public:
@@ -24,16 +34,14 @@ public:
 	static void processLogConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen);
 	static void obtainLogConfig(ConfigWriter &config);
 
-	static double getStepInterval()															{ return s_stepInterval; }
+	static double getStepInterval(const SimpactContext &context)							{ return context.get(s_settings).m_stepInterval; }
 	static void writeToLog(double t, const MaxARTPopulation & population, bool start = false);
 private:
 	double getNewInternalTimeDifference(GslRandomNumberGenerator *pRndGen, const State *pState);
 
 	int m_stepIndex;
 
-	static double s_stepInterval;
-	static LogFile s_stepLog;
-	static std::vector<std::string> s_facilityLogNames; // For checking
+	static SimpactContext::Slot<EventStudyStepSettings> s_settings;
 };
 
 #endif // EVENTSTUDYSTEP_H
@@ -133,29 +133,42 @@ void Facilities::dump()
 	cout << endl;
 }
 
-double Facilities::s_startLongitude = numeric_limits<double>::quiet_NaN();
-double Facilities::s_startLattitude = numeric_limits<double>::quiet_NaN();
-string Facilities::s_corner;
-string Facilities::s_coordOutfile;
-Facilities *Facilities::s_pInstance = 0;
+//
+// FacilitiesSettings
+//
+
+FacilitiesSettings::FacilitiesSettings()
+{
+	m_startLongitude = numeric_limits<double>::quiet_NaN();
+	m_startLattitude = numeric_limits<double>::quiet_NaN();
+	m_pInstance = 0;
+}
+
+FacilitiesSettings::~FacilitiesSettings()
+{
+	delete m_pInstance;
+}
+
+SimpactContext::Slot<FacilitiesSettings> Facilities::s_settings;
 
 void Facilities::processConfig(ConfigSettings &config, GslRandomNumberGenerator *pRndGen)
 {
+	FacilitiesSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	vector<string> allowedValues { "top", "bottom" };
 	string coordsFile, randFile;
 	bool_t r;
 
-	if (!(r = config.getKeyValue("facilities.geo.start.longitude", s_startLongitude)) ||
-	    !(r = config.getKeyValue("facilities.geo.start.latitude", s_startLattitude)) ||
-		!(r = config.getKeyValue("facilities.geo.start.corner", s_corner, allowedValues)) ||
+	if (!(r = config.getKeyValue("facilities.geo.start.longitude", settings.m_startLongitude)) ||
+	    !(r = config.getKeyValue("facilities.geo.start.latitude", settings.m_startLattitude)) ||
+		!(r = config.getKeyValue("facilities.geo.start.corner", settings.m_corner, allowedValues)) ||
 		!(r = config.getKeyValue("facilities.geo.coords", coordsFile)) ||
 		!(r = config.getKeyValue("facilities.randomization", randFile)) ||
-		!(r = config.getKeyValue("facilities.outfile.facilityxypos", s_coordOutfile)) 
+		!(r = config.getKeyValue("facilities.outfile.facilityxypos", settings.m_coordOutfile)) 
 		)
 		abortWithMessage(r.getErrorString());
 
-	//cout << "startLong: " << s_startLongitude << endl;
-	//cout << "startLatt: " << s_startLattitude << endl;
+	//cout << "startLong: " << settings.m_startLongitude << endl;
+	//cout << "startLatt: " << settings.m_startLattitude << endl;
 
 	map<string, Point2D> facilityCoords;
 	map<string, int> randomization;
@@ -192,20 +205,20 @@ void Facilities::processConfig(ConfigSettings &config, GslRandomNumberGenerator
 				abortWithMessage("Can't interpret '" + parts[1] + "' or '" + parts[2] + "' as a valid longitude and latitude in file " + coordsFile);
 
 			// TODO: what are reasonable limits for the approximation to work?
-			if (std::abs(y - s_startLattitude) > 3.0 || std::abs(x - s_startLongitude) > 3.0 * std::cos(toRad(s_startLattitude)))
+			if (std::abs(y - settings.m_startLattitude) > 3.0 || std::abs(x - settings.m_startLongitude) > 3.0 * std::cos(toRad(settings.m_startLattitude)))
 				abortWithMessage("Coordinates '" + parts[1] + "' or '" + parts[2] + "' lie too far from start coordinates for flat approximation to work in file " + coordsFile);
 
 			double X = 0, Y = 0;
 
-			if (s_corner == "top")
+			if (settings.m_corner == "top")
 			{
-				X = toRad( x - s_startLongitude ) * cos(toRad(s_startLattitude)) * meanEarthRadius;
-				Y = toRad( s_startLattitude - y ) * meanEarthRadius;
+				X = toRad( x - settings.m_startLongitude ) * cos(toRad(settings.m_startLattitude)) * meanEarthRadius;
+				Y = toRad( settings.m_startLattitude - y ) * meanEarthRadius;
 			}
 			else
 			{
-				X = toRad( x - s_startLongitude ) * cos(toRad(s_startLattitude)) * meanEarthRadius;
-				Y = toRad( y - s_startLattitude ) * meanEarthRadius;
+				X = toRad( x - settings.m_startLongitude ) * cos(toRad(settings.m_startLattitude)) * meanEarthRadius;
+				Y = toRad( y - settings.m_startLattitude ) * meanEarthRadius;
 			}
 
 			facilityCoords[facilityName] = Point2D(X, Y);
@@ -316,22 +329,22 @@ void Facilities::processConfig(ConfigSettings &config, GslRandomNumberGenerator
 		facilities.push_back(Facility(name, coord, step-1)); // we'll start counting from 0 from here on
 	}
 
-	delete s_pInstance;
-	s_pInstance = new Facilities(facilities);
+	delete settings.m_pInstance;
+	settings.m_pInstance = new Facilities(facilities);
 	
 	// If desired, write these coordinates to a log file
-	if (s_coordOutfile.length() > 0)
+	if (settings.m_coordOutfile.length() > 0)
 	{
 		LogFile coordLog;
 
-		if (!(r = coordLog.open(s_coordOutfile)))
-			abortWithMessage("Can't write facility XY positions to '" + s_coordOutfile + "':" + r.getErrorString());
+		if (!(r = coordLog.open(settings.m_coordOutfile)))
+			abortWithMessage("Can't write facility XY positions to '" + settings.m_coordOutfile + "':" + r.getErrorString());
 
-		int numFac = s_pInstance->getNumberOfFacilities();
+		int numFac = settings.m_pInstance->getNumberOfFacilities();
 		coordLog.print("\"Facility name\",\"XCoord\",\"YCoord\"");
 		for (int i = 0 ; i < numFac ; i++)
 		{
-			const Facility *pFac = s_pInstance->getFacility(i);
+			const Facility *pFac = settings.m_pInstance->getFacility(i);
 			assert(pFac);
 
 			string facName = pFac->getName();
@@ -343,14 +356,15 @@ void Facilities::processConfig(ConfigSettings &config, GslRandomNumberGenerator
 
 void Facilities::obtainConfig(ConfigWriter &config)
 {
+	const FacilitiesSettings &settings = SimpactContext::getConfigContext().get(s_settings);
 	bool_t r;
 
-	if (!(r = config.addKey("facilities.geo.start.longitude", s_startLongitude)) ||
-	    !(r = config.addKey("facilities.geo.start.latitude", s_startLattitude)) ||
-		!(r = config.addKey("facilities.geo.start.corner", s_corner)) ||
+	if (!(r = config.addKey("facilities.geo.start.longitude", settings.m_startLongitude)) ||
+	    !(r = config.addKey("facilities.geo.start.latitude", settings.m_startLattitude)) ||
+		!(r = config.addKey("facilities.geo.start.corner", settings.m_corner)) ||
 		!(r = config.addKey("facilities.geo.coords", "IGNORE")) ||
 		!(r = config.addKey("facilities.randomization", "IGNORE")) ||
-		!(r = config.addKey("facilities.outfile.facilityxypos", s_coordOutfile))
+		!(r = config.addKey("facilities.outfile.facilityxypos", settings.m_coordOutfile))
 		)
 		abortWithMessage(r.getErrorString());
 }
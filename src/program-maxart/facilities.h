@@ -3,6 +3,7 @@
 #define FACILITIES_H
 
 #include "point2d.h"
+#include "simpactcontext.h"
 #include <assert.h>
 #include <vector>
 #include <string>
@@ -34,10 +35,26 @@ private:
 	StageType m_stage;
 };
 
+class Facilities;
+
+// The stages of the facilities change during the study, so every simulation
+// needs its own Facilities instance
+class FacilitiesSettings
+{
+public:
+	FacilitiesSettings();
+	~FacilitiesSettings();
+
+	double m_startLongitude, m_startLattitude;
+	std::string m_corner, m_coordOutfile;
+
+	Facilities *m_pInstance;
+};
+
 class Facilities
 {
 public:
-	static Facilities *getInstance()													{ return s_pInstance; }
+	static Facilities *getInstance(const SimpactContext &context)						{ return context.get(s_settings).m_pInstance; }
 
 	int getNumberOfFacilities() const													{ return m_facilities.size(); }
 	const Facility *getFacility(int idx) const											{ assert(idx >= 0 && idx < (int)m_facilities.size()); return &(m_facilities[idx]); }
@@ -56,11 +73,9 @@ private:
 	std::vector<Facility> m_facilities;
 	int m_numSteps;
 
-// Static variables
-	static double s_startLongitude, s_startLattitude;
-	static std::string s_corner, s_coordOutfile;
+	static SimpactContext::Slot<FacilitiesSettings> s_settings;
 
-	static Facilities *s_pInstance;
+	friend class FacilitiesSettings;
 };
 
 #endif // FACILITIES_H
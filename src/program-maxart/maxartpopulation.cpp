@@ -17,7 +17,7 @@ bool_t MaxARTPopulation::scheduleInitialEvents()
 	if (!(r = SimpactPopulation::scheduleInitialEvents()))
 		return r;
 
-	if (EventStudyStart::isMaxARTStudyEnabled())
+	if (EventStudyStart::isMaxARTStudyEnabled(getContext()))
 	{
 		EventStudyStart *pEvt = new EventStudyStart(); // global event
 		onNewEvent(pEvt);
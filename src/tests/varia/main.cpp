@@ -4,7 +4,11 @@
 #include "piecewiselinearfunction.h"
 #include "tiffdensityfile.h"
 #include "discretedistribution2d.h"
+#include "discretedistribution2dcompact.h"
+#include "gridvalues.h"
 #include "binormaldistribution.h"
+#include "hazardfunctionexp.h"
+#include "hazardfunctionexpbatch.h"
 #include <iostream>
 #include <fstream>
 
@@ -149,8 +153,25 @@ int main4(int argc, char *argv[])
 	return 0;
 }
 
+int main8(void);
+int main9(void);
+int main10(void);
+
 int main(int argc, char *argv[])
 {
+	// The self-checking tests, see CMakeLists.txt
+	if (argc == 2)
+	{
+		string testName(argv[1]);
+
+		if (testName == "lookuptable")
+			return main8();
+		if (testName == "compactdistribution")
+			return main9();
+		if (testName == "expbatch")
+			return main10();
+	}
+
 	GslRandomNumberGenerator rndGen;
 	vector<string> files;
 
@@ -228,3 +249,170 @@ int main6(void)
 
 	return 0;
 }
+
+int main8(void)
+{
+	// The lookup table should only speed up finding the interval, the results must
+	// be exactly the same as when scanning the points
+	GslRandomNumberGenerator rnd;
+	vector<Point2D> points;
+	double xMax = 0;
+
+	for (int i = 0 ; i < 50 ; i++)
+	{
+		points.push_back(Point2D(xMax, rnd.pickRandomDouble()));
+		if (i != 20) // also include two points with the same x-coordinate
+			xMax += rnd.pickRandomDouble()*rnd.pickRandomDouble();
+	}
+
+	PieceWiseLinearFunction fScan(points, -2, 10, 0);
+	PieceWiseLinearFunction fTable(points, -2, 10);
+	int numDiff = 0;
+
+	for (int i = 0 ; i < 1000000 ; i++)
+	{
+		double x = (i < (int)points.size()) ? points[i].x : (-0.1 + rnd.pickRandomDouble()*(xMax+0.2));
+
+		if (fScan.evaluate(x) != fTable.evaluate(x))
+			numDiff++;
+	}
+
+	cout << "Number of differences: " << numDiff << endl;
+	return (numDiff == 0)?0:-1;
+}
+
+class SparseTestGrid : public GridValues
+{
+public:
+	SparseTestGrid(int w, int h, GslRandomNumberGenerator &rnd) : m_width(w), m_height(h), m_values(w*h, 0)
+	{
+		// Some rows and the borders of all rows are empty
+		for (int y = 0 ; y < h ; y++)
+			for (int x = w/4 ; x < (3*w)/4 ; x++)
+				if (y%3 != 0 && rnd.pickRandomDouble() < 0.7)
+					m_values[x+y*w] = rnd.pickRandomDouble()*(1+x);
+	}
+
+	bool_t init(const std::string &fileName, bool noNegativeValues, bool flipY)	{ return true; }
+	int getWidth() const									{ return m_width; }
+	int getHeight() const									{ return m_height; }
+	double getValue(int x, int y) const							{ return m_values[x+y*m_width]; }
+	void setValue(int x, int y, double v)							{ m_values[x+y*m_width] = v; }
+	bool isYFlipped() const									{ return false; }
+private:
+	int m_width, m_height;
+	vector<double> m_values;
+};
+
+int main9(void)
+{
+	// The compact version should give the same distribution as the regular one. With
+	// 2000000 samples the statistical error of a pixel probability is below 1e-4, so a
+	// difference above 1e-3 indicates a real problem.
+	GslRandomNumberGenerator rnd;
+	int numFailed = 0;
+	const int w = 40, h = 30;
+	SparseTestGrid grid(w, h, rnd);
+	DiscreteDistribution2D dist(0, 0, w, h, grid, false, &rnd);
+	DiscreteDistribution2DCompact compact(0, 0, w, h, grid, false, &rnd);
+
+	for (int type = 0 ; type < 3 ; type++)
+	{
+		vector<double> hist1(w*h, 0), hist2(w*h, 0);
+		const int num = 2000000;
+
+		for (int i = 0 ; i < num ; i++)
+		{
+			Point2D p1, p2;
+
+			if (type == 0)
+			{
+				p1 = dist.pickPoint();
+				p2 = compact.pickPoint();
+			}
+			else if (type == 1)
+			{
+				p1.y = dist.pickMarginalY(); p1.x = dist.pickConditionalOnY(p1.y);
+				p2.y = compact.pickMarginalY(); p2.x = compact.pickConditionalOnY(p2.y);
+			}
+			else
+			{
+				p1.x = dist.pickMarginalX(); p1.y = dist.pickConditionalOnX(p1.x);
+				p2.x = compact.pickMarginalX(); p2.y = compact.pickConditionalOnX(p2.x);
+			}
+
+			hist1[(int)p1.x + (int)p1.y*w] += 1.0/num;
+			hist2[(int)p2.x + (int)p2.y*w] += 1.0/num;
+		}
+
+		double maxDiff = 0;
+		int numBad = 0;
+		for (int i = 0 ; i < w*h ; i++)
+		{
+			maxDiff = std::max(maxDiff, std::abs(hist1[i]-hist2[i]));
+			if (grid.getValue(i%w, i/w) == 0 && hist2[i] != 0)
+				numBad++;
+		}
+
+		cout << "Type " << type << ": largest difference in pixel probability " << maxDiff 
+		     << ", samples in empty pixels " << numBad << endl;
+
+		if (maxDiff > 1e-3 || numBad != 0)
+			numFailed++;
+	}
+	cout << "Memory used by compact tables: " << compact.getMemoryUsage() << " bytes" << endl;
+	return (numFailed == 0)?0:-1;
+}
+
+int main10(void)
+{
+	// The batch calculations of time limited exponential hazards must agree with the
+	// scalar ones to the relative tolerance documented in HazardFunctionExpBatch
+	GslRandomNumberGenerator rnd;
+	const int num = 100000;
+	const double tolerance = 1e-10;
+	HazardFunctionExpBatch batch(num);
+	vector<double> A(num), B(num), tMax(num), t0(num), x(num);
+	int numFailed = 0;
+
+	for (int i = 0 ; i < num ; i++)
+	{
+		double logh0 = -8.0 + 10.0*rnd.pickRandomDouble();
+
+		B[i] = (i%10 == 0)?0:(-1.0 + 2.0*rnd.pickRandomDouble());
+		t0[i] = 100.0*rnd.pickRandomDouble();
+		A[i] = logh0 - B[i]*t0[i];
+		tMax[i] = t0[i] - 20.0 + 70.0*rnd.pickRandomDouble(); // can be before t0
+	}
+
+	for (int type = 0 ; type < 2 ; type++)
+	{
+		double maxDiff = 0;
+
+		for (int i = 0 ; i < num ; i++)
+		{
+			x[i] = (type == 0)?(50.0*rnd.pickRandomDouble()):(-std::log(rnd.pickRandomDouble()));
+			batch.setEntry(i, A[i], B[i], tMax[i], t0[i], x[i]);
+		}
+
+		if (type == 0)
+			batch.calculateInternalTimeIntervals();
+		else
+			batch.solveForRealTimeIntervals();
+
+		for (int i = 0 ; i < num ; i++)
+		{
+			HazardFunctionExp h0(A[i], B[i]);
+			TimeLimitedHazardFunction h(h0, tMax[i]);
+			double y = (type == 0)?h.calculateInternalTimeInterval(t0[i], x[i]):h.solveForRealTimeInterval(t0[i], x[i]);
+			double diff = std::abs(batch.getResult(i) - y)/std::max(std::abs(y), 1e-300);
+
+			maxDiff = std::max(maxDiff, diff);
+		}
+
+		cout << ((type == 0)?"Internal":"Real world") << " time intervals: largest relative difference " << maxDiff << endl;
+		if (!(maxDiff <= tolerance))
+			numFailed++;
+	}
+	return (numFailed == 0)?0:-1;
+}